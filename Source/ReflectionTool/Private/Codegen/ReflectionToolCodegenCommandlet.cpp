@@ -0,0 +1,292 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#include "Codegen/ReflectionToolCodegenCommandlet.h"
+
+#include "ReflectionToolLib.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace ReflectionToolCodegen
+{
+	enum class EFieldKind : uint8
+	{
+		Float,
+		Integer,
+		Bool,
+		String,
+		Name,
+		Text,
+		// 通过 FProperty 走通用转换
+		Generic,
+	};
+
+	EFieldKind ClassifyField(const FProperty* Property)
+	{
+		// 静态数组与非 public 成员无法直接按名称访问
+		if (Property->ArrayDim != 1 || !Property->HasAnyPropertyFlags(CPF_NativeAccessSpecifierPublic))
+			return EFieldKind::Generic;
+		if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+		{
+			if (NumericProperty->GetIntPropertyEnum())
+				return EFieldKind::Generic;
+			if (NumericProperty->IsFloatingPoint())
+				return EFieldKind::Float;
+			if (NumericProperty->IsInteger())
+				return EFieldKind::Integer;
+			return EFieldKind::Generic;
+		}
+		if (CastField<FBoolProperty>(Property))
+			return EFieldKind::Bool;
+		if (CastField<FStrProperty>(Property))
+			return EFieldKind::String;
+		if (CastField<FNameProperty>(Property))
+			return EFieldKind::Name;
+		if (CastField<FTextProperty>(Property))
+			return EFieldKind::Text;
+		return EFieldKind::Generic;
+	}
+
+	// 与 PropertyToPropertyStruct 中的 TypeName 规则一致
+	FString GetTypeNameLiteral(const FProperty* Property)
+	{
+		FString TypeName = Property->GetCPPType();
+		TypeName.Split(TEXT("<"), &TypeName, nullptr);
+		return TypeName;
+	}
+
+	FString GetIncludePath(const UScriptStruct* Struct)
+	{
+#if WITH_METADATA
+		FString IncludePath = Struct->GetMetaData(TEXT("ModuleRelativePath"));
+		for (const TCHAR* Prefix : { TEXT("Public/"), TEXT("Classes/"), TEXT("Private/") })
+		{
+			if (IncludePath.RemoveFromStart(Prefix))
+				break;
+		}
+		return IncludePath;
+#else
+		return FString();
+#endif
+	}
+
+	UScriptStruct* FindStruct(const FString& StructName)
+	{
+		// UScriptStruct 的名称不带 F 前缀
+		FString Name = StructName;
+		if (Name.Len() > 1 && Name[0] == TEXT('F'))
+		{
+			if (UScriptStruct* Struct = FindFirstObject<UScriptStruct>(*Name.RightChop(1), EFindFirstObjectOptions::NativeFirst))
+				return Struct;
+		}
+		return FindFirstObject<UScriptStruct>(*Name, EFindFirstObjectOptions::NativeFirst);
+	}
+
+	void EmitPropertyLookup(FString& Out, const FString& CppName, const FProperty* Property, const TCHAR* Indent)
+	{
+		Out += FString::Printf(TEXT("%sstatic FProperty* const Property = FindFProperty<FProperty>(%s::StaticStruct(), TEXT(\"%s\"));\n"),
+			Indent, *CppName, *Property->GetName());
+	}
+
+	void EmitToPropertyStruct(FString& Out, const UScriptStruct* Struct, const FString& CppName)
+	{
+		Out += TEXT("\tstatic void ToPropertyStruct(const void* InStructPtr, FPropertyParserStruct& OutPropertyParserStruct)\n\t{\n");
+		Out += FString::Printf(TEXT("\t\tconst %s& InStruct = *static_cast<const %s*>(InStructPtr);\n"), *CppName, *CppName);
+		Out += TEXT("\t\tstatic const FName StructTypeName(TEXT(\"Struct\"));\n");
+		Out += TEXT("\t\tOutPropertyParserStruct.SetTypeName(StructTypeName);\n");
+		Out += TEXT("\t\tOutPropertyParserStruct.bHaveChild = true;\n");
+		// AddDefaulted 可能重新分配，先取得下标再取 GetData
+		Out += TEXT("\t\tconst int32 First = OutPropertyParserStruct.Children.AddDefaulted(NumChildren);\n");
+		Out += TEXT("\t\tFPropertyParserStruct* Children = OutPropertyParserStruct.Children.GetData() + First;\n");
+
+		int32 Index = 0;
+		for (const FProperty* Property = Struct->PropertyLink; Property; Property = Property->PropertyLinkNext, ++Index)
+		{
+			const FString Member = Property->GetName();
+			const EFieldKind Kind = ClassifyField(Property);
+			if (Kind == EFieldKind::Generic)
+			{
+				Out += TEXT("\t\t{\n");
+				EmitPropertyLookup(Out, CppName, Property, TEXT("\t\t\t"));
+				Out += FString::Printf(TEXT("\t\t\tUReflectionToolLib::PropertyToPropertyStruct(Property, Property->ContainerPtrToValuePtr<void>(&InStruct), Children[%d]);\n"), Index);
+				Out += TEXT("\t\t}\n");
+				continue;
+			}
+
+			// 名称与类型名在首次调用时注册为 FName
+			Out += FString::Printf(TEXT("\t\tstatic const FName FieldName%d(TEXT(\"%s\"));\n"), Index, *Property->GetAuthoredName());
+			Out += FString::Printf(TEXT("\t\tstatic const FName FieldType%d(TEXT(\"%s\"));\n"), Index, *GetTypeNameLiteral(Property));
+			Out += FString::Printf(TEXT("\t\tChildren[%d].SetName(FieldName%d);\n"), Index, Index);
+			Out += FString::Printf(TEXT("\t\tChildren[%d].SetTypeName(FieldType%d);\n"), Index, Index);
+			FString ValueExpr;
+			switch (Kind)
+			{
+			case EFieldKind::Float:
+				ValueExpr = FString::Printf(TEXT("FString::Printf(TEXT(\"%%.15f\"), static_cast<double>(InStruct.%s))"), *Member);
+				break;
+			case EFieldKind::Integer:
+				ValueExpr = FString::Printf(TEXT("FString::Printf(TEXT(\"%%lld\"), static_cast<int64>(InStruct.%s))"), *Member);
+				break;
+			case EFieldKind::Bool:
+				ValueExpr = FString::Printf(TEXT("InStruct.%s ? TEXT(\"true\") : TEXT(\"false\")"), *Member);
+				break;
+			case EFieldKind::String:
+				ValueExpr = FString::Printf(TEXT("InStruct.%s"), *Member);
+				break;
+			case EFieldKind::Name:
+			case EFieldKind::Text:
+				ValueExpr = FString::Printf(TEXT("InStruct.%s.ToString()"), *Member);
+				break;
+			default:
+				break;
+			}
+			Out += FString::Printf(TEXT("\t\tChildren[%d].Value = %s;\n"), Index, *ValueExpr);
+		}
+		Out += TEXT("\t}\n");
+	}
+
+	void EmitSetFromMap(FString& Out, const UScriptStruct* Struct, const FString& CppName)
+	{
+		Out += TEXT("\tstatic void SetFromMap(void* OutStructPtr, const TMap<FString, FString>& InMap)\n\t{\n");
+		Out += FString::Printf(TEXT("\t\t%s& OutStruct = *static_cast<%s*>(OutStructPtr);\n"), *CppName, *CppName);
+		for (const FProperty* Property = Struct->PropertyLink; Property; Property = Property->PropertyLinkNext)
+		{
+			const FString Member = Property->GetName();
+			if (CastField<FStructProperty>(Property))
+			{
+				// 与 SetStructValueByMap 一致，嵌套结构体使用同一个 Map 按成员名填充
+				Out += TEXT("\t\t{\n");
+				EmitPropertyLookup(Out, CppName, Property, TEXT("\t\t\t"));
+				Out += TEXT("\t\t\tUReflectionToolLib::SetStructValueByMap(CastFieldChecked<FStructProperty>(Property), Property->ContainerPtrToValuePtr<void>(&OutStruct), InMap);\n");
+				Out += TEXT("\t\t}\n");
+				continue;
+			}
+
+			Out += FString::Printf(TEXT("\t\tif (const FString* Found = InMap.Find(TEXT(\"%s\")))\n\t\t{\n"), *Property->GetAuthoredName());
+			switch (ClassifyField(Property))
+			{
+			case EFieldKind::Float:
+				Out += FString::Printf(TEXT("\t\t\tOutStruct.%s = static_cast<%s>(FCString::Atod(**Found));\n"), *Member, *Property->GetCPPType());
+				break;
+			case EFieldKind::Integer:
+				Out += FString::Printf(TEXT("\t\t\tOutStruct.%s = static_cast<%s>(FCString::Atoi64(**Found));\n"), *Member, *Property->GetCPPType());
+				break;
+			case EFieldKind::Bool:
+				Out += FString::Printf(TEXT("\t\t\tOutStruct.%s = Found->Equals(TEXT(\"true\"), ESearchCase::IgnoreCase);\n"), *Member);
+				break;
+			case EFieldKind::String:
+				Out += FString::Printf(TEXT("\t\t\tOutStruct.%s = *Found;\n"), *Member);
+				break;
+			case EFieldKind::Name:
+				Out += FString::Printf(TEXT("\t\t\tOutStruct.%s = FName(**Found);\n"), *Member);
+				break;
+			case EFieldKind::Text:
+				Out += FString::Printf(TEXT("\t\t\tOutStruct.%s = FText::FromString(*Found);\n"), *Member);
+				break;
+			default:
+				EmitPropertyLookup(Out, CppName, Property, TEXT("\t\t\t"));
+				Out += TEXT("\t\t\tFPropertyParserStruct PropertyParserStruct;\n");
+				Out += TEXT("\t\t\tPropertyParserStruct.Value = *Found;\n");
+				Out += TEXT("\t\t\tUReflectionToolLib::ParserSinglePPSToProperty(Property, Property->ContainerPtrToValuePtr<void>(&OutStruct), PropertyParserStruct);\n");
+				break;
+			}
+			Out += TEXT("\t\t}\n");
+		}
+		Out += TEXT("\t}\n");
+	}
+
+	void EmitConverter(FString& Out, const UScriptStruct* Struct)
+	{
+		const FString CppName = Struct->GetStructCPPName();
+		int32 NumChildren = 0;
+		for (const FProperty* Property = Struct->PropertyLink; Property; Property = Property->PropertyLinkNext)
+		{
+			++NumChildren;
+		}
+
+		const FString ConverterName = FString::Printf(TEXT("F%sConverter"), *Struct->GetName());
+		Out += FString::Printf(TEXT("struct %s\n{\n"), *ConverterName);
+		Out += FString::Printf(TEXT("\tstatic constexpr int32 NumChildren = %d;\n\n"), NumChildren);
+		EmitToPropertyStruct(Out, Struct, CppName);
+		Out += TEXT("\n");
+		EmitSetFromMap(Out, Struct, CppName);
+		Out += TEXT("};\n\n");
+		Out += FString::Printf(TEXT("static const FReflectionToolGeneratedConverters::FRegistration %sRegistration(&%s::StaticStruct,\n\t{ &%s::ToPropertyStruct, &%s::SetFromMap });\n\n"),
+			*ConverterName, *CppName, *ConverterName, *ConverterName);
+	}
+}
+
+UReflectionToolCodegenCommandlet::UReflectionToolCodegenCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UReflectionToolCodegenCommandlet::Main(const FString& Params)
+{
+	using namespace ReflectionToolCodegen;
+
+	FString StructList;
+	if (!FParse::Value(*Params, TEXT("Structs="), StructList, false))
+	{
+		UE_LOG(ReflectionTool, Error, TEXT("Usage: -run=ReflectionToolCodegen -Structs=FMyStruct,FOtherStruct [-Output=<Source.cpp>]"));
+		return 1;
+	}
+	FString OutputPath = FPaths::ProjectSavedDir() / TEXT("ReflectionTool") / TEXT("Codegen") / TEXT("ReflectionToolGeneratedConverters.cpp");
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+	TArray<FString> StructNames;
+	StructList.ParseIntoArray(StructNames, TEXT(","));
+
+	TArray<UScriptStruct*> Structs;
+	for (FString& StructName : StructNames)
+	{
+		StructName.TrimStartAndEndInline();
+		UScriptStruct* Struct = FindStruct(StructName);
+		if (!Struct)
+		{
+			UE_LOG(ReflectionTool, Error, TEXT("Codegen: struct %s not found"), *StructName);
+			return 1;
+		}
+		// 蓝图结构体没有 C++ 类型，无法特化
+		if (!Struct->IsNative())
+		{
+			UE_LOG(ReflectionTool, Warning, TEXT("Codegen: %s is not a native struct, skipped"), *StructName);
+			continue;
+		}
+		Structs.AddUnique(Struct);
+	}
+
+	FString Out;
+	Out += TEXT("// Generated by ReflectionToolCodegen commandlet. Do not edit.\n\n");
+	Out += TEXT("#include \"ReflectionToolLib.h\"\n");
+	TArray<FString> Includes;
+	for (const UScriptStruct* Struct : Structs)
+	{
+		const FString IncludePath = GetIncludePath(Struct);
+		if (IncludePath.IsEmpty())
+		{
+			UE_LOG(ReflectionTool, Warning, TEXT("Codegen: no header path for %s, add the include manually"), *Struct->GetStructCPPName());
+		}
+		else if (!Includes.Contains(IncludePath))
+		{
+			Includes.Add(IncludePath);
+			Out += FString::Printf(TEXT("#include \"%s\"\n"), *IncludePath);
+		}
+	}
+	Out += TEXT("\nnamespace ReflectionToolGeneratedConverters\n{\n\n");
+	for (const UScriptStruct* Struct : Structs)
+	{
+		EmitConverter(Out, Struct);
+	}
+	Out += TEXT("}\n");
+
+	if (!FFileHelper::SaveStringToFile(Out, *OutputPath))
+	{
+		UE_LOG(ReflectionTool, Error, TEXT("Codegen: failed to write %s"), *OutputPath);
+		return 1;
+	}
+	UE_LOG(ReflectionTool, Display, TEXT("Codegen: wrote %d converter(s) to %s"), Structs.Num(), *OutputPath);
+	return 0;
+}
@@ -0,0 +1,23 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ReflectionToolCodegenCommandlet.generated.h"
+
+/**
+ * 为热点结构体生成转换器并注册到 FReflectionToolGeneratedConverters：
+ * UnrealEditor-Cmd <Project> -run=ReflectionToolCodegen -Structs=FMyStruct,FOtherStruct -Output=<Path/Source.cpp> -unattended
+ * 简单成员（数值、bool、字符串、FName、FText）直接按成员名读写，子节点数量固定；其余成员仍通过缓存的 FProperty 走通用路径
+ * 生成的 .cpp 放入使用方模块一起编译即可，无需在调用处包含
+ */
+UCLASS()
+class UReflectionToolCodegenCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+public:
+	UReflectionToolCodegenCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,349 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#include "Dump/ReflectionToolWorldDumpCommandlet.h"
+
+#include "ReflectionPPSDump.h"
+#include "ReflectionStructSnapshot.h"
+#include "ReflectionToolLib.h"
+#include "Async/Async.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/FileManager.h"
+#include "Misc/Compression.h"
+#include "UObject/Package.h"
+#include "WorldPartition/WorldPartition.h"
+#if WITH_EDITOR
+#include "WorldPartition/WorldPartitionActorDesc.h"
+#include "WorldPartition/WorldPartitionHelpers.h"
+#endif
+
+namespace ReflectionToolWorldDump
+{
+	// 'RTWD'
+	constexpr uint32 Magic = 0x44575452;
+	constexpr uint32 FormatVersion = 1;
+
+	enum class EFormat : uint8
+	{
+		Json,
+		Binary,
+		// FReflectionPPSDump 的节点表格式，可直接用 OpenPPSDumpWindow 浏览
+		Dump,
+	};
+
+	// 工作线程的输出，写入线程按提交顺序取出
+	struct FRecord
+	{
+		FString ObjectPath;
+		FString ClassPath;
+		int32 RawSize = 0;
+		// 与 RawSize 相同表示未压缩
+		TArray<uint8> Bytes;
+		// Dump 格式的对象属性，根节点为对象路径与类路径
+		FPropertyParserStruct PPS;
+	};
+
+	FRecord Convert(const TSharedRef<FReflectionStructSnapshot>& Snapshot, EFormat Format, FName Compression,
+		FString ObjectPath, FString ClassPath)
+	{
+		FRecord Record;
+		if (Format == EFormat::Dump)
+		{
+			Snapshot->ToPPS(Record.PPS);
+			Record.PPS.Name = MoveTemp(ObjectPath);
+			Record.PPS.TypeName = MoveTemp(ClassPath);
+			return Record;
+		}
+		Record.ObjectPath = MoveTemp(ObjectPath);
+		Record.ClassPath = MoveTemp(ClassPath);
+
+		TArray<uint8> RawBytes;
+		if (Format == EFormat::Json)
+		{
+			FString Json;
+			Snapshot->ToJson(Json);
+			const FTCHARToUTF8 Converter(*Json, Json.Len());
+			RawBytes.Append(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length());
+		}
+		else
+		{
+			Snapshot->ToBinary(RawBytes);
+		}
+		Record.RawSize = RawBytes.Num();
+
+		if (!Compression.IsNone() && RawBytes.Num() > 0)
+		{
+			int32 CompressedSize = FCompression::CompressMemoryBound(Compression, RawBytes.Num());
+			Record.Bytes.SetNumUninitialized(CompressedSize);
+			if (FCompression::CompressMemory(Compression, Record.Bytes.GetData(), CompressedSize, RawBytes.GetData(), RawBytes.Num())
+				&& CompressedSize < RawBytes.Num())
+			{
+				Record.Bytes.SetNum(CompressedSize);
+				return Record;
+			}
+		}
+		Record.Bytes = MoveTemp(RawBytes);
+		return Record;
+	}
+
+	class FPipeline
+	{
+	public:
+		// Dump 格式写入 DumpWriter，其余写入 Writer
+		FPipeline(FArchive* InWriter, FReflectionPPSDumpWriter* InDumpWriter, EFormat InFormat, FName InCompression, int32 InMaxInFlight)
+			: Writer(InWriter)
+			, DumpWriter(InDumpWriter)
+			, Format(InFormat)
+			, Compression(InCompression)
+			, MaxInFlight(FMath::Max(InMaxInFlight, 1))
+		{
+		}
+
+		// 游戏线程：拷贝对象属性并提交转换，处理中的数量达到上限时先写出最早的一条
+		void Submit(const UObject* Object)
+		{
+			while (InFlight.Num() >= MaxInFlight)
+			{
+				WriteOldest();
+			}
+			TSharedRef<FReflectionStructSnapshot> Snapshot = FReflectionStructSnapshot::CaptureObject(Object);
+			InFlight.Add(Async(EAsyncExecution::ThreadPool,
+				[Snapshot, Format = Format, Compression = Compression, ObjectPath = Object->GetPathName(), ClassPath = Object->GetClass()->GetPathName()]() mutable
+				{
+					return Convert(Snapshot, Format, Compression, MoveTemp(ObjectPath), MoveTemp(ClassPath));
+				}));
+		}
+
+		void Flush()
+		{
+			while (InFlight.Num() > 0)
+			{
+				WriteOldest();
+			}
+		}
+
+		int32 GetNumWritten() const { return NumWritten; }
+		int64 GetRawSize() const { return RawSize; }
+
+	private:
+		void WriteOldest()
+		{
+			FRecord Record = InFlight[0].Get();
+			InFlight.RemoveAt(0, 1, false);
+			++NumWritten;
+
+			if (DumpWriter)
+			{
+				DumpWriter->Add(Record.PPS);
+				return;
+			}
+			int32 StoredSize = Record.Bytes.Num();
+			*Writer << Record.ObjectPath << Record.ClassPath << Record.RawSize << StoredSize;
+			Writer->Serialize(Record.Bytes.GetData(), StoredSize);
+			RawSize += Record.RawSize;
+		}
+
+		FArchive* Writer;
+		FReflectionPPSDumpWriter* DumpWriter;
+		EFormat Format;
+		FName Compression;
+		int32 MaxInFlight;
+		// 按提交顺序排列，始终从头部取出，保证输出顺序与 Actor 顺序一致
+		TArray<TFuture<FRecord>> InFlight;
+		int32 NumWritten = 0;
+		int64 RawSize = 0;
+	};
+}
+
+UReflectionToolWorldDumpCommandlet::UReflectionToolWorldDumpCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UReflectionToolWorldDumpCommandlet::Main(const FString& Params)
+{
+	using namespace ReflectionToolWorldDump;
+
+	FString MapPath;
+	FString OutputPath;
+	if (!FParse::Value(*Params, TEXT("Map="), MapPath) || !FParse::Value(*Params, TEXT("Output="), OutputPath))
+	{
+		UE_LOG(ReflectionTool, Error, TEXT("Usage: -run=ReflectionToolWorldDump -Map=/Game/Maps/MyMap -Output=<File> [-Format=Json|Binary|Dump] [-Compression=Oodle|Zlib|None] [-MaxInFlight=64] [-Components]"));
+		return 1;
+	}
+	FString FormatName = TEXT("Json");
+	FParse::Value(*Params, TEXT("Format="), FormatName);
+	const EFormat Format = FormatName.Equals(TEXT("Binary"), ESearchCase::IgnoreCase) ? EFormat::Binary
+		: FormatName.Equals(TEXT("Dump"), ESearchCase::IgnoreCase) ? EFormat::Dump : EFormat::Json;
+	FString CompressionName = TEXT("Oodle");
+	FParse::Value(*Params, TEXT("Compression="), CompressionName);
+	// Dump 格式需内存映射浏览，不压缩
+	const FName Compression = Format == EFormat::Dump || CompressionName.Equals(TEXT("None"), ESearchCase::IgnoreCase) ? NAME_None : FName(*CompressionName);
+	int32 MaxInFlight = 64;
+	FParse::Value(*Params, TEXT("MaxInFlight="), MaxInFlight);
+	const bool bComponents = FParse::Param(*Params, TEXT("Components"));
+
+	if (!Compression.IsNone() && !FCompression::IsFormatValid(Compression))
+	{
+		UE_LOG(ReflectionTool, Error, TEXT("WorldDump: unknown compression format %s"), *CompressionName);
+		return 1;
+	}
+
+	UPackage* Package = LoadPackage(nullptr, *MapPath, LOAD_None);
+	UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+	if (!World)
+	{
+		UE_LOG(ReflectionTool, Error, TEXT("WorldDump: failed to load map %s"), *MapPath);
+		return 1;
+	}
+	World->AddToRoot();
+	const bool bInitializedHere = !World->bIsWorldInitialized;
+	if (bInitializedHere)
+	{
+		World->InitWorld(UWorld::InitializationValues()
+			.AllowAudioPlayback(false)
+			.RequiresHitProxies(false)
+			.CreatePhysicsScene(false)
+			.CreateNavigation(false)
+			.CreateAISystem(false)
+			.ShouldSimulatePhysics(false)
+			.EnableTraceCollision(false)
+			.SetTransactional(false)
+			.CreateFXSystem(false));
+	}
+
+	// Dump 格式：根节点为地图，每个对象为根的一个子节点，边导出边写入临时文件，Close 时合并
+	TUniquePtr<FArchive> Writer;
+	TUniquePtr<FReflectionPPSDumpWriter> DumpWriter;
+	if (Format == EFormat::Dump)
+	{
+		DumpWriter = MakeUnique<FReflectionPPSDumpWriter>(OutputPath, MapPath, TEXT("World"));
+	}
+	else
+	{
+		Writer.Reset(IFileManager::Get().CreateFileWriter(*OutputPath));
+	}
+	if (DumpWriter ? !DumpWriter->IsValid() : !Writer)
+	{
+		UE_LOG(ReflectionTool, Error, TEXT("WorldDump: failed to open %s"), *OutputPath);
+		World->RemoveFromRoot();
+		return 1;
+	}
+
+	if (Writer)
+	{
+		// 文件头：Magic, Version, 地图, 格式, 压缩格式；之后每条记录为 对象路径, 类路径, 原始大小, 存储大小, 数据
+		uint32 FileMagic = Magic;
+		uint32 FileVersion = FormatVersion;
+		FString FileFormat = Format == EFormat::Json ? TEXT("Json") : TEXT("Binary");
+		FString FileCompression = Compression.ToString();
+		*Writer << FileMagic << FileVersion << MapPath << FileFormat << FileCompression;
+	}
+
+	// World Partition 地图的大部分 Actor 在未加载的 Cell 中，只能在编辑器中逐批加载
+	UWorldPartition* WorldPartition = World->GetWorldPartition();
+#if WITH_EDITOR
+	if (WorldPartition && !WorldPartition->IsInitialized())
+#else
+	if (WorldPartition)
+#endif
+	{
+		UE_LOG(ReflectionTool, Error, TEXT("WorldDump: %s is a World Partition map, its actors can only be loaded in an initialized editor world"), *MapPath);
+		Writer.Reset();
+		DumpWriter.Reset();
+		IFileManager::Get().Delete(*OutputPath);
+		if (bInitializedHere)
+		{
+			World->DestroyWorld(false);
+		}
+		World->RemoveFromRoot();
+		return 1;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	FPipeline Pipeline(Writer.Get(), DumpWriter.Get(), Format, Compression, MaxInFlight);
+	TSet<FSoftObjectPath> SubmittedActors;
+	auto SubmitActor = [&Pipeline, &SubmittedActors, bComponents](const AActor* Actor)
+	{
+		SubmittedActors.Add(FSoftObjectPath(Actor));
+		Pipeline.Submit(Actor);
+		if (!bComponents)
+			return;
+		for (const UActorComponent* Component : Actor->GetComponents())
+		{
+			if (IsValid(Component))
+			{
+				Pipeline.Submit(Component);
+			}
+		}
+	};
+
+	// 已加载的关卡（含 World Partition 中始终加载的 Actor）
+	TArray<ULevel*> Levels;
+	Levels.Add(World->PersistentLevel);
+	for (ULevel* Level : World->GetLevels())
+	{
+		Levels.AddUnique(Level);
+	}
+	for (const ULevel* Level : Levels)
+	{
+		if (!Level)
+			continue;
+		for (const AActor* Actor : Level->Actors)
+		{
+			if (IsValid(Actor))
+			{
+				SubmitActor(Actor);
+			}
+		}
+	}
+
+#if WITH_EDITOR
+	if (WorldPartition)
+	{
+		// 逐批加载未加载的 Actor，内存不足时释放已导出的批次并 GC；GC 前先写出处理中的快照
+		FWorldPartitionHelpers::FForEachActorWithLoadingParams LoadingParams;
+		LoadingParams.FilterActorDesc = [&SubmittedActors](const FWorldPartitionActorDesc* ActorDesc)
+		{
+			return !SubmittedActors.Contains(ActorDesc->GetActorSoftPath());
+		};
+		LoadingParams.OnPreGarbageCollect = [&Pipeline]()
+		{
+			Pipeline.Flush();
+		};
+		FWorldPartitionHelpers::ForEachActorWithLoading(WorldPartition, [&SubmitActor](const FWorldPartitionActorDesc* ActorDesc)
+		{
+			const AActor* Actor = ActorDesc->GetActor();
+			if (IsValid(Actor))
+			{
+				SubmitActor(Actor);
+			}
+			else
+			{
+				UE_LOG(ReflectionTool, Warning, TEXT("WorldDump: failed to load actor %s"), *ActorDesc->GetActorSoftPath().ToString());
+			}
+			return true;
+		}, LoadingParams);
+	}
+#endif
+	Pipeline.Flush();
+
+	const bool bWriteOk = DumpWriter ? DumpWriter->Close() : Writer->Close() && !Writer->IsError();
+	const int64 StoredSize = IFileManager::Get().FileSize(*OutputPath);
+	Writer.Reset();
+	DumpWriter.Reset();
+
+	if (bInitializedHere)
+	{
+		World->DestroyWorld(false);
+	}
+	World->RemoveFromRoot();
+
+	UE_LOG(ReflectionTool, Display, TEXT("WorldDump: wrote %d object(s) from %s to %s in %.2fs (%lld bytes raw, %lld bytes stored)"),
+		Pipeline.GetNumWritten(), *MapPath, *OutputPath, FPlatformTime::Seconds() - StartTime, Pipeline.GetRawSize(), StoredSize);
+	return bWriteOk ? 0 : 1;
+}
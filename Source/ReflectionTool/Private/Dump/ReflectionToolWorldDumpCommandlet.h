@@ -0,0 +1,26 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ReflectionToolWorldDumpCommandlet.generated.h"
+
+/**
+ * 导出地图中所有 Actor（可选含组件）的反射属性，用于每日回归对比，可在 Linux 构建机上无界面运行：
+ * UnrealEditor-Cmd <Project> -run=ReflectionToolWorldDump -Map=/Game/Maps/MyMap -Output=<File> [-Format=Json|Binary|Dump]
+ *     [-Compression=Oodle|Zlib|None] [-MaxInFlight=64] [-Components] -nullrhi -unattended
+ * 流水线：游戏线程上逐个 Capture 快照 -> 线程池转换并压缩 -> 按 Actor 顺序依次写入文件
+ * 同时处理中的快照数不超过 MaxInFlight，内存占用与 Actor 数量无关
+ * -Format=Dump 通过 FReflectionPPSDumpWriter 流式写入 PPS 转储（不压缩），可用 OpenPPSDumpWindow 直接浏览
+ * World Partition 地图逐批加载所有 Cell 中的 Actor 后导出（仅编辑器），非编辑器构建中直接失败
+ */
+UCLASS()
+class UReflectionToolWorldDumpCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+public:
+	UReflectionToolWorldDumpCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
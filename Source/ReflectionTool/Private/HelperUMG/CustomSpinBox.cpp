@@ -4,7 +4,58 @@
 
 #include "HelperUMG/CustomSpinBox.h"
 
+#include "ReflectionPropertyPath.h"
+#include "ReflectionTool.h"
+
 void UCustomSpinBox::SetTextSize(int32 NewSize)
 {
 	Font.Size = NewSize;
 }
+
+bool UCustomSpinBox::BindPropertyPath(UObject* Target, const FString& PropertyPath)
+{
+	UnbindPropertyPath();
+	if (!Target)
+		return false;
+
+	TSharedPtr<const FReflectionPropertyPath> Path = FReflectionPropertyPath::Compile(Target->GetClass(), PropertyPath);
+	double CurrentValue = 0.0;
+	if (!Path.IsValid() || !Path->GetNumber(Target, CurrentValue))
+		return false;
+
+	BoundObject = Target;
+	BoundPath = Path;
+	SetValue(static_cast<float>(CurrentValue));
+	OnValueChanged.AddUniqueDynamic(this, &UCustomSpinBox::HandleBoundValueChanged);
+	ReflectionDataChangedHandle = FReflectionToolModule::OnReflectionDataChanged().AddUObject(this, &UCustomSpinBox::HandleReflectionDataChanged);
+	return true;
+}
+
+void UCustomSpinBox::UnbindPropertyPath()
+{
+	OnValueChanged.RemoveDynamic(this, &UCustomSpinBox::HandleBoundValueChanged);
+	FReflectionToolModule::OnReflectionDataChanged().Remove(ReflectionDataChangedHandle);
+	ReflectionDataChangedHandle.Reset();
+	BoundObject.Reset();
+	BoundPath.Reset();
+}
+
+void UCustomSpinBox::HandleReflectionDataChanged()
+{
+	UObject* Target = BoundObject.Get();
+	const FString PathString = BoundPath.IsValid() ? BoundPath->PathString : FString();
+	BoundPath = Target ? FReflectionPropertyPath::Compile(Target->GetClass(), PathString) : nullptr;
+	if (!BoundPath.IsValid())
+	{
+		UnbindPropertyPath();
+	}
+}
+
+void UCustomSpinBox::HandleBoundValueChanged(float InValue)
+{
+	UObject* Target = BoundObject.Get();
+	if (Target && BoundPath.IsValid() && BoundPath->IsValidFor(Target->GetClass()))
+	{
+		BoundPath->SetNumber(Target, InValue);
+	}
+}
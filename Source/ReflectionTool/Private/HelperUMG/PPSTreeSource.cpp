@@ -0,0 +1,76 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#include "HelperUMG/PPSTreeSource.h"
+
+#include "ReflectionPPSDump.h"
+
+FPPSMemoryTreeSource::FPPSMemoryTreeSource(FPropertyParserStruct&& InRoot)
+	: Root(MoveTemp(InRoot))
+{
+	// 广度优先展平，同一节点的子节点下标连续
+	Nodes.Add({ &Root, -1, 0, 0 });
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		const FPropertyParserStruct* Node = Nodes[Index].Node;
+		const int32 ChildDepth = Nodes[Index].Depth + 1;
+		Nodes[Index].FirstChild = Nodes.Num();
+		Nodes[Index].NumChildren = Node->Children.Num();
+		for (const FPropertyParserStruct& Child : Node->Children)
+		{
+			Nodes.Add({ &Child, ChildDepth, 0, 0 });
+		}
+	}
+}
+
+FString FPPSMemoryTreeSource::GetName(int32 NodeIndex) const
+{
+	const FPropertyParserStruct* Node = GetNode(NodeIndex);
+	return Node ? Node->Name : FString();
+}
+
+FString FPPSMemoryTreeSource::GetTypeName(int32 NodeIndex) const
+{
+	const FPropertyParserStruct* Node = GetNode(NodeIndex);
+	return Node ? Node->TypeName : FString();
+}
+
+FString FPPSMemoryTreeSource::GetValue(int32 NodeIndex) const
+{
+	const FPropertyParserStruct* Node = GetNode(NodeIndex);
+	return Node ? Node->Value : FString();
+}
+
+int32 FPPSDumpTreeSource::GetNumNodes() const
+{
+	return Dump->GetNumNodes();
+}
+
+int32 FPPSDumpTreeSource::GetFirstChild(int32 NodeIndex) const
+{
+	return Dump->GetFirstChild(NodeIndex);
+}
+
+int32 FPPSDumpTreeSource::GetNumChildren(int32 NodeIndex) const
+{
+	return Dump->GetNumChildren(NodeIndex);
+}
+
+int32 FPPSDumpTreeSource::GetDepth(int32 NodeIndex) const
+{
+	return Dump->GetDepth(NodeIndex);
+}
+
+FString FPPSDumpTreeSource::GetName(int32 NodeIndex) const
+{
+	return Dump->GetName(NodeIndex);
+}
+
+FString FPPSDumpTreeSource::GetTypeName(int32 NodeIndex) const
+{
+	return Dump->GetTypeName(NodeIndex);
+}
+
+FString FPPSDumpTreeSource::GetValue(int32 NodeIndex) const
+{
+	return Dump->GetValue(NodeIndex);
+}
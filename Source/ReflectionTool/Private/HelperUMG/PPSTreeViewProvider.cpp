@@ -0,0 +1,201 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#include "HelperUMG/PPSTreeViewProvider.h"
+
+#include "HelperUMG/PPSTreeSource.h"
+#include "ReflectionPPSDump.h"
+#include "Components/TreeView.h"
+
+const FPropertyParserStruct* UPPSTreeViewItem::GetNode() const
+{
+	const UPPSTreeViewProvider* Owner = Provider.Get();
+	return Owner ? Owner->GetNode(NodeIndex) : nullptr;
+}
+
+FString UPPSTreeViewItem::GetNodeName() const
+{
+	const UPPSTreeViewProvider* Owner = Provider.Get();
+	return Owner ? Owner->GetNodeName(NodeIndex) : FString();
+}
+
+FString UPPSTreeViewItem::GetNodeTypeName() const
+{
+	const UPPSTreeViewProvider* Owner = Provider.Get();
+	return Owner ? Owner->GetNodeTypeName(NodeIndex) : FString();
+}
+
+FString UPPSTreeViewItem::GetNodeValue() const
+{
+	const UPPSTreeViewProvider* Owner = Provider.Get();
+	return Owner ? Owner->GetNodeValue(NodeIndex) : FString();
+}
+
+bool UPPSTreeViewItem::HasChildren() const
+{
+	const UPPSTreeViewProvider* Owner = Provider.Get();
+	return Owner && Owner->GetNodeNumChildren(NodeIndex) > 0;
+}
+
+int32 UPPSTreeViewItem::GetDepth() const
+{
+	const UPPSTreeViewProvider* Owner = Provider.Get();
+	return Owner ? Owner->GetNodeDepth(NodeIndex) : 0;
+}
+
+void UPPSTreeViewProvider::SetSource(const FPropertyParserStruct& PPS)
+{
+	SetSource(FPropertyParserStruct(PPS));
+}
+
+void UPPSTreeViewProvider::SetSource(FPropertyParserStruct&& PPS)
+{
+	SetTreeSource(MakeShared<FPPSMemoryTreeSource>(MoveTemp(PPS)));
+}
+
+bool UPPSTreeViewProvider::OpenDumpFile(const FString& Filename)
+{
+	TSharedPtr<FReflectionPPSDump> Dump = FReflectionPPSDump::Open(Filename);
+	if (!Dump.IsValid())
+		return false;
+	SetTreeSource(MakeShared<FPPSDumpTreeSource>(Dump.ToSharedRef()));
+	return true;
+}
+
+void UPPSTreeViewProvider::SetTreeSource(TSharedPtr<const IPPSTreeSource> InSource)
+{
+	Source = MoveTemp(InSource);
+	OnSourceChanged();
+}
+
+void UPPSTreeViewProvider::BindTreeView(UTreeView* TreeView)
+{
+	BoundTreeView = TreeView;
+	if (!TreeView)
+		return;
+	TreeView->SetOnGetItemChildren(this, &UPPSTreeViewProvider::GetChildItems);
+	RefreshBoundTreeView();
+}
+
+void UPPSTreeViewProvider::GetRootItems(TArray<UObject*>& OutItems)
+{
+	OutItems.Reset();
+	if (GetNumNodes() > 0)
+	{
+		GetItemsInRange(FString(), Source->GetFirstChild(0), Source->GetNumChildren(0), OutItems);
+	}
+}
+
+void UPPSTreeViewProvider::GetChildItems(UObject* Item, TArray<UObject*>& OutChildren)
+{
+	OutChildren.Reset();
+	const UPPSTreeViewItem* TreeItem = Cast<UPPSTreeViewItem>(Item);
+	if (!TreeItem || TreeItem->Provider.Get() != this || TreeItem->NodeIndex < 0 || TreeItem->NodeIndex >= GetNumNodes())
+		return;
+	GetItemsInRange(TreeItem->Path, Source->GetFirstChild(TreeItem->NodeIndex), Source->GetNumChildren(TreeItem->NodeIndex), OutChildren);
+}
+
+void UPPSTreeViewProvider::TrimPool(int32 MaxFreeItems)
+{
+	if (FreeItems.Num() > MaxFreeItems)
+	{
+		FreeItems.SetNum(FMath::Max(0, MaxFreeItems));
+	}
+}
+
+int32 UPPSTreeViewProvider::GetNumNodes() const
+{
+	return Source.IsValid() ? Source->GetNumNodes() : 0;
+}
+
+const FPropertyParserStruct* UPPSTreeViewProvider::GetNode(int32 NodeIndex) const
+{
+	return Source.IsValid() ? Source->GetNode(NodeIndex) : nullptr;
+}
+
+int32 UPPSTreeViewProvider::GetNodeDepth(int32 NodeIndex) const
+{
+	return Source.IsValid() ? Source->GetDepth(NodeIndex) : 0;
+}
+
+int32 UPPSTreeViewProvider::GetNodeNumChildren(int32 NodeIndex) const
+{
+	return Source.IsValid() ? Source->GetNumChildren(NodeIndex) : 0;
+}
+
+FString UPPSTreeViewProvider::GetNodeName(int32 NodeIndex) const
+{
+	return Source.IsValid() ? Source->GetName(NodeIndex) : FString();
+}
+
+FString UPPSTreeViewProvider::GetNodeTypeName(int32 NodeIndex) const
+{
+	return Source.IsValid() ? Source->GetTypeName(NodeIndex) : FString();
+}
+
+FString UPPSTreeViewProvider::GetNodeValue(int32 NodeIndex) const
+{
+	return Source.IsValid() ? Source->GetValue(NodeIndex) : FString();
+}
+
+void UPPSTreeViewProvider::OnSourceChanged()
+{
+	// 新数据中的下标在 TreeView 自上而下请求子节点时按路径重新确定
+	// 上一版数据中未被请求过的 Item 已不在 TreeView 中显示，放回池中
+	for (auto It = LiveItems.CreateIterator(); It; ++It)
+	{
+		UPPSTreeViewItem* Item = It.Value();
+		Item->NodeIndex = INDEX_NONE;
+		if (Item->Generation != Generation)
+		{
+			Item->Path.Reset();
+			FreeItems.Add(Item);
+			It.RemoveCurrent();
+		}
+	}
+	++Generation;
+
+	RefreshBoundTreeView();
+}
+
+UPPSTreeViewItem* UPPSTreeViewProvider::GetOrCreateItem(int32 NodeIndex, FString&& Path)
+{
+	UPPSTreeViewItem* Item;
+	if (const TObjectPtr<UPPSTreeViewItem>* Found = LiveItems.Find(Path))
+	{
+		Item = *Found;
+	}
+	else
+	{
+		Item = FreeItems.Num() > 0 ? FreeItems.Pop(false).Get() : NewObject<UPPSTreeViewItem>(this);
+		Item->Provider = this;
+		Item->Path = Path;
+		LiveItems.Add(MoveTemp(Path), Item);
+	}
+	Item->NodeIndex = NodeIndex;
+	Item->Generation = Generation;
+	return Item;
+}
+
+void UPPSTreeViewProvider::GetItemsInRange(const FString& ParentPath, int32 FirstNode, int32 NumNodes, TArray<UObject*>& OutItems)
+{
+	OutItems.Reserve(OutItems.Num() + NumNodes);
+	// 结构体成员名称唯一，数组 / Set 元素同名，按出现次数区分
+	TMap<FString, int32> NameCounts;
+	for (int32 Index = FirstNode; Index < FirstNode + NumNodes; ++Index)
+	{
+		const FString Name = Source->GetName(Index);
+		int32& Count = NameCounts.FindOrAdd(Name);
+		OutItems.Add(GetOrCreateItem(Index, FString::Printf(TEXT("%s/%s#%d"), *ParentPath, *Name, Count++)));
+	}
+}
+
+void UPPSTreeViewProvider::RefreshBoundTreeView()
+{
+	UTreeView* TreeView = BoundTreeView.Get();
+	if (!TreeView)
+		return;
+	TArray<UObject*> RootItems;
+	GetRootItems(RootItems);
+	TreeView->SetListItems(RootItems);
+	TreeView->RequestRefresh();
+}
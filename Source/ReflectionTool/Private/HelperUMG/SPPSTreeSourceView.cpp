@@ -0,0 +1,95 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#include "HelperUMG/SPPSTreeSourceView.h"
+
+#include "HelperUMG/PPSTreeSource.h"
+#include "ReflectionPPSDump.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
+#include "Widgets/SWindow.h"
+#include "Widgets/Text/STextBlock.h"
+
+static FAutoConsoleCommand GReflectionToolOpenDumpCommand(
+	TEXT("ReflectionTool.OpenDump"),
+	TEXT("Open a PPS dump file written by SavePPSDump in a tree view window. Usage: ReflectionTool.OpenDump <Filename>"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (Args.Num() == 0)
+		{
+			UE_LOG(ReflectionTool, Warning, TEXT("Usage: ReflectionTool.OpenDump <Filename>"));
+			return;
+		}
+		const FString Filename = FString::Join(Args, TEXT(" "));
+		if (!SPPSTreeSourceView::OpenDumpFileWindow(Filename))
+		{
+			UE_LOG(ReflectionTool, Warning, TEXT("ReflectionTool.OpenDump: failed to open %s"), *Filename);
+		}
+	}));
+
+void SPPSTreeSourceView::Construct(const FArguments& InArgs, TSharedRef<const IPPSTreeSource> InSource)
+{
+	Source = MoveTemp(InSource);
+	if (Source->GetNumNodes() > 0)
+	{
+		GetItemsInRange(Source->GetFirstChild(0), Source->GetNumChildren(0), RootItems);
+	}
+
+	ChildSlot
+	[
+		SNew(STreeView<FItem>)
+		.TreeItemsSource(&RootItems)
+		.OnGenerateRow(this, &SPPSTreeSourceView::OnGenerateRow)
+		.OnGetChildren(this, &SPPSTreeSourceView::OnGetChildren)
+	];
+}
+
+bool SPPSTreeSourceView::OpenDumpFileWindow(const FString& Filename)
+{
+	if (!FSlateApplication::IsInitialized())
+		return false;
+	TSharedPtr<FReflectionPPSDump> Dump = FReflectionPPSDump::Open(Filename);
+	if (!Dump.IsValid())
+		return false;
+
+	FSlateApplication::Get().AddWindow(SNew(SWindow)
+		.Title(FText::FromString(FPaths::GetCleanFilename(Filename)))
+		.ClientSize(FVector2D(800.0, 600.0))
+		[
+			SNew(SPPSTreeSourceView, MakeShared<FPPSDumpTreeSource>(Dump.ToSharedRef()))
+		]);
+	return true;
+}
+
+TSharedRef<ITableRow> SPPSTreeSourceView::OnGenerateRow(FItem Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	const int32 NodeIndex = *Item;
+	const FString Value = Source->GetValue(NodeIndex);
+	const FString Text = Value.IsEmpty()
+		? FString::Printf(TEXT("%s [%s]"), *Source->GetName(NodeIndex), *Source->GetTypeName(NodeIndex))
+		: FString::Printf(TEXT("%s [%s] = %s"), *Source->GetName(NodeIndex), *Source->GetTypeName(NodeIndex), *Value);
+	return SNew(STableRow<FItem>, OwnerTable)
+	[
+		SNew(STextBlock).Text(FText::FromString(Text))
+	];
+}
+
+void SPPSTreeSourceView::OnGetChildren(FItem Item, TArray<FItem>& OutChildren)
+{
+	const int32 NodeIndex = *Item;
+	GetItemsInRange(Source->GetFirstChild(NodeIndex), Source->GetNumChildren(NodeIndex), OutChildren);
+}
+
+void SPPSTreeSourceView::GetItemsInRange(int32 FirstNode, int32 NumNodes, TArray<FItem>& OutItems)
+{
+	OutItems.Reset(NumNodes);
+	for (int32 NodeIndex = FirstNode; NodeIndex < FirstNode + NumNodes; ++NodeIndex)
+	{
+		FItem& Item = Items.FindOrAdd(NodeIndex);
+		if (!Item.IsValid())
+		{
+			Item = MakeShared<int32>(NodeIndex);
+		}
+		OutItems.Add(Item);
+	}
+}
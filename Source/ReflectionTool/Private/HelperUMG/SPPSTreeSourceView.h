@@ -0,0 +1,40 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/STreeView.h"
+
+class IPPSTreeSource;
+
+/**
+ * 直接显示 IPPSTreeSource 的 Slate 树，不依赖任何 UMG 资源，展开节点时才读取子节点
+ * 用于在没有对应 Widget 蓝图时浏览转储文件，见 ReflectionTool.OpenDump
+ */
+class SPPSTreeSourceView : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SPPSTreeSourceView) {}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, TSharedRef<const IPPSTreeSource> InSource);
+
+	/**
+	 * @brief 在新窗口中打开 FReflectionPPSDump 写出的转储文件
+	 * @return 文件无效或没有 Slate 时返回 false
+	 */
+	static bool OpenDumpFileWindow(const FString& Filename);
+
+private:
+	// 节点下标；数据不会变化，同一节点始终使用同一个 Item，TreeView 的展开状态才能保持
+	using FItem = TSharedPtr<int32>;
+
+	TSharedRef<ITableRow> OnGenerateRow(FItem Item, const TSharedRef<STableViewBase>& OwnerTable);
+	void OnGetChildren(FItem Item, TArray<FItem>& OutChildren);
+	void GetItemsInRange(int32 FirstNode, int32 NumNodes, TArray<FItem>& OutItems);
+
+	TSharedPtr<const IPPSTreeSource> Source;
+	TArray<FItem> RootItems;
+	TMap<int32, FItem> Items;
+};
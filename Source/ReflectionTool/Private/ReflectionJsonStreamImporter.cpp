@@ -0,0 +1,546 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#include "ReflectionJsonStreamImporter.h"
+
+#include "ReflectionToolLib.h"
+#include "ReflectionToolStats.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/JsonReader.h"
+
+namespace ReflectionJsonStream
+{
+	// 一个 UStruct 的字段查找表，FString Key 大小写不敏感，同时登记 GetName 与 GetAuthoredName
+	struct FStructPlan
+	{
+		TWeakObjectPtr<const UStruct> Struct;
+		TMap<FString, FProperty*> Fields;
+	};
+
+	FCriticalSection PlanLock;
+	TMap<const UStruct*, TSharedPtr<const FStructPlan>> PlanCache;
+
+	TSharedPtr<const FStructPlan> GetPlan(const UStruct* Struct)
+	{
+		FScopeLock Lock(&PlanLock);
+		if (const TSharedPtr<const FStructPlan>* Found = PlanCache.Find(Struct))
+		{
+			if ((*Found)->Struct.Get() == Struct)
+			{
+				return *Found;
+			}
+		}
+
+		TSharedPtr<FStructPlan> Plan = MakeShared<FStructPlan>();
+		Plan->Struct = Struct;
+		for (FProperty* Property = Struct->PropertyLink; Property; Property = Property->PropertyLinkNext)
+		{
+			Plan->Fields.Add(Property->GetName(), Property);
+			Plan->Fields.Add(Property->GetAuthoredName(), Property);
+		}
+		PlanCache.Add(Struct, Plan);
+		return Plan;
+	}
+
+	enum class EFrameKind : uint8
+	{
+		Struct,
+		Array,
+		StaticArray,
+		Set,
+		Map,
+		// ImportArray 的顶层数组
+		RootArray,
+	};
+
+	struct FFrame
+	{
+		EFrameKind Kind = EFrameKind::Struct;
+		// Struct 的字段表
+		TSharedPtr<const FStructPlan> Plan;
+		// 容器属性（Array / StaticArray / Set / Map）
+		FProperty* Property = nullptr;
+		// Struct: 结构体地址；容器: 容器地址；StaticArray: 第 0 个元素地址
+		void* Addr = nullptr;
+		// StaticArray 下一个元素下标 / RootArray 已完成的元素个数
+		int32 Index = 0;
+		// Set 元素 / Map Key 的临时内存
+		uint8* Scratch = nullptr;
+	};
+
+	uint8* AllocateValue(const FProperty* Property)
+	{
+		uint8* Data = static_cast<uint8*>(FMemory::Malloc(Property->ElementSize, Property->GetMinAlignment()));
+		Property->InitializeValue(Data);
+		return Data;
+	}
+
+	void FreeValue(const FProperty* Property, uint8* Data)
+	{
+		Property->DestroyValue(Data);
+		FMemory::Free(Data);
+	}
+
+	template<typename CharType>
+	class TImporter
+	{
+	public:
+		explicit TImporter(const TSharedRef<TJsonReader<CharType>>& InReader)
+			: Reader(InReader)
+		{
+		}
+
+		~TImporter()
+		{
+			while (Stack.Num() > 0)
+			{
+				PopFrame(false);
+			}
+		}
+
+		bool ImportStruct(const UStruct* Struct, void* StructData)
+		{
+			EJsonNotation Notation;
+			if (!Reader->ReadNext(Notation) || Notation != EJsonNotation::ObjectStart)
+				return Fail(TEXT("root value is not a JSON object"));
+			PushStruct(Struct, StructData);
+			return Run();
+		}
+
+		bool ImportArray(const UScriptStruct* ElementStruct, TFunctionRef<bool(const void*, int32)> InOnElement)
+		{
+			EJsonNotation Notation;
+			if (!Reader->ReadNext(Notation) || Notation != EJsonNotation::ArrayStart)
+				return Fail(TEXT("root value is not a JSON array"));
+
+			RootStruct = ElementStruct;
+			OnElement = &InOnElement;
+			RootElement = static_cast<uint8*>(FMemory::Malloc(FMath::Max(1, ElementStruct->GetStructureSize()),
+				ElementStruct->GetMinAlignment()));
+			ElementStruct->InitializeStruct(RootElement);
+			Stack.AddDefaulted_GetRef().Kind = EFrameKind::RootArray;
+
+			const bool bResult = Run();
+
+			while (Stack.Num() > 0)
+			{
+				PopFrame(false);
+			}
+			ElementStruct->DestroyStruct(RootElement);
+			FMemory::Free(RootElement);
+			RootElement = nullptr;
+			return bResult;
+		}
+
+	private:
+		bool Run()
+		{
+			EJsonNotation Notation;
+			while (Stack.Num() > 0 && Reader->ReadNext(Notation))
+			{
+				if (Notation == EJsonNotation::Error)
+					break;
+				if (Notation == EJsonNotation::ObjectEnd || Notation == EJsonNotation::ArrayEnd)
+				{
+					// 回调要求停止
+					if (!PopFrame(true))
+						return true;
+					continue;
+				}
+
+				if (Stack.Last().Kind == EFrameKind::RootArray)
+				{
+					if (Notation == EJsonNotation::ObjectStart)
+					{
+						PushStruct(RootStruct, RootElement);
+					}
+					else if (Notation == EJsonNotation::ArrayStart)
+					{
+						Reader->SkipArray();
+					}
+					continue;
+				}
+
+				FProperty* Property = nullptr;
+				void* Addr = nullptr;
+				if (!ResolveTarget(Property, Addr))
+				{
+					// 结构体中不存在的字段，整体跳过
+					if (Notation == EJsonNotation::ObjectStart)
+					{
+						Reader->SkipObject();
+					}
+					else if (Notation == EJsonNotation::ArrayStart)
+					{
+						Reader->SkipArray();
+					}
+					continue;
+				}
+
+				if (Notation == EJsonNotation::ObjectStart)
+				{
+					BeginObject(Property, Addr);
+				}
+				else if (Notation == EJsonNotation::ArrayStart)
+				{
+					BeginArray(Property, Addr);
+				}
+				else
+				{
+					WriteScalar(Notation, Property, Addr);
+					CommitSetElement();
+				}
+			}
+
+			if (!Reader->GetErrorMessage().IsEmpty())
+				return Fail(*Reader->GetErrorMessage());
+			if (Stack.Num() > 0)
+				return Fail(TEXT("unexpected end of JSON input"));
+			return true;
+		}
+
+		bool Fail(const TCHAR* Message)
+		{
+			UE_LOG(ReflectionTool, Warning, TEXT("JSON stream import failed: %s"), Message);
+			return false;
+		}
+
+		void PushStruct(const UStruct* Struct, void* Addr)
+		{
+			FFrame& Frame = Stack.AddDefaulted_GetRef();
+			Frame.Kind = EFrameKind::Struct;
+			Frame.Plan = GetPlan(Struct);
+			Frame.Addr = Addr;
+		}
+
+		// 根据当前帧与 JSON 字段名得到要写入的属性与地址，返回 false 表示跳过该值
+		bool ResolveTarget(FProperty*& OutProperty, void*& OutAddr)
+		{
+			FFrame& Frame = Stack.Last();
+			switch (Frame.Kind)
+			{
+			case EFrameKind::Struct:
+				if (FProperty* const* Found = Frame.Plan->Fields.Find(Reader->GetIdentifier()))
+				{
+					OutProperty = *Found;
+					OutAddr = OutProperty->ContainerPtrToValuePtr<void>(Frame.Addr);
+					return true;
+				}
+				return false;
+			case EFrameKind::Array:
+				{
+					FArrayProperty* ArrayProperty = CastFieldChecked<FArrayProperty>(Frame.Property);
+					FScriptArrayHelper Helper(ArrayProperty, Frame.Addr);
+					OutProperty = ArrayProperty->Inner;
+					OutAddr = Helper.GetRawPtr(Helper.AddValue());
+					return true;
+				}
+			case EFrameKind::StaticArray:
+				if (Frame.Index >= Frame.Property->ArrayDim)
+					return false;
+				OutProperty = Frame.Property;
+				OutAddr = static_cast<uint8*>(Frame.Addr) + Frame.Property->ElementSize * Frame.Index++;
+				return true;
+			case EFrameKind::Set:
+				OutProperty = CastFieldChecked<FSetProperty>(Frame.Property)->ElementProp;
+				OutAddr = Frame.Scratch;
+				return true;
+			case EFrameKind::Map:
+				{
+					FMapProperty* MapProperty = CastFieldChecked<FMapProperty>(Frame.Property);
+					if (!ImportMapKey(MapProperty->KeyProp, Frame.Scratch, Reader->GetIdentifier()))
+						return false;
+					FScriptMapHelper Helper(MapProperty, Frame.Addr);
+					OutProperty = MapProperty->ValueProp;
+					OutAddr = Helper.FindOrAdd(Frame.Scratch);
+					return OutAddr != nullptr;
+				}
+			default:
+				return false;
+			}
+		}
+
+		void BeginObject(FProperty* Property, void* Addr)
+		{
+			if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+			{
+				PushStruct(StructProperty->Struct, Addr);
+			}
+			else if (FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+			{
+				FScriptMapHelper(MapProperty, Addr).EmptyValues();
+				FFrame& Frame = Stack.AddDefaulted_GetRef();
+				Frame.Kind = EFrameKind::Map;
+				Frame.Property = MapProperty;
+				Frame.Addr = Addr;
+				Frame.Scratch = AllocateValue(MapProperty->KeyProp);
+			}
+			else
+			{
+				Reader->SkipObject();
+			}
+		}
+
+		void BeginArray(FProperty* Property, void* Addr)
+		{
+			if (FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+			{
+				FScriptArrayHelper(ArrayProperty, Addr).EmptyValues();
+				FFrame& Frame = Stack.AddDefaulted_GetRef();
+				Frame.Kind = EFrameKind::Array;
+				Frame.Property = ArrayProperty;
+				Frame.Addr = Addr;
+			}
+			else if (FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+			{
+				FScriptSetHelper(SetProperty, Addr).EmptyElements();
+				FFrame& Frame = Stack.AddDefaulted_GetRef();
+				Frame.Kind = EFrameKind::Set;
+				Frame.Property = SetProperty;
+				Frame.Addr = Addr;
+				Frame.Scratch = AllocateValue(SetProperty->ElementProp);
+			}
+			else if (Property->ArrayDim > 1 && Stack.Last().Kind == EFrameKind::Struct)
+			{
+				FFrame& Frame = Stack.AddDefaulted_GetRef();
+				Frame.Kind = EFrameKind::StaticArray;
+				Frame.Property = Property;
+				Frame.Addr = Addr;
+			}
+			else
+			{
+				Reader->SkipArray();
+			}
+		}
+
+		// 弹出一帧，返回 false 表示回调要求停止
+		bool PopFrame(bool bCommit)
+		{
+			const FFrame Frame = Stack.Pop(false);
+			if (Frame.Kind == EFrameKind::Set)
+			{
+				FreeValue(CastFieldChecked<FSetProperty>(Frame.Property)->ElementProp, Frame.Scratch);
+			}
+			else if (Frame.Kind == EFrameKind::Map)
+			{
+				FreeValue(CastFieldChecked<FMapProperty>(Frame.Property)->KeyProp, Frame.Scratch);
+			}
+
+			if (!bCommit || Stack.Num() == 0 || Frame.Kind != EFrameKind::Struct)
+				return true;
+
+			FFrame& Parent = Stack.Last();
+			if (Parent.Kind == EFrameKind::Set)
+			{
+				CommitSetElement();
+			}
+			else if (Parent.Kind == EFrameKind::RootArray)
+			{
+				const bool bContinue = (*OnElement)(RootElement, Parent.Index++);
+				// 复位元素，下一个元素复用同一块内存
+				RootStruct->ClearScriptStruct(RootElement);
+				return bContinue;
+			}
+			return true;
+		}
+
+		// Set 的元素先写入临时内存，完整后再加入集合
+		void CommitSetElement()
+		{
+			FFrame& Frame = Stack.Last();
+			if (Frame.Kind != EFrameKind::Set)
+				return;
+			FSetProperty* SetProperty = CastFieldChecked<FSetProperty>(Frame.Property);
+			FScriptSetHelper(SetProperty, Frame.Addr).AddElement(Frame.Scratch);
+			SetProperty->ElementProp->ClearValue(Frame.Scratch);
+		}
+
+		static bool ImportMapKey(FProperty* KeyProp, void* KeyAddr, const FString& Key)
+		{
+			if (const FStrProperty* StrProperty = CastField<FStrProperty>(KeyProp))
+			{
+				StrProperty->SetPropertyValue(KeyAddr, Key);
+				return true;
+			}
+			if (const FNameProperty* NameProperty = CastField<FNameProperty>(KeyProp))
+			{
+				NameProperty->SetPropertyValue(KeyAddr, FName(*Key));
+				return true;
+			}
+			KeyProp->ClearValue(KeyAddr);
+			WriteString(KeyProp, KeyAddr, Key);
+			return true;
+		}
+
+		void WriteScalar(EJsonNotation Notation, FProperty* Property, void* Addr)
+		{
+			switch (Notation)
+			{
+			case EJsonNotation::Null:
+				Property->ClearValue(Addr);
+				break;
+			case EJsonNotation::Boolean:
+				{
+					const bool bValue = Reader->GetValueAsBoolean();
+					if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+					{
+						BoolProperty->SetPropertyValue(Addr, bValue);
+					}
+					else if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+					{
+						NumericProperty->SetIntPropertyValue(Addr, static_cast<int64>(bValue));
+					}
+					else
+					{
+						WriteString(Property, Addr, bValue ? TEXT("true") : TEXT("false"));
+					}
+				}
+				break;
+			case EJsonNotation::Number:
+				{
+					const double Number = Reader->GetValueAsNumber();
+					if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+					{
+						EnumProperty->GetUnderlyingProperty()->SetIntPropertyValue(Addr, static_cast<int64>(Number));
+					}
+					else if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+					{
+						if (NumericProperty->IsFloatingPoint())
+						{
+							NumericProperty->SetFloatingPointPropertyValue(Addr, Number);
+						}
+						else
+						{
+							NumericProperty->SetIntPropertyValue(Addr, static_cast<int64>(Number));
+						}
+					}
+					else if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+					{
+						BoolProperty->SetPropertyValue(Addr, Number != 0.0);
+					}
+					else
+					{
+						WriteString(Property, Addr, FString::SanitizeFloat(Number));
+					}
+				}
+				break;
+			case EJsonNotation::String:
+				WriteString(Property, Addr, Reader->GetValueAsString());
+				break;
+			default:
+				break;
+			}
+		}
+
+		static void WriteString(FProperty* Property, void* Addr, const FString& Value)
+		{
+			if (const FStrProperty* StrProperty = CastField<FStrProperty>(Property))
+			{
+				StrProperty->SetPropertyValue(Addr, Value);
+			}
+			else if (const FNameProperty* NameProperty = CastField<FNameProperty>(Property))
+			{
+				NameProperty->SetPropertyValue(Addr, FName(*Value));
+			}
+			else if (const FTextProperty* TextProperty = CastField<FTextProperty>(Property))
+			{
+				TextProperty->SetPropertyValue(Addr, FText::FromString(Value));
+			}
+			else if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+			{
+				const int64 EnumValue = EnumProperty->GetEnum()->GetValueByNameString(Value);
+				if (EnumValue != INDEX_NONE)
+				{
+					EnumProperty->GetUnderlyingProperty()->SetIntPropertyValue(Addr, EnumValue);
+				}
+			}
+			else if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+			{
+				if (const UEnum* EnumDef = NumericProperty->GetIntPropertyEnum())
+				{
+					const int64 EnumValue = EnumDef->GetValueByNameString(Value);
+					if (EnumValue != INDEX_NONE)
+					{
+						NumericProperty->SetIntPropertyValue(Addr, EnumValue);
+					}
+				}
+				else
+				{
+					NumericProperty->SetNumericPropertyValueFromString(Addr, *Value);
+				}
+			}
+			else if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+			{
+				BoolProperty->SetPropertyValue(Addr, Value.ToBool());
+			}
+			else if (const FObjectProperty* ObjectProperty = CastField<FObjectProperty>(Property))
+			{
+				UObject* Object = nullptr;
+				if (!Value.IsEmpty())
+				{
+					Object = FSoftObjectPath(Value).ResolveObject();
+					if (!Object)
+					{
+						Object = StaticLoadObject(ObjectProperty->PropertyClass, nullptr, *Value);
+					}
+				}
+				ObjectProperty->SetObjectPropertyValue(Addr, Object);
+			}
+			else
+			{
+				Property->ImportText_Direct(*Value, Addr, nullptr, PPF_None);
+			}
+		}
+
+		TSharedRef<TJsonReader<CharType>> Reader;
+		TArray<FFrame, TInlineAllocator<16>> Stack;
+
+		// ImportArray 使用
+		const UScriptStruct* RootStruct = nullptr;
+		uint8* RootElement = nullptr;
+		TFunctionRef<bool(const void*, int32)>* OnElement = nullptr;
+	};
+}
+
+bool FReflectionJsonStreamImporter::ImportStruct(FArchive& Archive, const UStruct* Struct, void* StructData)
+{
+	REFLECTIONTOOL_SCOPE(ImportJson);
+	if (!Struct || !StructData)
+		return false;
+	ReflectionJsonStream::TImporter<UCS2CHAR> Importer(TJsonReader<UCS2CHAR>::Create(&Archive));
+	return Importer.ImportStruct(Struct, StructData);
+}
+
+bool FReflectionJsonStreamImporter::ImportStruct(FStringView Json, const UStruct* Struct, void* StructData)
+{
+	REFLECTIONTOOL_SCOPE(ImportJson);
+	if (!Struct || !StructData)
+		return false;
+	ReflectionJsonStream::TImporter<TCHAR> Importer(TJsonReaderFactory<TCHAR>::CreateFromView(Json));
+	return Importer.ImportStruct(Struct, StructData);
+}
+
+bool FReflectionJsonStreamImporter::ImportArray(FArchive& Archive, const UScriptStruct* ElementStruct,
+	TFunctionRef<bool(const void* Element, int32 Index)> OnElement)
+{
+	REFLECTIONTOOL_SCOPE(ImportJson);
+	if (!ElementStruct)
+		return false;
+	ReflectionJsonStream::TImporter<UCS2CHAR> Importer(TJsonReader<UCS2CHAR>::Create(&Archive));
+	return Importer.ImportArray(ElementStruct, OnElement);
+}
+
+bool FReflectionJsonStreamImporter::ImportArray(FStringView Json, const UScriptStruct* ElementStruct,
+	TFunctionRef<bool(const void* Element, int32 Index)> OnElement)
+{
+	REFLECTIONTOOL_SCOPE(ImportJson);
+	if (!ElementStruct)
+		return false;
+	ReflectionJsonStream::TImporter<TCHAR> Importer(TJsonReaderFactory<TCHAR>::CreateFromView(Json));
+	return Importer.ImportArray(ElementStruct, OnElement);
+}
+
+void FReflectionJsonStreamImporter::ClearCache()
+{
+	FScopeLock Lock(&ReflectionJsonStream::PlanLock);
+	ReflectionJsonStream::PlanCache.Empty();
+}
@@ -0,0 +1,57 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#include "ReflectionPPSConvertAsyncAction.h"
+
+#include "ReflectionPPSConvertJob.h"
+
+UReflectionPPSConvertAsyncAction* UReflectionPPSConvertAsyncAction::GetPropertyParserStructTimeSliced(UObject* WorldContextObject,
+	UObject* Object, const FPPSConvertOptions& Options, int32 BudgetMicroseconds)
+{
+	UReflectionPPSConvertAsyncAction* Action = NewObject<UReflectionPPSConvertAsyncAction>();
+	Action->TargetObject = Object;
+	Action->ConvertOptions = Options;
+	Action->SliceBudgetMicroseconds = FMath::Max(BudgetMicroseconds, 1);
+	Action->RegisterWithGameInstance(WorldContextObject);
+	return Action;
+}
+
+void UReflectionPPSConvertAsyncAction::Activate()
+{
+	if (!IsValid(TargetObject))
+	{
+		UE_LOG(ReflectionTool, Warning, TEXT("GetPropertyParserStructTimeSliced: invalid object"));
+		OnFailed.Broadcast(FPropertyParserStruct());
+		SetReadyToDestroy();
+		return;
+	}
+	// 拷贝在任务中分帧进行，任务只弱引用对象，节点不再持有
+	Job = FReflectionPPSConvertJob::CreateForObject(TargetObject, ConvertOptions);
+	TargetObject = nullptr;
+	Job->OnCompleted().AddUObject(this, &UReflectionPPSConvertAsyncAction::HandleCompleted);
+	Job->StartTicking(SliceBudgetMicroseconds);
+}
+
+void UReflectionPPSConvertAsyncAction::SetReadyToDestroy()
+{
+	// 节点被提前销毁时停止转换
+	if (Job)
+	{
+		Job->StopTicking();
+		Job.Reset();
+	}
+	Super::SetReadyToDestroy();
+}
+
+void UReflectionPPSConvertAsyncAction::HandleCompleted(const FPropertyParserStruct& Result)
+{
+	if (Job->HasFailed())
+	{
+		OnFailed.Broadcast(Result);
+		SetReadyToDestroy();
+		return;
+	}
+	UE_LOG(ReflectionTool, Verbose, TEXT("GetPropertyParserStructTimeSliced: %d node(s) in %d frame(s)"),
+		Job->GetNodeCount(), Job->GetNumSlices());
+	OnCompleted.Broadcast(Result);
+	SetReadyToDestroy();
+}
@@ -0,0 +1,308 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#include "ReflectionPPSConvertJob.h"
+
+#include "ReflectionStructSnapshot.h"
+#include "ReflectionToolStats.h"
+
+namespace ReflectionPPSConvertJob
+{
+	// 与 ReflectionToolLib.cpp 中的类型名一致
+	static const FName TypeName_Struct(TEXT("Struct"));
+	static const FName TypeName_TArray(TEXT("TArray"));
+	static const FName TypeName_TSet(TEXT("TSet"));
+	static const FName TypeName_TMap(TEXT("TMap"));
+	static const FName TypeName_MapItem(TEXT("MapItem"));
+
+	// 分段拷贝容器时每步拷贝的元素数，元素更少的容器一次拷贝完
+	static constexpr int32 ElementsPerCaptureStep = 256;
+
+	// 容器属性的元素数，其他属性返回 INDEX_NONE
+	static int32 GetContainerNum(const FProperty* Property, const void* Container)
+	{
+		const void* Addr = Property->ContainerPtrToValuePtr<void>(Container);
+		if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+			return FScriptArrayHelper(ArrayProperty, Addr).Num();
+		if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+			return FScriptSetHelper(SetProperty, Addr).Num();
+		if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+			return FScriptMapHelper(MapProperty, Addr).Num();
+		return INDEX_NONE;
+	}
+}
+
+FReflectionPPSConvertJob::FReflectionPPSConvertJob(const TSharedRef<FReflectionStructSnapshot>& InSnapshot,
+	const FPPSConvertOptions& Options)
+	: Snapshot(InSnapshot)
+	, Context(Options)
+{
+	// 展开对象需要读取对象的实时数据，与快照转换一致只输出对象路径
+	Context.Options.bExpandObjects = false;
+	Result.SetTypeName(ReflectionPPSConvertJob::TypeName_Struct);
+	Result.bHaveChild = true;
+	for (TFieldIterator<FProperty> It(Snapshot->GetStruct()); It; ++It)
+	{
+		RootProperties.Add(*It);
+	}
+	PushFrame(FFrame::EKind::Root, Result, nullptr, Snapshot->GetData());
+}
+
+FReflectionPPSConvertJob::~FReflectionPPSConvertJob()
+{
+	StopTicking();
+}
+
+TSharedRef<FReflectionPPSConvertJob> FReflectionPPSConvertJob::Create(const TSharedRef<FReflectionStructSnapshot>& InSnapshot,
+	const FPPSConvertOptions& Options)
+{
+	return MakeShareable(new FReflectionPPSConvertJob(InSnapshot, Options));
+}
+
+TSharedRef<FReflectionPPSConvertJob> FReflectionPPSConvertJob::CreateForObject(const UObject* Object,
+	const FPPSConvertOptions& Options)
+{
+	check(Object);
+	// 一次拷贝整个对象本身就可能超出预算，改为在 Advance 中逐个属性拷贝
+	TSharedRef<FReflectionPPSConvertJob> Job = Create(FReflectionStructSnapshot::CreateEmpty(Object->GetClass()), Options);
+	Job->CaptureSource = Object;
+	Job->bCapturing = Job->RootProperties.Num() > 0;
+	return Job;
+}
+
+bool FReflectionPPSConvertJob::Advance(double BudgetMicroseconds)
+{
+	if (IsDone())
+		return true;
+
+	REFLECTIONTOOL_SCOPE(ConvertJob);
+	REFLECTIONTOOL_CONTEXT_COUNTERS(Context);
+	++NumSlices;
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	const uint64 BudgetCycles = BudgetMicroseconds > 0
+		? static_cast<uint64>(BudgetMicroseconds * 1e-6 / FPlatformTime::GetSecondsPerCycle64())
+		: MAX_uint64;
+	// Cycles64 只读时间戳计数器，每步都检查
+	while (!IsDone())
+	{
+		if (bCapturing)
+		{
+			if (!CaptureNextProperty())
+			{
+				UE_LOG(ReflectionTool, Warning, TEXT("PPS convert job: object was destroyed before it was fully captured"));
+				bFailed = true;
+				bCapturing = false;
+				Stack.Reset();
+				Result = FPropertyParserStruct();
+				break;
+			}
+		}
+		else
+		{
+			Step();
+		}
+		if (FPlatformTime::Cycles64() - StartCycles >= BudgetCycles)
+			break;
+	}
+	if (!IsDone())
+		return false;
+
+	StopTicking();
+	CompletedDelegate.Broadcast(Result);
+	return true;
+}
+
+void FReflectionPPSConvertJob::StartTicking(double BudgetMicroseconds)
+{
+	StopTicking();
+	if (IsDone())
+		return;
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateSP(this, &FReflectionPPSConvertJob::Tick, BudgetMicroseconds));
+}
+
+void FReflectionPPSConvertJob::StopTicking()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+}
+
+bool FReflectionPPSConvertJob::Tick(float DeltaTime, double BudgetMicroseconds)
+{
+	return !Advance(BudgetMicroseconds);
+}
+
+bool FReflectionPPSConvertJob::CaptureNextProperty()
+{
+	using namespace ReflectionPPSConvertJob;
+
+	const UObject* Object = CaptureSource.Get();
+	if (!Object)
+		return false;
+	const FProperty* Property = RootProperties[NumCapturedProperties];
+	const int32 ContainerNum = GetContainerNum(Property, Object);
+	if (CaptureElementIndex == 0 && ContainerNum <= ElementsPerCaptureStep)
+	{
+		Snapshot->CaptureProperty(Property, Object);
+	}
+	else if (CaptureElementIndex > 0 && ContainerNum != CaptureElementNum)
+	{
+		// 分段之间容器被修改，已拷贝的部分作废，整体重新拷贝一次以保证结束
+		UE_LOG(ReflectionTool, Verbose, TEXT("PPS convert job: %s changed while being captured, copying it at once"), *Property->GetName());
+		Snapshot->CaptureProperty(Property, Object);
+		CaptureElementIndex = 0;
+	}
+	else
+	{
+		CaptureElementNum = ContainerNum;
+		CaptureElementIndex = Snapshot->CaptureContainerElements(Property, Object, CaptureElementIndex, ElementsPerCaptureStep);
+		if (CaptureElementIndex != INDEX_NONE)
+			return true;
+		CaptureElementIndex = 0;
+	}
+	if (++NumCapturedProperties >= RootProperties.Num())
+	{
+		bCapturing = false;
+		CaptureSource.Reset();
+	}
+	return true;
+}
+
+void FReflectionPPSConvertJob::Step()
+{
+	using namespace ReflectionPPSConvertJob;
+
+	// 每个分支只生成一个子节点；ConvertProperty 可能入栈使 Frame 失效，因此放在最后调用
+	// 预算检查与 UReflectionToolLib 的各个 XXXToPropertyStruct 一致：有下一个子节点时才检查，MapItem 的 Key / Value 之间不检查
+	FFrame& Frame = Stack.Last();
+	switch (Frame.Kind)
+	{
+	case FFrame::EKind::Root:
+		{
+			if (Frame.Index >= RootProperties.Num() || Context.TruncateIfOverBudget(*Frame.Node))
+				break;
+			FProperty* Property = RootProperties[Frame.Index++];
+			ConvertProperty(Property, Property->ContainerPtrToValuePtr<uint8>(Frame.Addr), Frame.Node->Children.AddDefaulted_GetRef());
+			return;
+		}
+	case FFrame::EKind::Struct:
+		{
+			if (!Frame.NextField || Context.TruncateIfOverBudget(*Frame.Node))
+				break;
+			FProperty* Property = Frame.NextField;
+			Frame.NextField = Property->PropertyLinkNext;
+			ConvertProperty(Property, Property->ContainerPtrToValuePtr<uint8>(Frame.Addr), Frame.Node->Children.AddDefaulted_GetRef());
+			return;
+		}
+	case FFrame::EKind::Array:
+		{
+			const FArrayProperty* ArrayProperty = CastFieldChecked<FArrayProperty>(Frame.Property);
+			FScriptArrayHelper Helper(ArrayProperty, Frame.Addr);
+			if (Frame.Index >= Helper.Num() || Context.TruncateIfOverBudget(*Frame.Node))
+				break;
+			ConvertProperty(ArrayProperty->Inner, Helper.GetRawPtr(Frame.Index++), Frame.Node->Children.AddDefaulted_GetRef());
+			return;
+		}
+	case FFrame::EKind::Set:
+		{
+			if (Frame.Remaining <= 0 || Context.TruncateIfOverBudget(*Frame.Node))
+				break;
+			const FSetProperty* SetProperty = CastFieldChecked<FSetProperty>(Frame.Property);
+			FScriptSetHelper Helper(SetProperty, Frame.Addr);
+			while (!Helper.IsValidIndex(Frame.Index))
+			{
+				++Frame.Index;
+			}
+			--Frame.Remaining;
+			ConvertProperty(SetProperty->ElementProp, Helper.GetElementPtr(Frame.Index++), Frame.Node->Children.AddDefaulted_GetRef());
+			return;
+		}
+	case FFrame::EKind::Map:
+		{
+			if (Frame.Remaining <= 0 || Context.TruncateIfOverBudget(*Frame.Node))
+				break;
+			FScriptMapHelper Helper(CastFieldChecked<FMapProperty>(Frame.Property), Frame.Addr);
+			while (!Helper.IsValidIndex(Frame.Index))
+			{
+				++Frame.Index;
+			}
+			--Frame.Remaining;
+			const int32 Index = Frame.Index++;
+			FPropertyParserStruct& MapItem = Frame.Node->Children.AddDefaulted_GetRef();
+			MapItem.Name = FString::FromInt(Index);
+			MapItem.SetTypeName(TypeName_MapItem);
+			MapItem.bHaveChild = true;
+			PushFrame(FFrame::EKind::MapItem, MapItem, Frame.Property, Frame.Addr, nullptr, Index, 2);
+			return;
+		}
+	case FFrame::EKind::MapItem:
+		{
+			if (Frame.Remaining <= 0)
+				break;
+			const FMapProperty* MapProperty = CastFieldChecked<FMapProperty>(Frame.Property);
+			FScriptMapHelper Helper(MapProperty, Frame.Addr);
+			const bool bKey = Frame.Remaining-- == 2;
+			ConvertProperty(bKey ? MapProperty->KeyProp : MapProperty->ValueProp,
+				bKey ? Helper.GetKeyPtr(Frame.Index) : Helper.GetValuePtr(Frame.Index), Frame.Node->Children.AddDefaulted_GetRef());
+			return;
+		}
+	}
+	PopFrame();
+}
+
+void FReflectionPPSConvertJob::ConvertProperty(FProperty* Property, const void* Addr, FPropertyParserStruct& OutNode)
+{
+	using namespace ReflectionPPSConvertJob;
+
+	// 叶子节点一次转换完，与 FGetPropertyParserStruct 的结果相同
+	const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+	if (!StructProperty && !Property->IsA<FArrayProperty>() && !Property->IsA<FSetProperty>() && !Property->IsA<FMapProperty>())
+	{
+		UReflectionToolLib::PropertyToPropertyStruct(Property, Addr, OutNode, &Context);
+		return;
+	}
+
+	// 结构体与容器节点先填写自身，子节点在之后的 Step 中生成，出栈时再登记，计数与 PropertyToPropertyStruct 一致
+	++Context.PropertiesVisited;
+	OutNode.SetName(UReflectionToolLib::GetPropertyAuthoredFName(Property));
+	OutNode.bHaveChild = true;
+	if (StructProperty)
+	{
+		OutNode.SetTypeName(UReflectionToolLib::GetPropertyTypeFName(Property));
+		PushFrame(FFrame::EKind::Struct, OutNode, Property, Addr, StructProperty->Struct->PropertyLink);
+	}
+	else if (Property->IsA<FArrayProperty>())
+	{
+		OutNode.SetTypeName(TypeName_TArray);
+		PushFrame(FFrame::EKind::Array, OutNode, Property, Addr);
+	}
+	else if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+	{
+		OutNode.SetTypeName(TypeName_TSet);
+		PushFrame(FFrame::EKind::Set, OutNode, Property, Addr, nullptr, 0, FScriptSetHelper(SetProperty, Addr).Num());
+	}
+	else
+	{
+		OutNode.SetTypeName(TypeName_TMap);
+		const FMapProperty* MapProperty = CastFieldChecked<FMapProperty>(Property);
+		PushFrame(FFrame::EKind::Map, OutNode, Property, Addr, nullptr, 0, FScriptMapHelper(MapProperty, Addr).Num());
+	}
+}
+
+void FReflectionPPSConvertJob::PushFrame(FFrame::EKind Kind, FPropertyParserStruct& Node, FProperty* Property, const void* Addr,
+	FProperty* NextField, int32 Index, int32 Remaining)
+{
+	Stack.Add({ Kind, &Node, Property, Addr, NextField, Index, Remaining });
+}
+
+void FReflectionPPSConvertJob::PopFrame()
+{
+	const FFrame Frame = Stack.Pop(false);
+	// 根节点不计数，与 FGetPropertyParserStruct 一致
+	if (Frame.Kind != FFrame::EKind::Root)
+	{
+		Context.AddNode(*Frame.Node);
+	}
+}
@@ -0,0 +1,469 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#include "ReflectionPPSDump.h"
+
+#include "ReflectionToolLib.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+
+namespace ReflectionPPSDump
+{
+	// 'RTPD'
+	constexpr uint32 Magic = 0x44505452;
+	constexpr uint32 FormatVersion = 1;
+
+	enum ENodeFlags : uint32
+	{
+		NodeFlag_HaveChild = 1 << 0,
+		NodeFlag_Truncated = 1 << 1,
+	};
+
+	// 文件头，之后紧跟节点表（8 字节对齐），再之后为字符串区
+	struct FHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		int32 NumNodes;
+		// FNodeRecord 的大小，布局变化时拒绝打开
+		int32 RecordSize;
+		int64 NodeTableOffset;
+		int64 StringsOffset;
+		int64 StringsSize;
+	};
+
+	// FString 默认的哈希与比较忽略大小写，名称池需区分大小写，否则 "health" 会复用 "Health" 的字符串
+	struct FCaseSensitiveNameKeyFuncs : TDefaultMapKeyFuncs<FString, TPair<int64, int32>, false>
+	{
+		static FORCEINLINE bool Matches(const FString& A, const FString& B)
+		{
+			return A.Equals(B, ESearchCase::CaseSensitive);
+		}
+
+		static FORCEINLINE uint32 GetKeyHash(const FString& Key)
+		{
+			return FCrc::StrCrc32(*Key);
+		}
+	};
+
+	// 流式写入时字符串区每积累这么多字节写出一次
+	constexpr int32 StringFlushSize = 1024 * 1024;
+
+	// 字符串区：UTF-8 拼接，不带结尾 0
+	struct FStringWriter
+	{
+		TArray<uint8> Bytes;
+		// 已写出到临时文件的字节数，Bytes 中的内容接在其后
+		int64 FlushedSize = 0;
+		TMap<FString, TPair<int64, int32>, FDefaultSetAllocator, FCaseSensitiveNameKeyFuncs> NamePool;
+
+		TPair<int64, int32> Add(const FString& String)
+		{
+			const FTCHARToUTF8 Converter(*String, String.Len());
+			const int64 Offset = FlushedSize + Bytes.Num();
+			Bytes.Append(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length());
+			return TPair<int64, int32>(Offset, Converter.Length());
+		}
+
+		int64 GetSize() const { return FlushedSize + Bytes.Num(); }
+
+		void Flush(FArchive& Ar)
+		{
+			Ar.Serialize(Bytes.GetData(), Bytes.Num());
+			FlushedSize += Bytes.Num();
+			Bytes.Reset();
+		}
+
+		// 有驻留形式的名称按 FName 的显示索引查找，只比较整数
+		TMap<uint64, TPair<int64, int32>> NameIdPool;
+
+		// 名称与类型名大量重复，只写入一次
+		TPair<int64, int32> AddName(const FString& Name)
+		{
+			if (const TPair<int64, int32>* Found = NamePool.Find(Name))
+				return *Found;
+			return NamePool.Add(Name, Add(Name));
+		}
+
+		// NameId 与 Name 由 SetName 同时写入，显示索引区分大小写，与按字符串去重的结果相同
+		TPair<int64, int32> AddName(FName NameId, const FString& Name)
+		{
+			if (NameId.IsNone())
+				return AddName(Name);
+			const uint64 Key = static_cast<uint64>(NameId.GetDisplayIndex().ToUnstableInt()) << 32 | static_cast<uint32>(NameId.GetNumber());
+			if (const TPair<int64, int32>* Found = NameIdPool.Find(Key))
+				return *Found;
+			return NameIdPool.Add(Key, AddName(Name));
+		}
+	};
+}
+
+FReflectionPPSDump::FReflectionPPSDump() = default;
+
+FReflectionPPSDump::~FReflectionPPSDump()
+{
+	// 先释放映射区域再关闭文件
+	Region.Reset();
+	FileHandle.Reset();
+}
+
+void FReflectionPPSDump::FillRecord(FNodeRecord& Record, const FPropertyParserStruct& Node, ReflectionPPSDump::FStringWriter& Strings)
+{
+	using namespace ReflectionPPSDump;
+	Record.NumChildren = Node.Children.Num();
+	Record.Flags = (Node.bHaveChild ? NodeFlag_HaveChild : 0) | (Node.bTruncated ? NodeFlag_Truncated : 0);
+	const TPair<int64, int32> Name = Strings.AddName(Node.NameId, Node.Name);
+	const TPair<int64, int32> Type = Strings.AddName(Node.TypeNameId, Node.TypeName);
+	const TPair<int64, int32> Value = Strings.Add(Node.Value);
+	Record.NameOffset = Name.Key;
+	Record.NameLength = Name.Value;
+	Record.TypeOffset = Type.Key;
+	Record.TypeLength = Type.Value;
+	Record.ValueOffset = Value.Key;
+	Record.ValueLength = Value.Value;
+}
+
+void FReflectionPPSDump::FlattenChildren(const FPropertyParserStruct& Parent, int32 ParentDepth, int64 BaseIndex,
+	ReflectionPPSDump::FStringWriter& Strings, TArray<FNodeRecord>& OutRecords)
+{
+	// 广度优先展平，同一节点的子节点下标连续，与 UPPSTreeViewProvider 的节点下标一致
+	const int32 First = OutRecords.Num();
+	TArray<const FPropertyParserStruct*> Nodes;
+	for (const FPropertyParserStruct& Child : Parent.Children)
+	{
+		Nodes.Add(&Child);
+		OutRecords.AddZeroed_GetRef().Depth = ParentDepth + 1;
+	}
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		const FPropertyParserStruct* Node = Nodes[Index];
+		int32 ChildDepth;
+		{
+			FNodeRecord& Record = OutRecords[First + Index];
+			FillRecord(Record, *Node, Strings);
+			Record.FirstChild = static_cast<int32>(BaseIndex + Nodes.Num());
+			ChildDepth = Record.Depth + 1;
+		}
+		for (const FPropertyParserStruct& Child : Node->Children)
+		{
+			Nodes.Add(&Child);
+			OutRecords.AddZeroed_GetRef().Depth = ChildDepth;
+		}
+	}
+}
+
+void FReflectionPPSDump::WriteHeader(FArchive& Ar, int32 NumNodes, int64 StringsSize)
+{
+	using namespace ReflectionPPSDump;
+	FHeader Header;
+	Header.Magic = Magic;
+	Header.Version = FormatVersion;
+	Header.NumNodes = NumNodes;
+	Header.RecordSize = sizeof(FNodeRecord);
+	Header.NodeTableOffset = Align(static_cast<int64>(sizeof(FHeader)), 8);
+	Header.StringsOffset = Header.NodeTableOffset + static_cast<int64>(NumNodes) * sizeof(FNodeRecord);
+	Header.StringsSize = StringsSize;
+
+	// 按本机字节序整段写入，读取时直接映射
+	Ar.Serialize(&Header, sizeof(Header));
+	uint8 Padding[8] = {};
+	Ar.Serialize(Padding, Header.NodeTableOffset - sizeof(FHeader));
+}
+
+bool FReflectionPPSDump::Write(const FPropertyParserStruct& Root, const FString& Filename)
+{
+	using namespace ReflectionPPSDump;
+
+	TArray<FNodeRecord> Records;
+	FStringWriter Strings;
+	{
+		// 根节点深度为 -1，与 UPPSTreeViewProvider 一致
+		FNodeRecord& RootRecord = Records.AddZeroed_GetRef();
+		FillRecord(RootRecord, Root, Strings);
+		RootRecord.Depth = -1;
+		RootRecord.FirstChild = 1;
+	}
+	FlattenChildren(Root, -1, 1, Strings, Records);
+
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Filename));
+	if (!Writer)
+	{
+		UE_LOG(ReflectionTool, Warning, TEXT("PPSDump: failed to open %s"), *Filename);
+		return false;
+	}
+	WriteHeader(*Writer, Records.Num(), Strings.GetSize());
+	Writer->Serialize(Records.GetData(), static_cast<int64>(Records.Num()) * sizeof(FNodeRecord));
+	Writer->Serialize(Strings.Bytes.GetData(), Strings.Bytes.Num());
+	return Writer->Close() && !Writer->IsError();
+}
+
+TSharedPtr<FReflectionPPSDump> FReflectionPPSDump::Open(const FString& Filename)
+{
+	using namespace ReflectionPPSDump;
+
+	TUniquePtr<IMappedFileHandle> FileHandle(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Filename));
+	if (!FileHandle)
+	{
+		UE_LOG(ReflectionTool, Warning, TEXT("PPSDump: failed to map %s"), *Filename);
+		return nullptr;
+	}
+	const int64 FileSize = FileHandle->GetFileSize();
+	if (FileSize < static_cast<int64>(sizeof(FHeader)))
+		return nullptr;
+	TUniquePtr<IMappedFileRegion> Region(FileHandle->MapRegion(0, FileSize));
+	if (!Region)
+		return nullptr;
+
+	// 只检查文件头，节点在访问时按需检查
+	const uint8* Data = Region->GetMappedPtr();
+	FHeader Header;
+	FMemory::Memcpy(&Header, Data, sizeof(Header));
+	if (Header.Magic != Magic || Header.Version != FormatVersion || Header.RecordSize != sizeof(FNodeRecord)
+		|| Header.NumNodes <= 0 || Header.NodeTableOffset % 8 != 0 || Header.NodeTableOffset < static_cast<int64>(sizeof(FHeader))
+		|| Header.StringsOffset != Header.NodeTableOffset + static_cast<int64>(Header.NumNodes) * sizeof(FNodeRecord)
+		|| Header.StringsSize < 0 || Header.StringsOffset + Header.StringsSize > FileSize)
+	{
+		UE_LOG(ReflectionTool, Warning, TEXT("PPSDump: invalid header in %s"), *Filename);
+		return nullptr;
+	}
+
+	TSharedPtr<FReflectionPPSDump> Dump = MakeShareable(new FReflectionPPSDump());
+	Dump->Data = Data;
+	Dump->DataSize = FileSize;
+	Dump->Records = reinterpret_cast<const FNodeRecord*>(Data + Header.NodeTableOffset);
+	Dump->NumNodes = Header.NumNodes;
+	Dump->StringsOffset = Header.StringsOffset;
+	Dump->StringsSize = Header.StringsSize;
+	Dump->Region = MoveTemp(Region);
+	Dump->FileHandle = MoveTemp(FileHandle);
+	return Dump;
+}
+
+const FReflectionPPSDump::FNodeRecord* FReflectionPPSDump::GetRecord(int32 NodeIndex) const
+{
+	if (NodeIndex < 0 || NodeIndex >= NumNodes)
+		return nullptr;
+	const FNodeRecord* Record = Records + NodeIndex;
+	// 损坏的子节点范围视为没有子节点
+	if (Record->NumChildren < 0 || Record->FirstChild < 0 || static_cast<int64>(Record->FirstChild) + Record->NumChildren > NumNodes)
+		return nullptr;
+	return Record;
+}
+
+FString FReflectionPPSDump::GetString(int64 Offset, int32 Length) const
+{
+	if (Length <= 0 || Offset < 0 || Offset + Length > StringsSize)
+		return FString();
+	const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Data + StringsOffset + Offset), Length);
+	return FString(Converter.Length(), Converter.Get());
+}
+
+int32 FReflectionPPSDump::GetFirstChild(int32 NodeIndex) const
+{
+	const FNodeRecord* Record = GetRecord(NodeIndex);
+	return Record ? Record->FirstChild : 0;
+}
+
+int32 FReflectionPPSDump::GetNumChildren(int32 NodeIndex) const
+{
+	const FNodeRecord* Record = GetRecord(NodeIndex);
+	return Record ? Record->NumChildren : 0;
+}
+
+int32 FReflectionPPSDump::GetDepth(int32 NodeIndex) const
+{
+	const FNodeRecord* Record = GetRecord(NodeIndex);
+	return Record ? Record->Depth : 0;
+}
+
+bool FReflectionPPSDump::IsTruncated(int32 NodeIndex) const
+{
+	const FNodeRecord* Record = GetRecord(NodeIndex);
+	return Record && (Record->Flags & ReflectionPPSDump::NodeFlag_Truncated) != 0;
+}
+
+FString FReflectionPPSDump::GetName(int32 NodeIndex) const
+{
+	const FNodeRecord* Record = GetRecord(NodeIndex);
+	return Record ? GetString(Record->NameOffset, Record->NameLength) : FString();
+}
+
+FString FReflectionPPSDump::GetTypeName(int32 NodeIndex) const
+{
+	const FNodeRecord* Record = GetRecord(NodeIndex);
+	return Record ? GetString(Record->TypeOffset, Record->TypeLength) : FString();
+}
+
+FString FReflectionPPSDump::GetValue(int32 NodeIndex) const
+{
+	const FNodeRecord* Record = GetRecord(NodeIndex);
+	return Record ? GetString(Record->ValueOffset, Record->ValueLength) : FString();
+}
+
+void FReflectionPPSDump::ToPPS(int32 NodeIndex, FPropertyParserStruct& OutPPS) const
+{
+	const FNodeRecord* Record = GetRecord(NodeIndex);
+	if (!Record)
+		return;
+	OutPPS.Name = GetString(Record->NameOffset, Record->NameLength);
+	OutPPS.TypeName = GetString(Record->TypeOffset, Record->TypeLength);
+	OutPPS.Value = GetString(Record->ValueOffset, Record->ValueLength);
+	OutPPS.bHaveChild = (Record->Flags & ReflectionPPSDump::NodeFlag_HaveChild) != 0;
+	OutPPS.bTruncated = (Record->Flags & ReflectionPPSDump::NodeFlag_Truncated) != 0;
+	OutPPS.Children.SetNum(Record->NumChildren);
+	for (int32 Index = 0; Index < Record->NumChildren; ++Index)
+	{
+		// 子节点下标总是大于父节点，损坏的文件也不会无限递归
+		const int32 Child = Record->FirstChild + Index;
+		if (Child > NodeIndex)
+		{
+			ToPPS(Child, OutPPS.Children[Index]);
+		}
+	}
+}
+
+FReflectionPPSDumpWriter::FReflectionPPSDumpWriter(const FString& InFilename, const FString& RootName, const FString& RootTypeName)
+	: Filename(InFilename)
+	, NodesFilename(InFilename + TEXT(".nodes.tmp"))
+	, StringsFilename(InFilename + TEXT(".strings.tmp"))
+	, Strings(MakeUnique<ReflectionPPSDump::FStringWriter>())
+{
+	FMemory::Memzero(RootRecord);
+	FPropertyParserStruct Root;
+	Root.Name = RootName;
+	Root.TypeName = RootTypeName;
+	Root.bHaveChild = true;
+	FReflectionPPSDump::FillRecord(RootRecord, Root, *Strings);
+	RootRecord.Depth = -1;
+	RootRecord.FirstChild = 1;
+
+	NodesWriter.Reset(IFileManager::Get().CreateFileWriter(*NodesFilename));
+	StringsWriter.Reset(IFileManager::Get().CreateFileWriter(*StringsFilename));
+	if (!IsValid())
+	{
+		UE_LOG(ReflectionTool, Warning, TEXT("PPSDump: failed to create temporary files for %s"), *Filename);
+	}
+}
+
+FReflectionPPSDumpWriter::~FReflectionPPSDumpWriter()
+{
+	if (!bClosed)
+	{
+		DeleteTempFiles();
+	}
+}
+
+bool FReflectionPPSDumpWriter::IsValid() const
+{
+	return !bClosed && NodesWriter && StringsWriter && !NodesWriter->IsError() && !StringsWriter->IsError();
+}
+
+void FReflectionPPSDumpWriter::Add(const FPropertyParserStruct& Child)
+{
+	if (!IsValid())
+		return;
+	FReflectionPPSDump::FNodeRecord& Top = TopRecords.AddZeroed_GetRef();
+	FReflectionPPSDump::FillRecord(Top, Child, *Strings);
+	Top.FirstChild = static_cast<int32>(NumTempNodes);
+
+	TArray<FReflectionPPSDump::FNodeRecord> Records;
+	FReflectionPPSDump::FlattenChildren(Child, 0, NumTempNodes, *Strings, Records);
+	NodesWriter->Serialize(Records.GetData(), static_cast<int64>(Records.Num()) * sizeof(FReflectionPPSDump::FNodeRecord));
+	NumTempNodes += Records.Num();
+	if (Strings->Bytes.Num() >= ReflectionPPSDump::StringFlushSize)
+	{
+		Strings->Flush(*StringsWriter);
+	}
+}
+
+bool FReflectionPPSDumpWriter::Close()
+{
+	using FNodeRecord = FReflectionPPSDump::FNodeRecord;
+	if (!IsValid())
+	{
+		DeleteTempFiles();
+		bClosed = true;
+		return false;
+	}
+	Strings->Flush(*StringsWriter);
+	const bool bTempOk = NodesWriter->Close() && !NodesWriter->IsError() && StringsWriter->Close() && !StringsWriter->IsError();
+	NodesWriter.Reset();
+	StringsWriter.Reset();
+	bClosed = true;
+
+	// 文件中：0 为根，1..N 为各子树的根，临时文件中的节点整体后移 1 + N
+	const int64 Shift = 1 + TopRecords.Num();
+	if (!bTempOk || Shift + NumTempNodes > MAX_int32)
+	{
+		UE_LOG(ReflectionTool, Warning, TEXT("PPSDump: failed to write %s"), *Filename);
+		DeleteTempFiles();
+		return false;
+	}
+
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Filename));
+	TUniquePtr<FArchive> NodesReader(IFileManager::Get().CreateFileReader(*NodesFilename));
+	TUniquePtr<FArchive> StringsReader(IFileManager::Get().CreateFileReader(*StringsFilename));
+	if (!Writer || !NodesReader || !StringsReader)
+	{
+		UE_LOG(ReflectionTool, Warning, TEXT("PPSDump: failed to open %s"), *Filename);
+		NodesReader.Reset();
+		StringsReader.Reset();
+		DeleteTempFiles();
+		return false;
+	}
+
+	FReflectionPPSDump::WriteHeader(*Writer, static_cast<int32>(Shift + NumTempNodes), Strings->GetSize());
+	RootRecord.NumChildren = TopRecords.Num();
+	Writer->Serialize(&RootRecord, sizeof(FNodeRecord));
+	for (FNodeRecord& Top : TopRecords)
+	{
+		Top.FirstChild += static_cast<int32>(Shift);
+	}
+	Writer->Serialize(TopRecords.GetData(), static_cast<int64>(TopRecords.Num()) * sizeof(FNodeRecord));
+
+	// 临时节点分块读回并平移下标
+	TArray<FNodeRecord> Chunk;
+	for (int64 Copied = 0; Copied < NumTempNodes && !NodesReader->IsError() && !Writer->IsError();)
+	{
+		const int32 Count = static_cast<int32>(FMath::Min<int64>(NumTempNodes - Copied, 4096));
+		Chunk.SetNumUninitialized(Count, false);
+		NodesReader->Serialize(Chunk.GetData(), static_cast<int64>(Count) * sizeof(FNodeRecord));
+		for (FNodeRecord& Record : Chunk)
+		{
+			Record.FirstChild += static_cast<int32>(Shift);
+		}
+		Writer->Serialize(Chunk.GetData(), static_cast<int64>(Count) * sizeof(FNodeRecord));
+		Copied += Count;
+	}
+
+	// 字符串区原样拷贝
+	TArray<uint8> Buffer;
+	for (int64 Copied = 0; Copied < Strings->FlushedSize && !StringsReader->IsError() && !Writer->IsError();)
+	{
+		const int32 Count = static_cast<int32>(FMath::Min<int64>(Strings->FlushedSize - Copied, ReflectionPPSDump::StringFlushSize));
+		Buffer.SetNumUninitialized(Count, false);
+		StringsReader->Serialize(Buffer.GetData(), Count);
+		Writer->Serialize(Buffer.GetData(), Count);
+		Copied += Count;
+	}
+
+	const bool bOk = !NodesReader->IsError() && !StringsReader->IsError() && Writer->Close() && !Writer->IsError();
+	NodesReader.Reset();
+	StringsReader.Reset();
+	Writer.Reset();
+	DeleteTempFiles();
+	if (!bOk)
+	{
+		UE_LOG(ReflectionTool, Warning, TEXT("PPSDump: failed to write %s"), *Filename);
+		IFileManager::Get().Delete(*Filename);
+	}
+	return bOk;
+}
+
+void FReflectionPPSDumpWriter::DeleteTempFiles()
+{
+	NodesWriter.Reset();
+	StringsWriter.Reset();
+	IFileManager::Get().Delete(*NodesFilename);
+	IFileManager::Get().Delete(*StringsFilename);
+}
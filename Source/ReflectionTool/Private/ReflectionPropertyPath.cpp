@@ -0,0 +1,459 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#include "ReflectionPropertyPath.h"
+
+#include "ReflectionToolLib.h"
+#include "Containers/LruCache.h"
+#include "Misc/ScopeLock.h"
+#include <atomic>
+
+namespace ReflectionPropertyPath
+{
+	// 缓存 Key：(起点结构体, 路径)
+	using FCacheKey = TPair<const UStruct*, FString>;
+
+	// 带下标的路径可能由外部输入无限生成，缓存按 LRU 限制条目数
+	constexpr int32 MaxCachedPaths = 4096;
+
+	FCriticalSection CacheLock;
+	TLruCache<FCacheKey, TSharedPtr<const FReflectionPropertyPath>> Cache(MaxCachedPaths);
+	std::atomic<uint32> CacheGeneration{0};
+
+	// 按 '.' 拆分路径，方括号内的 '.' 不拆分
+	void SplitPath(const FString& Path, TArray<FString>& OutParts)
+	{
+		FString Current;
+		int32 BracketDepth = 0;
+		for (const TCHAR Char : Path)
+		{
+			if (Char == TEXT('[')) ++BracketDepth;
+			else if (Char == TEXT(']')) --BracketDepth;
+
+			if (Char == TEXT('.') && BracketDepth == 0)
+			{
+				OutParts.Add(MoveTemp(Current));
+				Current.Reset();
+				continue;
+			}
+			Current.AppendChar(Char);
+		}
+		OutParts.Add(MoveTemp(Current));
+	}
+
+	void ClassifyLeaf(FReflectionPropertyPath& Path)
+	{
+		using ELeafKind = FReflectionPropertyPath::ELeafKind;
+		const FProperty* Leaf = Path.LeafProperty;
+		if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Leaf))
+		{
+			Path.LeafKind = ELeafKind::Enum;
+			Path.LeafNumeric = EnumProperty->GetUnderlyingProperty();
+			Path.LeafEnum = EnumProperty->GetEnum();
+		}
+		else if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Leaf))
+		{
+			Path.LeafNumeric = NumericProperty;
+			if (const UEnum* EnumDef = NumericProperty->GetIntPropertyEnum())
+			{
+				Path.LeafKind = ELeafKind::Enum;
+				Path.LeafEnum = EnumDef;
+			}
+			else
+			{
+				Path.LeafKind = NumericProperty->IsFloatingPoint() ? ELeafKind::Float : ELeafKind::Integer;
+			}
+		}
+		else if (Leaf->IsA<FBoolProperty>())
+		{
+			Path.LeafKind = ELeafKind::Bool;
+		}
+		else if (Leaf->IsA<FStrProperty>())
+		{
+			Path.LeafKind = ELeafKind::String;
+		}
+		else if (Leaf->IsA<FNameProperty>())
+		{
+			Path.LeafKind = ELeafKind::Name;
+		}
+		else if (Leaf->IsA<FTextProperty>())
+		{
+			Path.LeafKind = ELeafKind::Text;
+		}
+	}
+
+	bool ImportMapKey(const FProperty* KeyProperty, void* KeyData, const FString& KeyString)
+	{
+		if (const FStrProperty* StrProperty = CastField<FStrProperty>(KeyProperty))
+		{
+			StrProperty->SetPropertyValue(KeyData, KeyString);
+			return true;
+		}
+		if (const FNameProperty* NameProperty = CastField<FNameProperty>(KeyProperty))
+		{
+			// 名称表中不存在的名称不可能是已有的键，不为其创建 FName
+			const FName Name(*KeyString, FNAME_Find);
+			if (Name.IsNone() && !KeyString.IsEmpty() && KeyString != TEXT("None"))
+				return false;
+			NameProperty->SetPropertyValue(KeyData, Name);
+			return true;
+		}
+		if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(KeyProperty))
+		{
+			const int64 EnumValue = EnumProperty->GetEnum()->GetValueByNameString(KeyString);
+			if (EnumValue == INDEX_NONE)
+				return false;
+			EnumProperty->GetUnderlyingProperty()->SetIntPropertyValue(KeyData, EnumValue);
+			return true;
+		}
+		return KeyProperty->ImportText_Direct(*KeyString, KeyData, nullptr, PPF_None) != nullptr;
+	}
+}
+
+FReflectionPropertyPath::FMapKey::FMapKey(const FProperty* InKeyProperty)
+	: KeyProperty(InKeyProperty)
+{
+	Data = static_cast<uint8*>(FMemory::Malloc(KeyProperty->ElementSize, KeyProperty->GetMinAlignment()));
+	KeyProperty->InitializeValue(Data);
+}
+
+FReflectionPropertyPath::FMapKey::~FMapKey()
+{
+	KeyProperty->DestroyValue(Data);
+	FMemory::Free(Data);
+}
+
+FProperty* FReflectionPropertyPath::FindPropertyByAuthoredName(const UStruct* Struct, const FString& Name)
+{
+	if (!Struct)
+		return nullptr;
+	// 只查找已有的 FName，路径可能来自外部输入，不应向名称表添加条目
+	if (FProperty* Property = Struct->FindPropertyByName(FName(*Name, FNAME_Find)))
+	{
+		return Property;
+	}
+	for (FProperty* Property = Struct->PropertyLink; Property; Property = Property->PropertyLinkNext)
+	{
+		if (Property->GetAuthoredName().Equals(Name, ESearchCase::IgnoreCase))
+		{
+			return Property;
+		}
+	}
+	return nullptr;
+}
+
+void* FReflectionPropertyPath::Resolve(void* Container) const
+{
+	uint8* Addr = static_cast<uint8*>(Container);
+	for (const FSegment& Segment : Segments)
+	{
+		if (!Addr)
+			return nullptr;
+		switch (Segment.Kind)
+		{
+		case ESegmentKind::Member:
+			Addr = Segment.Property->ContainerPtrToValuePtr<uint8>(Addr);
+			break;
+		case ESegmentKind::StaticArrayElement:
+			Addr = Segment.Property->ContainerPtrToValuePtr<uint8>(Addr, Segment.Index);
+			break;
+		case ESegmentKind::ArrayElement:
+			{
+				FScriptArrayHelper Helper(CastFieldChecked<FArrayProperty>(Segment.Property),
+					Segment.Property->ContainerPtrToValuePtr<uint8>(Addr));
+				Addr = Helper.IsValidIndex(Segment.Index) ? Helper.GetRawPtr(Segment.Index) : nullptr;
+			}
+			break;
+		case ESegmentKind::MapValue:
+			{
+				FScriptMapHelper Helper(CastFieldChecked<FMapProperty>(Segment.Property),
+					Segment.Property->ContainerPtrToValuePtr<uint8>(Addr));
+				Addr = Helper.FindValueFromHash(Segment.Key->Data);
+			}
+			break;
+		}
+	}
+	return Addr;
+}
+
+int32 FReflectionPropertyPath::GetFixedOffset() const
+{
+	int32 Offset = 0;
+	for (const FSegment& Segment : Segments)
+	{
+		switch (Segment.Kind)
+		{
+		case ESegmentKind::Member:
+			Offset += Segment.Property->GetOffset_ForInternal();
+			break;
+		case ESegmentKind::StaticArrayElement:
+			Offset += Segment.Property->GetOffset_ForInternal() + Segment.Property->ElementSize * Segment.Index;
+			break;
+		default:
+			return INDEX_NONE;
+		}
+	}
+	return Offset;
+}
+
+bool FReflectionPropertyPath::SetValueFromString(void* Container, const FString& Value) const
+{
+	void* Addr = ResolveLeaf(Container);
+	if (!Addr)
+		return false;
+	switch (LeafKind)
+	{
+	case ELeafKind::Bool:
+		static_cast<const FBoolProperty*>(LeafProperty)->SetPropertyValue(Addr, Value.Equals(TEXT("true"), ESearchCase::IgnoreCase));
+		return true;
+	case ELeafKind::Integer:
+		{
+			int64 Integer;
+			if (!LexTryParseString(Integer, *Value.TrimStartAndEnd()))
+				return false;
+			LeafNumeric->SetIntPropertyValue(Addr, Integer);
+			return true;
+		}
+	case ELeafKind::Float:
+		{
+			double Number;
+			if (!LexTryParseString(Number, *Value.TrimStartAndEnd()))
+				return false;
+			LeafNumeric->SetFloatingPointPropertyValue(Addr, Number);
+			return true;
+		}
+	case ELeafKind::Enum:
+		{
+			const int64 EnumValue = LeafEnum->GetValueByNameString(Value);
+			if (EnumValue == INDEX_NONE)
+				return false;
+			LeafNumeric->SetIntPropertyValue(Addr, EnumValue);
+			return true;
+		}
+	case ELeafKind::String:
+		*static_cast<FString*>(Addr) = Value;
+		return true;
+	case ELeafKind::Name:
+		*static_cast<FName*>(Addr) = FName(*Value);
+		return true;
+	case ELeafKind::Text:
+		*static_cast<FText*>(Addr) = FText::FromString(Value);
+		return true;
+	default:
+		if (const FObjectProperty* ObjectProperty = CastField<FObjectProperty>(LeafProperty))
+		{
+			// 对象按路径查找 / 加载，非空路径找不到对象时失败
+			FPropertyParserStruct PropertyParserStruct;
+			PropertyParserStruct.Value = Value;
+			UReflectionToolLib::ParserSinglePPSToProperty(LeafProperty, Addr, PropertyParserStruct);
+			return Value.IsEmpty() || Value == TEXT("None") || ObjectProperty->GetObjectPropertyValue(Addr) != nullptr;
+		}
+		return LeafProperty->ImportText_Direct(*Value, Addr, nullptr, PPF_None) != nullptr;
+	}
+}
+
+bool FReflectionPropertyPath::GetValueAsString(const void* Container, FString& OutValue) const
+{
+	const void* Addr = ResolveLeaf(Container);
+	if (!Addr)
+		return false;
+	switch (LeafKind)
+	{
+	case ELeafKind::Bool:
+		OutValue = static_cast<const FBoolProperty*>(LeafProperty)->GetPropertyValue(Addr) ? TEXT("true") : TEXT("false");
+		return true;
+	case ELeafKind::Integer:
+		OutValue = FString::Printf(TEXT("%lld"), LeafNumeric->GetSignedIntPropertyValue(Addr));
+		return true;
+	case ELeafKind::Float:
+		OutValue = FString::Printf(TEXT("%.15f"), LeafNumeric->GetFloatingPointPropertyValue(Addr));
+		return true;
+	case ELeafKind::Enum:
+		OutValue = LeafEnum->GetAuthoredNameStringByValue(LeafNumeric->GetSignedIntPropertyValue(Addr));
+		return true;
+	case ELeafKind::String:
+		OutValue = *static_cast<const FString*>(Addr);
+		return true;
+	case ELeafKind::Name:
+		OutValue = static_cast<const FName*>(Addr)->ToString();
+		return true;
+	case ELeafKind::Text:
+		OutValue = static_cast<const FText*>(Addr)->ToString();
+		return true;
+	default:
+		OutValue.Reset();
+		LeafProperty->ExportTextItem_Direct(OutValue, Addr, nullptr, nullptr, PPF_None);
+		return true;
+	}
+}
+
+bool FReflectionPropertyPath::GetNumber(const void* Container, double& OutValue) const
+{
+	const void* Addr = LeafNumeric ? ResolveLeaf(Container) : nullptr;
+	if (!Addr)
+		return false;
+	OutValue = LeafKind == ELeafKind::Float ? LeafNumeric->GetFloatingPointPropertyValue(Addr)
+		: static_cast<double>(LeafNumeric->GetSignedIntPropertyValue(Addr));
+	return true;
+}
+
+bool FReflectionPropertyPath::GetInteger(const void* Container, int64& OutValue) const
+{
+	const void* Addr = LeafNumeric ? ResolveLeaf(Container) : nullptr;
+	if (!Addr)
+		return false;
+	OutValue = LeafKind == ELeafKind::Float ? static_cast<int64>(LeafNumeric->GetFloatingPointPropertyValue(Addr))
+		: LeafNumeric->GetSignedIntPropertyValue(Addr);
+	return true;
+}
+
+bool FReflectionPropertyPath::SetNumber(void* Container, double Value) const
+{
+	if (LeafKind != ELeafKind::Float)
+		return SetInteger(Container, FMath::RoundToInt64(Value));
+	void* Addr = ResolveLeaf(Container);
+	if (!Addr)
+		return false;
+	LeafNumeric->SetFloatingPointPropertyValue(Addr, Value);
+	return true;
+}
+
+bool FReflectionPropertyPath::SetInteger(void* Container, int64 Value) const
+{
+	void* Addr = LeafNumeric ? ResolveLeaf(Container) : nullptr;
+	if (!Addr)
+		return false;
+	if (LeafKind == ELeafKind::Float)
+	{
+		LeafNumeric->SetFloatingPointPropertyValue(Addr, static_cast<double>(Value));
+	}
+	else
+	{
+		LeafNumeric->SetIntPropertyValue(Addr, Value);
+	}
+	return true;
+}
+
+TSharedPtr<const FReflectionPropertyPath> FReflectionPropertyPath::Compile(const UStruct* Struct, const FString& Path)
+{
+	if (!Struct || Path.IsEmpty())
+		return nullptr;
+
+	const ReflectionPropertyPath::FCacheKey Key(Struct, Path);
+	{
+		FScopeLock Lock(&ReflectionPropertyPath::CacheLock);
+		if (const TSharedPtr<const FReflectionPropertyPath>* Found = ReflectionPropertyPath::Cache.FindAndTouch(Key))
+		{
+			// 地址被新结构体复用时缓存失效
+			if (Found->IsValid() && (*Found)->OwnerStruct.Get() == Struct)
+			{
+				return *Found;
+			}
+		}
+	}
+
+	TSharedPtr<const FReflectionPropertyPath> Compiled = CompileUncached(Struct, Path);
+	if (!Compiled)
+	{
+		// 路径可能来自外部输入，失败由返回值告知调用方
+		UE_LOG(ReflectionTool, Verbose, TEXT("CompilePropertyPath failed: [%s] on [%s]"), *Path, *Struct->GetName());
+		return nullptr;
+	}
+
+	FScopeLock Lock(&ReflectionPropertyPath::CacheLock);
+	ReflectionPropertyPath::Cache.Add(Key, Compiled);
+	return Compiled;
+}
+
+void FReflectionPropertyPath::ClearCache()
+{
+	FScopeLock Lock(&ReflectionPropertyPath::CacheLock);
+	ReflectionPropertyPath::Cache.Empty(ReflectionPropertyPath::MaxCachedPaths);
+	ReflectionPropertyPath::CacheGeneration.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool FReflectionPropertyPath::IsValid() const
+{
+	return LeafProperty != nullptr && OwnerStruct.IsValid()
+		&& CacheGeneration == ReflectionPropertyPath::CacheGeneration.load(std::memory_order_relaxed);
+}
+
+TSharedPtr<FReflectionPropertyPath> FReflectionPropertyPath::CompileUncached(const UStruct* Struct, const FString& Path)
+{
+	TSharedPtr<FReflectionPropertyPath> Result = MakeShared<FReflectionPropertyPath>();
+	Result->OwnerStruct = Struct;
+	Result->PathString = Path;
+	Result->CacheGeneration = ReflectionPropertyPath::CacheGeneration.load(std::memory_order_relaxed);
+
+	TArray<FString> Parts;
+	ReflectionPropertyPath::SplitPath(Path, Parts);
+
+	const UStruct* CurrentStruct = Struct;
+	FProperty* CurrentProperty = nullptr;
+	for (const FString& Part : Parts)
+	{
+		// 上一段必须是结构体才能继续取成员
+		if (CurrentProperty)
+		{
+			const FStructProperty* StructProperty = CastField<FStructProperty>(CurrentProperty);
+			if (!StructProperty)
+				return nullptr;
+			CurrentStruct = StructProperty->Struct;
+		}
+
+		FString MemberName = Part;
+		FString IndexString;
+		int32 BracketIndex;
+		if (Part.FindChar(TEXT('['), BracketIndex))
+		{
+			if (!Part.EndsWith(TEXT("]")))
+				return nullptr;
+			MemberName = Part.Left(BracketIndex);
+			IndexString = Part.Mid(BracketIndex + 1, Part.Len() - BracketIndex - 2).TrimStartAndEnd();
+		}
+
+		FSegment Segment;
+		Segment.Property = FindPropertyByAuthoredName(CurrentStruct, MemberName.TrimStartAndEnd());
+		if (!Segment.Property)
+			return nullptr;
+		CurrentProperty = Segment.Property;
+
+		if (FMapProperty* MapProperty = CastField<FMapProperty>(Segment.Property); MapProperty && !IndexString.IsEmpty())
+		{
+			// Key 可以带引号："Attributes[\"Move Speed\"]"
+			if (IndexString.Len() >= 2 && IndexString.StartsWith(TEXT("\"")) && IndexString.EndsWith(TEXT("\"")))
+			{
+				IndexString = IndexString.Mid(1, IndexString.Len() - 2);
+			}
+			TSharedPtr<FMapKey> Key = MakeShared<FMapKey>(MapProperty->KeyProp);
+			if (!ReflectionPropertyPath::ImportMapKey(MapProperty->KeyProp, Key->Data, IndexString))
+				return nullptr;
+			Segment.Kind = ESegmentKind::MapValue;
+			Segment.Key = Key;
+			CurrentProperty = MapProperty->ValueProp;
+		}
+		else if (!IndexString.IsEmpty())
+		{
+			if (!IndexString.IsNumeric())
+				return nullptr;
+			Segment.Index = FCString::Atoi(*IndexString);
+			if (FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Segment.Property))
+			{
+				Segment.Kind = ESegmentKind::ArrayElement;
+				CurrentProperty = ArrayProperty->Inner;
+			}
+			else if (Segment.Property->ArrayDim > 1 && Segment.Index >= 0 && Segment.Index < Segment.Property->ArrayDim)
+			{
+				Segment.Kind = ESegmentKind::StaticArrayElement;
+			}
+			else
+			{
+				return nullptr;
+			}
+		}
+		Result->Segments.Add(Segment);
+	}
+
+	Result->LeafProperty = CurrentProperty;
+	ReflectionPropertyPath::ClassifyLeaf(*Result);
+	return Result;
+}
@@ -0,0 +1,235 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#include "ReflectionSnapshotStore.h"
+
+#include "ReflectionStructLayout.h"
+#include "ReflectionToolStats.h"
+#include "Algo/BinarySearch.h"
+#include "Misc/Compression.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "Serialization/StructuredArchive.h"
+
+namespace ReflectionSnapshotStore
+{
+	uint8* AllocateStruct(const UStruct* Struct)
+	{
+		uint8* Data = static_cast<uint8*>(FMemory::Malloc(FMath::Max(Struct->GetStructureSize(), 1), Struct->GetMinAlignment()));
+		Struct->InitializeStruct(Data);
+		return Data;
+	}
+
+	void FreeStruct(const UStruct* Struct, uint8* Data)
+	{
+		if (Data)
+		{
+			if (Struct)
+			{
+				Struct->DestroyStruct(Data);
+			}
+			FMemory::Free(Data);
+		}
+	}
+
+	FORCEINLINE void SerializeField(FArchive& Archive, const FProperty* Property, void* Addr)
+	{
+		FStructuredArchiveFromArchive StructuredArchive(Archive);
+		Property->SerializeItem(StructuredArchive.GetSlot(), Addr, nullptr);
+	}
+}
+
+FReflectionSnapshotStore::FReflectionSnapshotStore(const UStruct* InStruct, int32 InKeyframeInterval, FName InCompressionFormat)
+	: Struct(InStruct)
+	, Layout(FReflectionStructLayout::Get(InStruct))
+	, KeyframeInterval(FMath::Max(InKeyframeInterval, 1))
+	, CompressionFormat(InCompressionFormat)
+{
+	check(InStruct);
+	for (TFieldIterator<FProperty> It(InStruct); It; ++It)
+	{
+		for (int32 Index = 0; Index < It->ArrayDim; ++Index)
+		{
+			Fields.Add({*It, It->GetOffset_ForInternal() + Index * It->ElementSize});
+		}
+	}
+	LastData = ReflectionSnapshotStore::AllocateStruct(InStruct);
+	CachedData = ReflectionSnapshotStore::AllocateStruct(InStruct);
+}
+
+FReflectionSnapshotStore::~FReflectionSnapshotStore()
+{
+	ReflectionSnapshotStore::FreeStruct(Struct, LastData);
+	ReflectionSnapshotStore::FreeStruct(Struct, CachedData);
+}
+
+int32 FReflectionSnapshotStore::Add(const void* Data)
+{
+	REFLECTIONTOOL_SCOPE(SnapshotStore);
+	check(Data);
+	const int32 Index = Frames.Num();
+	FFrame& Frame = Frames.AddDefaulted_GetRef();
+	// 间隔按最近的关键帧计算，修改间隔后立即生效
+	Frame.bKeyframe = Keyframes.Num() == 0 || Index - Keyframes.Last() >= KeyframeInterval;
+	EncodeFrame(static_cast<const uint8*>(Data), Frame.bKeyframe ? nullptr : LastData, Frame);
+	if (Frame.bKeyframe)
+	{
+		Keyframes.Add(Index);
+	}
+	Layout->Copy(LastData, Data);
+	return Index;
+}
+
+bool FReflectionSnapshotStore::Get(int32 Index, void* OutData)
+{
+	REFLECTIONTOOL_SCOPE(SnapshotStore);
+	if (!Frames.IsValidIndex(Index) || !OutData)
+		return false;
+
+	// 最近的不晚于 Index 的关键帧
+	const int32 Keyframe = Keyframes[Algo::UpperBound(Keyframes, Index) - 1];
+	int32 Start = Keyframe;
+	if (CachedIndex != INDEX_NONE && CachedIndex >= Keyframe && CachedIndex <= Index)
+	{
+		// 上一次还原的结果在同一段内且不晚于 Index，从它继续
+		Start = CachedIndex + 1;
+	}
+	else
+	{
+		CachedIndex = INDEX_NONE;
+	}
+
+	for (int32 FrameIndex = Start; FrameIndex <= Index; ++FrameIndex)
+	{
+		if (!ApplyFrame(Frames[FrameIndex], CachedData))
+		{
+			UE_LOG(ReflectionTool, Warning, TEXT("SnapshotStore: failed to decode frame %d of %s"), FrameIndex, *Struct->GetName());
+			CachedIndex = INDEX_NONE;
+			return false;
+		}
+		CachedIndex = FrameIndex;
+	}
+	Layout->Copy(OutData, CachedData);
+	return true;
+}
+
+int64 FReflectionSnapshotStore::GetStoredSize() const
+{
+	int64 Size = 0;
+	for (const FFrame& Frame : Frames)
+	{
+		Size += Frame.Bytes.Num();
+	}
+	return Size;
+}
+
+int64 FReflectionSnapshotStore::GetRawSize() const
+{
+	int64 Size = 0;
+	for (const FFrame& Frame : Frames)
+	{
+		Size += Frame.RawSize;
+	}
+	return Size;
+}
+
+void FReflectionSnapshotStore::Reset()
+{
+	Frames.Reset();
+	Keyframes.Reset();
+	CachedIndex = INDEX_NONE;
+}
+
+void FReflectionSnapshotStore::EncodeFrame(const uint8* Data, const uint8* Base, FFrame& OutFrame) const
+{
+	TArray<uint8> RawBytes;
+	FMemoryWriter Writer(RawBytes);
+	FObjectAndNameAsStringProxyArchive Archive(Writer, false);
+
+	// 整体相同时跳过逐字段比较，差量只有一个 0
+	const bool bUnchanged = Base && Layout->Identical(Data, Base);
+	TArray<int32, TInlineAllocator<64>> Changed;
+	if (!bUnchanged)
+	{
+		for (int32 FieldIndex = 0; FieldIndex < Fields.Num(); ++FieldIndex)
+		{
+			const FField& Field = Fields[FieldIndex];
+			if (!Base || !Field.Property->Identical(Data + Field.Offset, Base + Field.Offset, PPF_None))
+			{
+				Changed.Add(FieldIndex);
+			}
+		}
+	}
+
+	int32 NumChanged = Changed.Num();
+	Archive << NumChanged;
+	for (int32 FieldIndex : Changed)
+	{
+		const FField& Field = Fields[FieldIndex];
+		Archive << FieldIndex;
+		ReflectionSnapshotStore::SerializeField(Archive, Field.Property, const_cast<uint8*>(Data) + Field.Offset);
+	}
+
+	OutFrame.RawSize = RawBytes.Num();
+	OutFrame.bCompressed = false;
+	if (!CompressionFormat.IsNone() && RawBytes.Num() > 0)
+	{
+		int32 CompressedSize = FCompression::CompressMemoryBound(CompressionFormat, RawBytes.Num());
+		OutFrame.Bytes.SetNumUninitialized(CompressedSize);
+		// 压缩后没有变小时保留原始数据
+		if (FCompression::CompressMemory(CompressionFormat, OutFrame.Bytes.GetData(), CompressedSize, RawBytes.GetData(), RawBytes.Num())
+			&& CompressedSize < RawBytes.Num())
+		{
+			OutFrame.Bytes.SetNum(CompressedSize);
+			OutFrame.bCompressed = true;
+			return;
+		}
+	}
+	OutFrame.Bytes = MoveTemp(RawBytes);
+}
+
+bool FReflectionSnapshotStore::ApplyFrame(const FFrame& Frame, uint8* Data) const
+{
+	TArray<uint8> RawBytes;
+	const TArray<uint8>* Bytes = &Frame.Bytes;
+	if (Frame.bCompressed)
+	{
+		RawBytes.SetNumUninitialized(Frame.RawSize);
+		if (!FCompression::UncompressMemory(CompressionFormat, RawBytes.GetData(), Frame.RawSize, Frame.Bytes.GetData(), Frame.Bytes.Num()))
+			return false;
+		Bytes = &RawBytes;
+	}
+
+	FMemoryReader Reader(*Bytes);
+	// 回放只查找已加载的对象，不在回放中阻塞加载资源
+	FObjectAndNameAsStringProxyArchive Archive(Reader, false);
+	int32 NumChanged = 0;
+	Archive << NumChanged;
+	if (NumChanged < 0 || NumChanged > Fields.Num())
+		return false;
+	for (int32 Index = 0; Index < NumChanged && !Archive.IsError(); ++Index)
+	{
+		int32 FieldIndex = INDEX_NONE;
+		Archive << FieldIndex;
+		if (!Fields.IsValidIndex(FieldIndex))
+			return false;
+		const FField& Field = Fields[FieldIndex];
+		ReflectionSnapshotStore::SerializeField(Archive, Field.Property, Data + Field.Offset);
+	}
+	return !Archive.IsError();
+}
+
+void FReflectionSnapshotStore::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	Collector.AddReferencedObject(Struct);
+	if (Struct)
+	{
+		Collector.AddPropertyReferences(Struct, LastData);
+		Collector.AddPropertyReferences(Struct, CachedData);
+	}
+}
+
+FString FReflectionSnapshotStore::GetReferencerName() const
+{
+	return TEXT("FReflectionSnapshotStore");
+}
@@ -0,0 +1,1396 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#include "ReflectionStructArchive.h"
+
+#include "ReflectionPropertyPath.h"
+#include "ReflectionStructLayout.h"
+#include "ReflectionToolLib.h"
+#include "ReflectionToolStats.h"
+#include "Hash/CityHash.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/SoftObjectPtr.h"
+
+namespace ReflectionStructArchive
+{
+	// 'RTSA'
+	constexpr uint32 Magic = 0x41535452;
+	constexpr uint32 FormatVersion = 1;
+
+	enum class EType : uint8
+	{
+		Bool,
+		Int8,
+		Int16,
+		Int32,
+		Int64,
+		UInt8,
+		UInt16,
+		UInt32,
+		UInt64,
+		Float,
+		Double,
+		// 底层数值见 FTypeDesc::Underlying，名称表见 FSchema::Enums
+		Enum,
+		Name,
+		String,
+		Text,
+		// 对象 / 软对象，按路径
+		Object,
+		Struct,
+		Array,
+		Set,
+		Map,
+		// 其余类型按 ExportText
+		Other,
+		Count,
+	};
+
+	// 定长块中的类型
+	FORCEINLINE bool IsPodType(EType Type)
+	{
+		return Type <= EType::Enum;
+	}
+
+	FORCEINLINE int32 GetPodSize(EType Type)
+	{
+		switch (Type)
+		{
+		case EType::Bool:
+		case EType::Int8:
+		case EType::UInt8: return 1;
+		case EType::Int16:
+		case EType::UInt16: return 2;
+		case EType::Int32:
+		case EType::UInt32:
+		case EType::Float: return 4;
+		default: return 8;
+		}
+	}
+
+	// 剩余的字节数；非定长流（压缩流等）TotalSize 为 -1，剩余字节数未知
+	FORCEINLINE int64 GetRemainingSize(FArchive& Ar)
+	{
+		const int64 TotalSize = Ar.TotalSize();
+		return TotalSize < 0 ? MAX_int64 : TotalSize - Ar.Tell();
+	}
+
+	struct FTypeDesc
+	{
+		EType Type = EType::Other;
+		// Enum 的底层数值类型
+		EType Underlying = EType::UInt8;
+		// Struct / Enum 在描述中的下标
+		int32 Index = INDEX_NONE;
+		// Array / Set 的元素类型、Map 的 Key 类型
+		int32 Inner = INDEX_NONE;
+		// Map 的 Value 类型
+		int32 Value = INDEX_NONE;
+
+		int32 GetPodSize() const { return ReflectionStructArchive::GetPodSize(Type == EType::Enum ? Underlying : Type); }
+	};
+
+	struct FFieldDesc
+	{
+		FString Name;
+		int32 TypeIndex = INDEX_NONE;
+		int32 ArrayDim = 1;
+		// 定长块中的偏移，非定长字段为 INDEX_NONE
+		int32 BlobOffset = INDEX_NONE;
+	};
+
+	struct FStructDesc
+	{
+		FString Name;
+		int32 BlobSize = 0;
+		TArray<FFieldDesc> Fields;
+	};
+
+	struct FEnumDesc
+	{
+		FString Name;
+		TArray<TPair<FString, int64>> Entries;
+	};
+
+	struct FSchema
+	{
+		TArray<FTypeDesc> Types;
+		// 0 为记录本身的结构体
+		TArray<FStructDesc> Structs;
+		TArray<FEnumDesc> Enums;
+		// 每种类型编码后至少占用的字节数，Validate 时计算，读取容器时据此限制元素个数
+		TArray<int64> MinEncodedSizes;
+
+		void Serialize(FArchive& Ar)
+		{
+			int32 NumTypes = Types.Num();
+			Ar << NumTypes;
+			if (Ar.IsLoading())
+			{
+				if (NumTypes < 0 || NumTypes > Ar.TotalSize())
+				{
+					Ar.SetError();
+					return;
+				}
+				Types.SetNum(NumTypes);
+			}
+			for (FTypeDesc& Desc : Types)
+			{
+				Ar << reinterpret_cast<uint8&>(Desc.Type) << reinterpret_cast<uint8&>(Desc.Underlying);
+				Ar << Desc.Index << Desc.Inner << Desc.Value;
+			}
+
+			int32 NumStructs = Structs.Num();
+			Ar << NumStructs;
+			if (Ar.IsLoading())
+			{
+				if (NumStructs <= 0 || NumStructs > Ar.TotalSize())
+				{
+					Ar.SetError();
+					return;
+				}
+				Structs.SetNum(NumStructs);
+			}
+			for (FStructDesc& Struct : Structs)
+			{
+				Ar << Struct.Name << Struct.BlobSize;
+				int32 NumFields = Struct.Fields.Num();
+				Ar << NumFields;
+				if (Ar.IsLoading())
+				{
+					if (NumFields < 0 || NumFields > Ar.TotalSize())
+					{
+						Ar.SetError();
+						return;
+					}
+					Struct.Fields.SetNum(NumFields);
+				}
+				for (FFieldDesc& Field : Struct.Fields)
+				{
+					Ar << Field.Name << Field.TypeIndex << Field.ArrayDim << Field.BlobOffset;
+				}
+			}
+
+			int32 NumEnums = Enums.Num();
+			Ar << NumEnums;
+			if (Ar.IsLoading())
+			{
+				if (NumEnums < 0 || NumEnums > Ar.TotalSize())
+				{
+					Ar.SetError();
+					return;
+				}
+				Enums.SetNum(NumEnums);
+			}
+			for (FEnumDesc& Enum : Enums)
+			{
+				Ar << Enum.Name;
+				int32 NumEntries = Enum.Entries.Num();
+				Ar << NumEntries;
+				if (Ar.IsLoading())
+				{
+					if (NumEntries < 0 || NumEntries > Ar.TotalSize())
+					{
+						Ar.SetError();
+						return;
+					}
+					Enum.Entries.SetNum(NumEntries);
+				}
+				for (TPair<FString, int64>& Entry : Enum.Entries)
+				{
+					Ar << Entry.Key << Entry.Value;
+				}
+			}
+		}
+
+		// 读取后检查下标与偏移，损坏的文件不会越界访问；MaxBlobSize 为描述之后剩余的字节数
+		bool Validate(int64 MaxBlobSize)
+		{
+			for (const FTypeDesc& Desc : Types)
+			{
+				if (Desc.Type >= EType::Count || (Desc.Type == EType::Enum && (!IsPodType(Desc.Underlying) || Desc.Underlying == EType::Enum)))
+					return false;
+				if (Desc.Type == EType::Struct && !Structs.IsValidIndex(Desc.Index))
+					return false;
+				if (Desc.Type == EType::Enum && !Enums.IsValidIndex(Desc.Index))
+					return false;
+				if ((Desc.Type == EType::Array || Desc.Type == EType::Set || Desc.Type == EType::Map) && !Types.IsValidIndex(Desc.Inner))
+					return false;
+				if (Desc.Type == EType::Map && !Types.IsValidIndex(Desc.Value))
+					return false;
+			}
+			for (const FStructDesc& Struct : Structs)
+			{
+				if (Struct.BlobSize < 0 || Struct.BlobSize > MaxBlobSize)
+					return false;
+				for (const FFieldDesc& Field : Struct.Fields)
+				{
+					if (!Types.IsValidIndex(Field.TypeIndex) || Field.ArrayDim <= 0)
+						return false;
+					const FTypeDesc& Desc = Types[Field.TypeIndex];
+					if (IsPodType(Desc.Type) != (Field.BlobOffset != INDEX_NONE))
+						return false;
+					if (Field.BlobOffset != INDEX_NONE
+						&& (Field.BlobOffset < 0 || Field.BlobOffset + static_cast<int64>(Desc.GetPodSize()) * Field.ArrayDim > Struct.BlobSize))
+						return false;
+				}
+			}
+
+			// 结构体直接（不经过容器）包含自身时无法编码，视为损坏
+			TArray<int64> StructSizes;
+			StructSizes.Init(INDEX_NONE, Structs.Num());
+			for (int32 StructIndex = 0; StructIndex < Structs.Num(); ++StructIndex)
+			{
+				if (ComputeStructMinSize(StructIndex, StructSizes) < 0)
+					return false;
+			}
+			MinEncodedSizes.SetNumUninitialized(Types.Num());
+			for (int32 TypeIndex = 0; TypeIndex < Types.Num(); ++TypeIndex)
+			{
+				const FTypeDesc& Desc = Types[TypeIndex];
+				MinEncodedSizes[TypeIndex] = Desc.Type == EType::Struct ? StructSizes[Desc.Index] : GetNonStructMinSize(Desc);
+			}
+			return true;
+		}
+
+		// 字符串、对象路径、ExportText 与容器都以 int32 长度开头
+		static int64 GetNonStructMinSize(const FTypeDesc& Desc)
+		{
+			return IsPodType(Desc.Type) ? Desc.GetPodSize() : sizeof(int32);
+		}
+
+		// 定长块加上非定长字段的最小长度，结构体直接包含自身时返回 -1
+		int64 ComputeStructMinSize(int32 StructIndex, TArray<int64>& StructSizes) const
+		{
+			constexpr int64 InProgress = -2;
+			if (StructSizes[StructIndex] == InProgress)
+				return -1;
+			if (StructSizes[StructIndex] >= 0)
+				return StructSizes[StructIndex];
+			StructSizes[StructIndex] = InProgress;
+
+			int64 Size = Structs[StructIndex].BlobSize;
+			for (const FFieldDesc& Field : Structs[StructIndex].Fields)
+			{
+				if (Field.BlobOffset != INDEX_NONE)
+					continue;
+				const FTypeDesc& Desc = Types[Field.TypeIndex];
+				const int64 FieldSize = Desc.Type == EType::Struct ? ComputeStructMinSize(Desc.Index, StructSizes) : GetNonStructMinSize(Desc);
+				if (FieldSize < 0)
+					return -1;
+				Size = FMath::Min<int64>(Size + FieldSize * Field.ArrayDim, MAX_int32);
+			}
+			StructSizes[StructIndex] = Size;
+			return Size;
+		}
+	};
+
+	// 数值属性与其枚举（FEnumProperty 取底层属性）
+	const FNumericProperty* GetNumeric(const FProperty* Property, const UEnum*& OutEnum)
+	{
+		OutEnum = nullptr;
+		if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+		{
+			OutEnum = EnumProperty->GetEnum();
+			return EnumProperty->GetUnderlyingProperty();
+		}
+		if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+		{
+			OutEnum = NumericProperty->GetIntPropertyEnum();
+			return NumericProperty;
+		}
+		return nullptr;
+	}
+
+	EType ClassifyNumeric(const FNumericProperty* Property)
+	{
+		if (Property->IsA<FInt8Property>()) return EType::Int8;
+		if (Property->IsA<FInt16Property>()) return EType::Int16;
+		if (Property->IsA<FIntProperty>()) return EType::Int32;
+		if (Property->IsA<FInt64Property>()) return EType::Int64;
+		if (Property->IsA<FByteProperty>()) return EType::UInt8;
+		if (Property->IsA<FUInt16Property>()) return EType::UInt16;
+		if (Property->IsA<FUInt32Property>()) return EType::UInt32;
+		if (Property->IsA<FUInt64Property>()) return EType::UInt64;
+		if (Property->IsA<FFloatProperty>()) return EType::Float;
+		if (Property->IsA<FDoubleProperty>()) return EType::Double;
+		return EType::Other;
+	}
+
+	EType Classify(const FProperty* Property, EType& OutUnderlying)
+	{
+		if (Property->IsA<FBoolProperty>()) return EType::Bool;
+		const UEnum* Enum = nullptr;
+		if (const FNumericProperty* NumericProperty = GetNumeric(Property, Enum))
+		{
+			const EType NumericType = ClassifyNumeric(NumericProperty);
+			if (Enum && NumericType != EType::Other && NumericType != EType::Float && NumericType != EType::Double)
+			{
+				OutUnderlying = NumericType;
+				return EType::Enum;
+			}
+			return NumericType;
+		}
+		if (Property->IsA<FNameProperty>()) return EType::Name;
+		if (Property->IsA<FStrProperty>()) return EType::String;
+		if (Property->IsA<FTextProperty>()) return EType::Text;
+		if (Property->IsA<FObjectPropertyBase>()) return EType::Object;
+		if (Property->IsA<FStructProperty>()) return EType::Struct;
+		if (Property->IsA<FArrayProperty>()) return EType::Array;
+		if (Property->IsA<FSetProperty>()) return EType::Set;
+		if (Property->IsA<FMapProperty>()) return EType::Map;
+		return EType::Other;
+	}
+
+	// 读取定长值，浮点返回 true 并写入 OutFloat，否则写入 OutInt
+	FORCEINLINE bool LoadNumber(EType Type, const uint8* Src, int64& OutInt, double& OutFloat)
+	{
+		switch (Type)
+		{
+		case EType::Bool: OutInt = *Src != 0; return false;
+		case EType::Int8: OutInt = *reinterpret_cast<const int8*>(Src); return false;
+		case EType::Int16: OutInt = *reinterpret_cast<const int16*>(Src); return false;
+		case EType::Int32: OutInt = *reinterpret_cast<const int32*>(Src); return false;
+		case EType::Int64: OutInt = *reinterpret_cast<const int64*>(Src); return false;
+		case EType::UInt8: OutInt = *Src; return false;
+		case EType::UInt16: OutInt = *reinterpret_cast<const uint16*>(Src); return false;
+		case EType::UInt32: OutInt = *reinterpret_cast<const uint32*>(Src); return false;
+		case EType::UInt64: OutInt = static_cast<int64>(*reinterpret_cast<const uint64*>(Src)); return false;
+		case EType::Float: OutFloat = *reinterpret_cast<const float*>(Src); return true;
+		default: OutFloat = *reinterpret_cast<const double*>(Src); return true;
+		}
+	}
+
+	// 不需要的数据读出后丢弃，不依赖 Seek（压缩流等不支持）
+	void SkipBytes(FArchive& Ar, int64 Size)
+	{
+		uint8 Scratch[256];
+		while (Size > 0 && !Ar.IsError())
+		{
+			const int64 Chunk = FMath::Min<int64>(Size, sizeof(Scratch));
+			Ar.Serialize(Scratch, Chunk);
+			Size -= Chunk;
+		}
+	}
+
+	FString ObjectToPath(const FObjectPropertyBase* Property, const void* Addr)
+	{
+		if (const FSoftObjectProperty* SoftProperty = CastField<FSoftObjectProperty>(Property))
+			return SoftProperty->GetPropertyValue(Addr).ToSoftObjectPath().ToString();
+		const UObject* Object = Property->GetObjectPropertyValue(Addr);
+		return Object ? Object->GetPathName() : FString();
+	}
+
+	void PathToObject(const FObjectPropertyBase* Property, void* Addr, const FString& Path)
+	{
+		if (const FSoftObjectProperty* SoftProperty = CastField<FSoftObjectProperty>(Property))
+		{
+			SoftProperty->SetPropertyValue(Addr, FSoftObjectPtr(FSoftObjectPath(Path)));
+			return;
+		}
+		// 只查找已加载的对象，读取记录时不做阻塞加载
+		UObject* Object = Path.IsEmpty() ? nullptr : FSoftObjectPath(Path).ResolveObject();
+		if (!Object && !Path.IsEmpty())
+		{
+			UE_LOG(ReflectionTool, Warning, TEXT("StructArchive: %s is not loaded, reference cleared"), *Path);
+		}
+		if (Object && !Object->IsA(Property->PropertyClass))
+		{
+			Object = nullptr;
+		}
+		Property->SetObjectPropertyValue(Addr, Object);
+	}
+
+#pragma region 写入
+
+	struct FStructEncodePlan
+	{
+		// 源地址中连续、定长块中也连续的一段
+		struct FBlobRun
+		{
+			int32 SrcOffset = 0;
+			int32 BlobOffset = 0;
+			int32 Size = 0;
+		};
+
+		struct FBitfield
+		{
+			const FBoolProperty* Property = nullptr;
+			int32 SrcOffset = 0;
+			int32 BlobOffset = 0;
+		};
+
+		struct FField
+		{
+			const FProperty* Property = nullptr;
+			int32 TypeIndex = INDEX_NONE;
+		};
+
+		int32 BlobSize = 0;
+		TArray<FBlobRun> Runs;
+		TArray<FBitfield> Bitfields;
+		TArray<FField> Fields;
+	};
+
+	struct FEncoder
+	{
+		FSchema Schema;
+		TArray<FStructEncodePlan> Plans;
+		TMap<const UStruct*, int32> StructIndices;
+		TMap<const UEnum*, int32> EnumIndices;
+
+		int32 AddEnum(const UEnum* Enum)
+		{
+			if (const int32* Found = EnumIndices.Find(Enum))
+				return *Found;
+			const int32 Index = Schema.Enums.AddDefaulted();
+			EnumIndices.Add(Enum, Index);
+			FEnumDesc& Desc = Schema.Enums[Index];
+			Desc.Name = Enum->GetName();
+			for (int32 EnumIndex = 0; EnumIndex < Enum->NumEnums(); ++EnumIndex)
+			{
+				Desc.Entries.Emplace(Enum->GetNameStringByIndex(EnumIndex), Enum->GetValueByIndex(EnumIndex));
+			}
+			return Index;
+		}
+
+		int32 AddType(const FProperty* Property)
+		{
+			FTypeDesc Desc;
+			Desc.Type = Classify(Property, Desc.Underlying);
+			switch (Desc.Type)
+			{
+			case EType::Enum:
+				{
+					const UEnum* Enum = nullptr;
+					GetNumeric(Property, Enum);
+					Desc.Index = AddEnum(Enum);
+				}
+				break;
+			case EType::Struct:
+				Desc.Index = AddStruct(CastFieldChecked<FStructProperty>(Property)->Struct);
+				break;
+			case EType::Array:
+				Desc.Inner = AddType(CastFieldChecked<FArrayProperty>(Property)->Inner);
+				break;
+			case EType::Set:
+				Desc.Inner = AddType(CastFieldChecked<FSetProperty>(Property)->ElementProp);
+				break;
+			case EType::Map:
+				Desc.Inner = AddType(CastFieldChecked<FMapProperty>(Property)->KeyProp);
+				Desc.Value = AddType(CastFieldChecked<FMapProperty>(Property)->ValueProp);
+				break;
+			default:
+				break;
+			}
+			return Schema.Types.Add(Desc);
+		}
+
+		// 定长字段的连续段取自布局拷贝序列中的 PodRun：同一段内、在源与定长块中都相邻的字段合并为一次 memcpy
+		static void BuildBlobRuns(const UStruct* Struct, TConstArrayView<FStructEncodePlan::FBlobRun> FieldRuns,
+			TArray<FStructEncodePlan::FBlobRun>& OutRuns)
+		{
+			using FOp = FReflectionStructLayout::FOp;
+			const TSharedPtr<const FReflectionStructLayout> Layout = FReflectionStructLayout::Get(Struct);
+			const TArray<FOp> EmptyOps;
+			const TArray<FOp>& Ops = Layout.IsValid() ? Layout->GetCopyOps() : EmptyOps;
+			int32 LastOpIndex = INDEX_NONE;
+			for (const FStructEncodePlan::FBlobRun& FieldRun : FieldRuns)
+			{
+				const int32 OpIndex = Ops.IndexOfByPredicate([&FieldRun](const FOp& Op)
+				{
+					return Op.Kind == FReflectionStructLayout::EOpKind::PodRun
+						&& Op.Offset <= FieldRun.SrcOffset && FieldRun.SrcOffset + FieldRun.Size <= Op.Offset + Op.Size;
+				});
+				FStructEncodePlan::FBlobRun* Last = OutRuns.Num() > 0 ? &OutRuns.Last() : nullptr;
+				if (Last && OpIndex != INDEX_NONE && OpIndex == LastOpIndex
+					&& Last->SrcOffset + Last->Size == FieldRun.SrcOffset && Last->BlobOffset + Last->Size == FieldRun.BlobOffset)
+				{
+					Last->Size += FieldRun.Size;
+				}
+				else
+				{
+					OutRuns.Add(FieldRun);
+				}
+				LastOpIndex = OpIndex;
+			}
+		}
+
+		int32 AddStruct(const UStruct* Struct)
+		{
+			if (const int32* Found = StructIndices.Find(Struct))
+				return *Found;
+			const int32 StructIndex = Schema.Structs.AddDefaulted();
+			Plans.AddDefaulted();
+			StructIndices.Add(Struct, StructIndex);
+			Schema.Structs[StructIndex].Name = Struct->GetPathName();
+
+			int32 BlobSize = 0;
+			TArray<FStructEncodePlan::FBlobRun> FieldRuns;
+			for (TFieldIterator<FProperty> It(Struct); It; ++It)
+			{
+				const FProperty* Property = *It;
+				FFieldDesc Field;
+				Field.Name = Property->GetAuthoredName();
+				// 递归添加类型时 Structs / Plans 可能重新分配，之后再通过下标访问
+				Field.TypeIndex = AddType(Property);
+				Field.ArrayDim = Property->ArrayDim;
+
+				FStructEncodePlan& Plan = Plans[StructIndex];
+				const FTypeDesc& Desc = Schema.Types[Field.TypeIndex];
+				if (IsPodType(Desc.Type))
+				{
+					Field.BlobOffset = BlobSize;
+					const int32 PodSize = Desc.GetPodSize();
+					const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property);
+					if (BoolProperty && !BoolProperty->IsNativeBool())
+					{
+						FStructEncodePlan::FBitfield& Bitfield = Plan.Bitfields.AddDefaulted_GetRef();
+						Bitfield.Property = BoolProperty;
+						Bitfield.SrcOffset = Property->GetOffset_ForInternal();
+						Bitfield.BlobOffset = BlobSize;
+					}
+					else
+					{
+						FieldRuns.Add({Property->GetOffset_ForInternal(), BlobSize, PodSize * Field.ArrayDim});
+					}
+					BlobSize += PodSize * Field.ArrayDim;
+				}
+				else
+				{
+					Plan.Fields.Add({Property, Field.TypeIndex});
+				}
+				Schema.Structs[StructIndex].Fields.Add(MoveTemp(Field));
+			}
+			Schema.Structs[StructIndex].BlobSize = BlobSize;
+			Plans[StructIndex].BlobSize = BlobSize;
+			BuildBlobRuns(Struct, FieldRuns, Plans[StructIndex].Runs);
+			return StructIndex;
+		}
+
+		void EncodeStruct(FArchive& Ar, int32 StructIndex, const uint8* Data) const
+		{
+			const FStructEncodePlan& Plan = Plans[StructIndex];
+			TArray<uint8, TInlineAllocator<256>> Blob;
+			Blob.SetNumUninitialized(Plan.BlobSize);
+			for (const FStructEncodePlan::FBlobRun& Run : Plan.Runs)
+			{
+				FMemory::Memcpy(Blob.GetData() + Run.BlobOffset, Data + Run.SrcOffset, Run.Size);
+			}
+			for (const FStructEncodePlan::FBitfield& Bitfield : Plan.Bitfields)
+			{
+				Blob[Bitfield.BlobOffset] = Bitfield.Property->GetPropertyValue(Data + Bitfield.SrcOffset) ? 1 : 0;
+			}
+			Ar.Serialize(Blob.GetData(), Plan.BlobSize);
+
+			for (const FStructEncodePlan::FField& Field : Plan.Fields)
+			{
+				const uint8* Addr = Data + Field.Property->GetOffset_ForInternal();
+				for (int32 Index = 0; Index < Field.Property->ArrayDim; ++Index)
+				{
+					EncodeValue(Ar, Field.TypeIndex, Field.Property, Addr + Index * Field.Property->ElementSize);
+				}
+			}
+		}
+
+		void EncodePod(FArchive& Ar, const FTypeDesc& Desc, const FProperty* Property, const void* Addr) const
+		{
+			if (Desc.Type == EType::Bool)
+			{
+				uint8 Value = static_cast<const FBoolProperty*>(Property)->GetPropertyValue(Addr) ? 1 : 0;
+				Ar << Value;
+				return;
+			}
+			Ar.Serialize(const_cast<void*>(Addr), Desc.GetPodSize());
+		}
+
+		void EncodeValue(FArchive& Ar, int32 TypeIndex, const FProperty* Property, const void* Addr) const
+		{
+			const FTypeDesc& Desc = Schema.Types[TypeIndex];
+			if (IsPodType(Desc.Type))
+			{
+				EncodePod(Ar, Desc, Property, Addr);
+				return;
+			}
+
+			switch (Desc.Type)
+			{
+			case EType::Name:
+				{
+					FString Value = static_cast<const FName*>(Addr)->ToString();
+					Ar << Value;
+				}
+				break;
+			case EType::String:
+				Ar << *static_cast<FString*>(const_cast<void*>(Addr));
+				break;
+			case EType::Text:
+				{
+					FString Value = static_cast<const FText*>(Addr)->ToString();
+					Ar << Value;
+				}
+				break;
+			case EType::Object:
+				{
+					FString Value = ObjectToPath(static_cast<const FObjectPropertyBase*>(Property), Addr);
+					Ar << Value;
+				}
+				break;
+			case EType::Struct:
+				EncodeStruct(Ar, Desc.Index, static_cast<const uint8*>(Addr));
+				break;
+			case EType::Array:
+				{
+					const FArrayProperty* ArrayProperty = static_cast<const FArrayProperty*>(Property);
+					FScriptArrayHelper Helper(ArrayProperty, Addr);
+					int32 Num = Helper.Num();
+					Ar << Num;
+					const FTypeDesc& InnerDesc = Schema.Types[Desc.Inner];
+					if (IsPodType(InnerDesc.Type) && InnerDesc.Type != EType::Bool && Num > 0)
+					{
+						// 定长元素整段写入
+						Ar.Serialize(Helper.GetRawPtr(0), static_cast<int64>(Num) * InnerDesc.GetPodSize());
+						break;
+					}
+					for (int32 Index = 0; Index < Num; ++Index)
+					{
+						EncodeValue(Ar, Desc.Inner, ArrayProperty->Inner, Helper.GetRawPtr(Index));
+					}
+				}
+				break;
+			case EType::Set:
+				{
+					const FSetProperty* SetProperty = static_cast<const FSetProperty*>(Property);
+					FScriptSetHelper Helper(SetProperty, Addr);
+					int32 Num = Helper.Num();
+					Ar << Num;
+					for (int32 Index = 0, Remaining = Num; Remaining > 0; ++Index)
+					{
+						if (Helper.IsValidIndex(Index))
+						{
+							EncodeValue(Ar, Desc.Inner, SetProperty->ElementProp, Helper.GetElementPtr(Index));
+							--Remaining;
+						}
+					}
+				}
+				break;
+			case EType::Map:
+				{
+					const FMapProperty* MapProperty = static_cast<const FMapProperty*>(Property);
+					FScriptMapHelper Helper(MapProperty, Addr);
+					int32 Num = Helper.Num();
+					Ar << Num;
+					for (int32 Index = 0, Remaining = Num; Remaining > 0; ++Index)
+					{
+						if (Helper.IsValidIndex(Index))
+						{
+							EncodeValue(Ar, Desc.Inner, MapProperty->KeyProp, Helper.GetKeyPtr(Index));
+							EncodeValue(Ar, Desc.Value, MapProperty->ValueProp, Helper.GetValuePtr(Index));
+							--Remaining;
+						}
+					}
+				}
+				break;
+			default:
+				{
+					FString Value;
+					Property->ExportTextItem_Direct(Value, Addr, nullptr, nullptr, PPF_None);
+					Ar << Value;
+				}
+				break;
+			}
+		}
+	};
+
+#pragma endregion
+
+#pragma region 读取
+
+	enum class EDecodeKind : uint8
+	{
+		// 同类型定长值
+		Memcpy,
+		Bool,
+		Numeric,
+		// 枚举按名称重映射
+		Enum,
+		Name,
+		String,
+		Text,
+		Object,
+		Struct,
+		Array,
+		Set,
+		Map,
+		// 按 ImportText 写入
+		Import,
+	};
+
+	struct FStructDecodePlan;
+
+	// 文件中的一种类型 -> 当前的一个属性
+	struct FValueDecoder
+	{
+		EDecodeKind Kind = EDecodeKind::Memcpy;
+		const FProperty* Property = nullptr;
+		// Memcpy 的字节数
+		int32 Size = 0;
+		// Numeric / Enum：文件中的数值类型与当前数值属性
+		EType StoredType = EType::Int32;
+		const FNumericProperty* Numeric = nullptr;
+		TMap<int64, int64> EnumValues;
+		// 由 FDecodePlanSet::StructPlans 持有，结构体引用自身时不形成环
+		const FStructDecodePlan* StructPlan = nullptr;
+		// Array / Set 的元素、Map 的 Key
+		TSharedPtr<FValueDecoder> Inner;
+		// Map 的 Value
+		TSharedPtr<FValueDecoder> Value;
+	};
+
+	// 不同的存储值读出后一定不同，作为 Set 元素 / Map Key 时无需去重
+	bool IsInjective(const FValueDecoder& Decoder)
+	{
+		return Decoder.Kind == EDecodeKind::Memcpy || Decoder.Kind == EDecodeKind::String;
+	}
+
+	// 容器元素的临时值，按属性初始化与销毁
+	struct FScopedValue
+	{
+		const FProperty* Property;
+		void* Data;
+
+		FScopedValue(const FProperty* InProperty, void* InData)
+			: Property(InProperty)
+			, Data(InData)
+		{
+			Property->InitializeValue(Data);
+		}
+
+		~FScopedValue()
+		{
+			Property->DestroyValue(Data);
+		}
+	};
+
+	struct FStructDecodePlan
+	{
+		struct FBlobCopy
+		{
+			int32 BlobOffset = 0;
+			int32 DstOffset = 0;
+			int32 Size = 0;
+		};
+
+		struct FBlobConvert
+		{
+			int32 BlobOffset = 0;
+			int32 StoredSize = 0;
+			int32 DstOffset = 0;
+			int32 DstStride = 0;
+			int32 Count = 0;
+			TSharedPtr<FValueDecoder> Decoder;
+		};
+
+		// 文件中的非定长字段，按顺序读取
+		struct FField
+		{
+			int32 TypeIndex = INDEX_NONE;
+			int32 StoredCount = 1;
+			// 为空时读取后丢弃
+			TSharedPtr<FValueDecoder> Decoder;
+			int32 DstOffset = 0;
+			int32 DstStride = 0;
+			int32 DstCount = 0;
+		};
+
+		int32 StructIndex = INDEX_NONE;
+		int32 BlobSize = 0;
+		TArray<FBlobCopy> Copies;
+		TArray<FBlobConvert> Converts;
+		TArray<FField> Fields;
+	};
+
+	struct FDecodePlanSet
+	{
+		FSchema Schema;
+		TSharedPtr<FStructDecodePlan> RootPlan;
+		// 构建时使用：(文件中的结构体下标, 当前结构体) -> 计划
+		TMap<TPair<int32, const UStruct*>, TSharedPtr<FStructDecodePlan>> StructPlans;
+		TWeakObjectPtr<const UStruct> RootStruct;
+
+		TSharedPtr<FStructDecodePlan> GetStructPlan(int32 StructIndex, const UStruct* Struct)
+		{
+			const TPair<int32, const UStruct*> Key(StructIndex, Struct);
+			if (const TSharedPtr<FStructDecodePlan>* Found = StructPlans.Find(Key))
+				return *Found;
+
+			// 先登记再构建，结构体通过容器引用自身时直接返回
+			TSharedPtr<FStructDecodePlan> Plan = MakeShared<FStructDecodePlan>();
+			StructPlans.Add(Key, Plan);
+			const FStructDesc& Desc = Schema.Structs[StructIndex];
+			Plan->StructIndex = StructIndex;
+			Plan->BlobSize = Desc.BlobSize;
+
+			for (const FFieldDesc& Field : Desc.Fields)
+			{
+				const FProperty* Property = FReflectionPropertyPath::FindPropertyByAuthoredName(Struct, Field.Name);
+				TSharedPtr<FValueDecoder> Decoder = Property ? MakeDecoder(Field.TypeIndex, Property) : nullptr;
+				const int32 DstCount = Decoder.IsValid() ? FMath::Min(Field.ArrayDim, Property->ArrayDim) : 0;
+
+				if (Field.BlobOffset != INDEX_NONE)
+				{
+					if (!Decoder.IsValid())
+						continue;
+					const int32 DstOffset = Property->GetOffset_ForInternal();
+					if (Decoder->Kind == EDecodeKind::Memcpy)
+					{
+						const int32 Size = Decoder->Size * DstCount;
+						FStructDecodePlan::FBlobCopy* Last = Plan->Copies.Num() > 0 ? &Plan->Copies.Last() : nullptr;
+						if (Last && Last->BlobOffset + Last->Size == Field.BlobOffset && Last->DstOffset + Last->Size == DstOffset)
+						{
+							Last->Size += Size;
+						}
+						else
+						{
+							Plan->Copies.Add({Field.BlobOffset, DstOffset, Size});
+						}
+						continue;
+					}
+					FStructDecodePlan::FBlobConvert& Convert = Plan->Converts.AddDefaulted_GetRef();
+					Convert.BlobOffset = Field.BlobOffset;
+					Convert.StoredSize = Schema.Types[Field.TypeIndex].GetPodSize();
+					Convert.DstOffset = DstOffset;
+					Convert.DstStride = Property->ElementSize;
+					Convert.Count = DstCount;
+					Convert.Decoder = MoveTemp(Decoder);
+					continue;
+				}
+
+				FStructDecodePlan::FField& PlanField = Plan->Fields.AddDefaulted_GetRef();
+				PlanField.TypeIndex = Field.TypeIndex;
+				PlanField.StoredCount = Field.ArrayDim;
+				if (Decoder.IsValid())
+				{
+					PlanField.DstOffset = Property->GetOffset_ForInternal();
+					PlanField.DstStride = Property->ElementSize;
+					PlanField.DstCount = DstCount;
+					PlanField.Decoder = MoveTemp(Decoder);
+				}
+			}
+			return Plan;
+		}
+
+		TSharedPtr<FValueDecoder> MakeDecoder(int32 TypeIndex, const FProperty* Property)
+		{
+			const FTypeDesc& Desc = Schema.Types[TypeIndex];
+			TSharedPtr<FValueDecoder> Decoder = MakeShared<FValueDecoder>();
+			Decoder->Property = Property;
+
+			if (IsPodType(Desc.Type))
+			{
+				const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property);
+				if (BoolProperty)
+				{
+					if (Desc.Type != EType::Bool)
+						return nullptr;
+					// 文件中的 bool 为 0 / 1 的单字节
+					Decoder->Kind = BoolProperty->IsNativeBool() ? EDecodeKind::Memcpy : EDecodeKind::Bool;
+					Decoder->Size = 1;
+					return Decoder;
+				}
+
+				const UEnum* Enum = nullptr;
+				Decoder->Numeric = GetNumeric(Property, Enum);
+				if (!Decoder->Numeric)
+					return nullptr;
+				Decoder->StoredType = Desc.Type == EType::Enum ? Desc.Underlying : Desc.Type;
+
+				if (Desc.Type == EType::Enum && Enum)
+				{
+					Decoder->Kind = EDecodeKind::Enum;
+					for (const TPair<FString, int64>& Entry : Schema.Enums[Desc.Index].Entries)
+					{
+						const int64 Value = Enum->GetValueByNameString(Entry.Key);
+						if (Value != INDEX_NONE)
+						{
+							Decoder->EnumValues.Add(Entry.Value, Value);
+						}
+					}
+					return Decoder;
+				}
+				const bool bSameType = ClassifyNumeric(Decoder->Numeric) == Decoder->StoredType;
+				Decoder->Kind = bSameType ? EDecodeKind::Memcpy : EDecodeKind::Numeric;
+				Decoder->Size = Property->ElementSize;
+				return Decoder;
+			}
+
+			switch (Desc.Type)
+			{
+			case EType::Name:
+			case EType::String:
+			case EType::Text:
+				if (Property->IsA<FNameProperty>()) Decoder->Kind = EDecodeKind::Name;
+				else if (Property->IsA<FStrProperty>()) Decoder->Kind = EDecodeKind::String;
+				else if (Property->IsA<FTextProperty>()) Decoder->Kind = EDecodeKind::Text;
+				else return nullptr;
+				return Decoder;
+			case EType::Object:
+				if (!Property->IsA<FObjectPropertyBase>())
+					return nullptr;
+				Decoder->Kind = EDecodeKind::Object;
+				return Decoder;
+			case EType::Struct:
+				if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+				{
+					Decoder->Kind = EDecodeKind::Struct;
+					Decoder->StructPlan = GetStructPlan(Desc.Index, StructProperty->Struct).Get();
+					return Decoder;
+				}
+				return nullptr;
+			case EType::Array:
+				if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+				{
+					Decoder->Kind = EDecodeKind::Array;
+					Decoder->Inner = MakeDecoder(Desc.Inner, ArrayProperty->Inner);
+					return Decoder->Inner.IsValid() ? Decoder : nullptr;
+				}
+				return nullptr;
+			case EType::Set:
+				if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+				{
+					Decoder->Kind = EDecodeKind::Set;
+					Decoder->Inner = MakeDecoder(Desc.Inner, SetProperty->ElementProp);
+					return Decoder->Inner.IsValid() ? Decoder : nullptr;
+				}
+				return nullptr;
+			case EType::Map:
+				if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+				{
+					Decoder->Kind = EDecodeKind::Map;
+					Decoder->Inner = MakeDecoder(Desc.Inner, MapProperty->KeyProp);
+					Decoder->Value = MakeDecoder(Desc.Value, MapProperty->ValueProp);
+					return Decoder->Inner.IsValid() && Decoder->Value.IsValid() ? Decoder : nullptr;
+				}
+				return nullptr;
+			default:
+				Decoder->Kind = EDecodeKind::Import;
+				return Decoder;
+			}
+		}
+
+		// 非定长流一次最多预留的元素个数，之后随读取增长
+		static constexpr int32 MaxUncheckedReserve = 4096;
+
+		// 剩余字节数不足以容纳 Num 个元素时视为损坏，返回可以预先分配的元素个数
+		static int32 CheckCount(FArchive& Ar, int32 Num, int64 MinElementSize)
+		{
+			const int64 Remaining = GetRemainingSize(Ar);
+			if (Num < 0 || Num > Remaining / FMath::Max<int64>(MinElementSize, 1))
+			{
+				Ar.SetError();
+				return INDEX_NONE;
+			}
+			return Remaining == MAX_int64 ? FMath::Min(Num, MaxUncheckedReserve) : Num;
+		}
+
+		// 定长值写入当前属性
+		static void DecodePod(const uint8* Src, const FValueDecoder& Decoder, void* Dst)
+		{
+			switch (Decoder.Kind)
+			{
+			case EDecodeKind::Memcpy:
+				FMemory::Memcpy(Dst, Src, Decoder.Size);
+				break;
+			case EDecodeKind::Bool:
+				static_cast<const FBoolProperty*>(Decoder.Property)->SetPropertyValue(Dst, *Src != 0);
+				break;
+			case EDecodeKind::Enum:
+				{
+					int64 Value = 0;
+					double Unused = 0.0;
+					LoadNumber(Decoder.StoredType, Src, Value, Unused);
+					// 当前枚举中没有同名项的值不写入
+					if (const int64* Found = Decoder.EnumValues.Find(Value))
+					{
+						Decoder.Numeric->SetIntPropertyValue(Dst, *Found);
+					}
+				}
+				break;
+			default:
+				{
+					int64 IntValue = 0;
+					double FloatValue = 0.0;
+					if (LoadNumber(Decoder.StoredType, Src, IntValue, FloatValue))
+					{
+						if (Decoder.Numeric->IsFloatingPoint())
+							Decoder.Numeric->SetFloatingPointPropertyValue(Dst, FloatValue);
+						else
+							Decoder.Numeric->SetIntPropertyValue(Dst, FMath::RoundToInt64(FloatValue));
+					}
+					else
+					{
+						if (Decoder.Numeric->IsFloatingPoint())
+							Decoder.Numeric->SetFloatingPointPropertyValue(Dst, static_cast<double>(IntValue));
+						else
+							Decoder.Numeric->SetIntPropertyValue(Dst, IntValue);
+					}
+				}
+				break;
+			}
+		}
+
+		void DecodeStruct(FArchive& Ar, int32 StructIndex, const FStructDecodePlan* Plan, uint8* Data) const
+		{
+			const FStructDesc& Desc = Schema.Structs[StructIndex];
+			// 计划按描述哈希缓存，同一描述的截断文件也要在分配前检查
+			if (Desc.BlobSize > GetRemainingSize(Ar))
+			{
+				Ar.SetError();
+				return;
+			}
+			TArray<uint8, TInlineAllocator<256>> Blob;
+			Blob.SetNumUninitialized(Desc.BlobSize);
+			Ar.Serialize(Blob.GetData(), Desc.BlobSize);
+			if (Ar.IsError())
+				return;
+
+			if (Plan)
+			{
+				for (const FStructDecodePlan::FBlobCopy& Copy : Plan->Copies)
+				{
+					FMemory::Memcpy(Data + Copy.DstOffset, Blob.GetData() + Copy.BlobOffset, Copy.Size);
+				}
+				for (const FStructDecodePlan::FBlobConvert& Convert : Plan->Converts)
+				{
+					for (int32 Index = 0; Index < Convert.Count; ++Index)
+					{
+						DecodePod(Blob.GetData() + Convert.BlobOffset + Index * Convert.StoredSize, *Convert.Decoder,
+							Data + Convert.DstOffset + Index * Convert.DstStride);
+					}
+				}
+				for (const FStructDecodePlan::FField& Field : Plan->Fields)
+				{
+					for (int32 Index = 0; Index < Field.StoredCount; ++Index)
+					{
+						const bool bKeep = Index < Field.DstCount;
+						DecodeValue(Ar, Field.TypeIndex, bKeep ? Field.Decoder.Get() : nullptr,
+							bKeep ? Data + Field.DstOffset + Index * Field.DstStride : nullptr);
+					}
+				}
+				return;
+			}
+
+			// 没有对应的结构体，读取后丢弃
+			for (const FFieldDesc& Field : Desc.Fields)
+			{
+				if (Field.BlobOffset != INDEX_NONE)
+					continue;
+				for (int32 Index = 0; Index < Field.ArrayDim; ++Index)
+				{
+					DecodeValue(Ar, Field.TypeIndex, nullptr, nullptr);
+				}
+			}
+		}
+
+		// Decoder 为空时只读取不写入
+		void DecodeValue(FArchive& Ar, int32 TypeIndex, const FValueDecoder* Decoder, void* Dst) const
+		{
+			if (Ar.IsError())
+				return;
+			const FTypeDesc& Desc = Schema.Types[TypeIndex];
+			if (IsPodType(Desc.Type))
+			{
+				uint8 Buffer[8];
+				Ar.Serialize(Buffer, Desc.GetPodSize());
+				if (Decoder && !Ar.IsError())
+				{
+					DecodePod(Buffer, *Decoder, Dst);
+				}
+				return;
+			}
+
+			switch (Desc.Type)
+			{
+			case EType::Name:
+			case EType::String:
+			case EType::Text:
+			case EType::Object:
+			case EType::Other:
+				{
+					FString Value;
+					Ar << Value;
+					if (!Decoder || Ar.IsError())
+						break;
+					switch (Decoder->Kind)
+					{
+					case EDecodeKind::Name: *static_cast<FName*>(Dst) = FName(*Value); break;
+					case EDecodeKind::String: *static_cast<FString*>(Dst) = MoveTemp(Value); break;
+					case EDecodeKind::Text: *static_cast<FText*>(Dst) = FText::FromString(MoveTemp(Value)); break;
+					case EDecodeKind::Object: PathToObject(static_cast<const FObjectPropertyBase*>(Decoder->Property), Dst, Value); break;
+					default: Decoder->Property->ImportText_Direct(*Value, Dst, nullptr, PPF_None); break;
+					}
+				}
+				break;
+			case EType::Struct:
+				DecodeStruct(Ar, Desc.Index, Decoder ? Decoder->StructPlan : nullptr, static_cast<uint8*>(Dst));
+				break;
+			case EType::Array:
+				{
+					int32 Num = 0;
+					Ar << Num;
+					const int32 Reserve = CheckCount(Ar, Num, Schema.MinEncodedSizes[Desc.Inner]);
+					if (Reserve == INDEX_NONE)
+						break;
+					const FTypeDesc& InnerDesc = Schema.Types[Desc.Inner];
+					if (!Decoder)
+					{
+						if (IsPodType(InnerDesc.Type))
+						{
+							SkipBytes(Ar, static_cast<int64>(Num) * InnerDesc.GetPodSize());
+							break;
+						}
+						for (int32 Index = 0; Index < Num && !Ar.IsError(); ++Index)
+						{
+							DecodeValue(Ar, Desc.Inner, nullptr, nullptr);
+						}
+						break;
+					}
+					FScriptArrayHelper Helper(static_cast<const FArrayProperty*>(Decoder->Property), Dst);
+					Helper.EmptyValues(Reserve);
+					if (IsPodType(InnerDesc.Type) && Decoder->Inner->Kind == EDecodeKind::Memcpy)
+					{
+						// 定长元素整段读取，长度未经检查时分块增长
+						for (int32 Loaded = 0; Loaded < Num && !Ar.IsError();)
+						{
+							const int32 Chunk = FMath::Min(Num - Loaded, FMath::Max(Reserve, 1));
+							const int32 First = Helper.AddValues(Chunk);
+							Ar.Serialize(Helper.GetRawPtr(First), static_cast<int64>(Chunk) * InnerDesc.GetPodSize());
+							Loaded += Chunk;
+						}
+						break;
+					}
+					for (int32 Index = 0; Index < Num && !Ar.IsError(); ++Index)
+					{
+						DecodeValue(Ar, Desc.Inner, Decoder->Inner.Get(), Helper.GetRawPtr(Helper.AddValue()));
+					}
+				}
+				break;
+			case EType::Set:
+				{
+					int32 Num = 0;
+					Ar << Num;
+					const int32 Reserve = CheckCount(Ar, Num, Schema.MinEncodedSizes[Desc.Inner]);
+					if (Reserve == INDEX_NONE)
+						break;
+					if (!Decoder)
+					{
+						for (int32 Index = 0; Index < Num && !Ar.IsError(); ++Index)
+						{
+							DecodeValue(Ar, Desc.Inner, nullptr, nullptr);
+						}
+						break;
+					}
+					FScriptSetHelper Helper(static_cast<const FSetProperty*>(Decoder->Property), Dst);
+					Helper.EmptyElements(Reserve);
+					const FValueDecoder* Inner = Decoder->Inner.Get();
+					if (IsInjective(*Inner))
+					{
+						for (int32 Index = 0; Index < Num && !Ar.IsError(); ++Index)
+						{
+							const int32 NewIndex = Helper.AddDefaultValue_Invalid_NeedsRehash();
+							DecodeValue(Ar, Desc.Inner, Inner, Helper.GetElementPtr(NewIndex));
+						}
+						Helper.Rehash();
+						break;
+					}
+					// 枚举重映射、数值转换、结构体丢弃字段都可能使不同的元素变得相同，先读到临时值再查重，相同的只保留第一个
+					const FProperty* ElementProp = Inner->Property;
+					FScopedValue Element(ElementProp, FMemory_Alloca_Aligned(ElementProp->GetSize(), ElementProp->GetMinAlignment()));
+					for (int32 Index = 0; Index < Num && !Ar.IsError(); ++Index)
+					{
+						ElementProp->ClearValue(Element.Data);
+						DecodeValue(Ar, Desc.Inner, Inner, Element.Data);
+						if (!Ar.IsError() && Helper.FindElementIndex(Element.Data) == INDEX_NONE)
+						{
+							Helper.AddElement(Element.Data);
+						}
+					}
+				}
+				break;
+			case EType::Map:
+				{
+					int32 Num = 0;
+					Ar << Num;
+					const int32 Reserve = CheckCount(Ar, Num, Schema.MinEncodedSizes[Desc.Inner] + Schema.MinEncodedSizes[Desc.Value]);
+					if (Reserve == INDEX_NONE)
+						break;
+					if (!Decoder)
+					{
+						for (int32 Index = 0; Index < Num && !Ar.IsError(); ++Index)
+						{
+							DecodeValue(Ar, Desc.Inner, nullptr, nullptr);
+							DecodeValue(Ar, Desc.Value, nullptr, nullptr);
+						}
+						break;
+					}
+					FScriptMapHelper Helper(static_cast<const FMapProperty*>(Decoder->Property), Dst);
+					Helper.EmptyValues(Reserve);
+					const FValueDecoder* Inner = Decoder->Inner.Get();
+					if (IsInjective(*Inner))
+					{
+						for (int32 Index = 0; Index < Num && !Ar.IsError(); ++Index)
+						{
+							const int32 NewIndex = Helper.AddDefaultValue_Invalid_NeedsRehash();
+							DecodeValue(Ar, Desc.Inner, Inner, Helper.GetKeyPtr(NewIndex));
+							DecodeValue(Ar, Desc.Value, Decoder->Value.Get(), Helper.GetValuePtr(NewIndex));
+						}
+						Helper.Rehash();
+						break;
+					}
+					// 与 Set 相同，Key 先读到临时值，已存在的 Key 读出 Value 后丢弃
+					const FProperty* KeyProp = Inner->Property;
+					const FProperty* ValueProp = Decoder->Value->Property;
+					FScopedValue Key(KeyProp, FMemory_Alloca_Aligned(KeyProp->GetSize(), KeyProp->GetMinAlignment()));
+					FScopedValue Value(ValueProp, FMemory_Alloca_Aligned(ValueProp->GetSize(), ValueProp->GetMinAlignment()));
+					for (int32 Index = 0; Index < Num && !Ar.IsError(); ++Index)
+					{
+						KeyProp->ClearValue(Key.Data);
+						DecodeValue(Ar, Desc.Inner, Inner, Key.Data);
+						const bool bDuplicate = Helper.FindMapIndexWithKey(Key.Data) != INDEX_NONE;
+						if (!bDuplicate)
+						{
+							ValueProp->ClearValue(Value.Data);
+						}
+						DecodeValue(Ar, Desc.Value, bDuplicate ? nullptr : Decoder->Value.Get(), bDuplicate ? nullptr : Value.Data);
+						if (!bDuplicate && !Ar.IsError())
+						{
+							Helper.AddPair(Key.Data, Value.Data);
+						}
+					}
+				}
+				break;
+			default:
+				Ar.SetError();
+				break;
+			}
+		}
+	};
+
+	FRWLock CacheLock;
+	TMap<TPair<uint64, const UStruct*>, TSharedPtr<const FDecodePlanSet>> Cache;
+
+#pragma endregion
+}
+
+FReflectionStructArchiveWriter::FReflectionStructArchiveWriter(FArchive& InArchive, const UStruct* InStruct)
+	: Archive(InArchive)
+	, Encoder(MakeUnique<ReflectionStructArchive::FEncoder>())
+{
+	using namespace ReflectionStructArchive;
+	check(InStruct && Archive.IsSaving());
+	Encoder->AddStruct(InStruct);
+
+	TArray<uint8> SchemaBytes;
+	FMemoryWriter SchemaWriter(SchemaBytes);
+	Encoder->Schema.Serialize(SchemaWriter);
+
+	uint32 FileMagic = Magic;
+	uint32 FileVersion = FormatVersion;
+	uint64 Hash = CityHash64(reinterpret_cast<const char*>(SchemaBytes.GetData()), SchemaBytes.Num());
+	int32 SchemaSize = SchemaBytes.Num();
+	Archive << FileMagic << FileVersion << Hash << SchemaSize;
+	Archive.Serialize(SchemaBytes.GetData(), SchemaSize);
+}
+
+FReflectionStructArchiveWriter::~FReflectionStructArchiveWriter() = default;
+
+void FReflectionStructArchiveWriter::Write(const void* Record)
+{
+	REFLECTIONTOOL_SCOPE(StructArchive);
+	Encoder->EncodeStruct(Archive, 0, static_cast<const uint8*>(Record));
+	++NumRecords;
+}
+
+FReflectionStructArchiveReader::FReflectionStructArchiveReader(FArchive& InArchive, const UStruct* InStruct)
+	: Archive(InArchive)
+{
+	using namespace ReflectionStructArchive;
+	check(InStruct && Archive.IsLoading());
+
+	uint32 FileMagic = 0;
+	uint32 FileVersion = 0;
+	int32 SchemaSize = 0;
+	Archive << FileMagic << FileVersion << SchemaHash << SchemaSize;
+	if (Archive.IsError() || FileMagic != Magic || FileVersion != FormatVersion || SchemaSize < 0 || SchemaSize > GetRemainingSize(Archive))
+	{
+		UE_LOG(ReflectionTool, Warning, TEXT("StructArchive: invalid header"));
+		Archive.SetError();
+		return;
+	}
+
+	const TPair<uint64, const UStruct*> Key(SchemaHash, InStruct);
+	{
+		FReadScopeLock ReadLock(CacheLock);
+		if (const TSharedPtr<const FDecodePlanSet>* Found = Cache.Find(Key))
+		{
+			if ((*Found)->RootStruct.Get() == InStruct)
+			{
+				PlanSet = *Found;
+			}
+		}
+	}
+	if (PlanSet.IsValid())
+	{
+		SkipBytes(Archive, SchemaSize);
+		return;
+	}
+
+	// 非定长流中的 SchemaSize 未经检查，分块读取
+	TArray<uint8> SchemaBytes;
+	for (int32 Loaded = 0; Loaded < SchemaSize && !Archive.IsError();)
+	{
+		const int32 Chunk = FMath::Min(SchemaSize - Loaded, 64 * 1024);
+		SchemaBytes.AddUninitialized(Chunk);
+		Archive.Serialize(SchemaBytes.GetData() + Loaded, Chunk);
+		Loaded += Chunk;
+	}
+	if (Archive.IsError() || CityHash64(reinterpret_cast<const char*>(SchemaBytes.GetData()), SchemaSize) != SchemaHash)
+	{
+		UE_LOG(ReflectionTool, Warning, TEXT("StructArchive: schema hash mismatch"));
+		Archive.SetError();
+		return;
+	}
+
+	TSharedPtr<FDecodePlanSet> NewPlanSet = MakeShared<FDecodePlanSet>();
+	FMemoryReader SchemaReader(SchemaBytes);
+	NewPlanSet->Schema.Serialize(SchemaReader);
+	if (SchemaReader.IsError() || !NewPlanSet->Schema.Validate(GetRemainingSize(Archive)))
+	{
+		UE_LOG(ReflectionTool, Warning, TEXT("StructArchive: corrupted schema"));
+		Archive.SetError();
+		return;
+	}
+	NewPlanSet->RootStruct = InStruct;
+	NewPlanSet->RootPlan = NewPlanSet->GetStructPlan(0, InStruct);
+
+	FWriteScopeLock WriteLock(CacheLock);
+	Cache.Add(Key, NewPlanSet);
+	PlanSet = NewPlanSet;
+}
+
+FReflectionStructArchiveReader::~FReflectionStructArchiveReader() = default;
+
+bool FReflectionStructArchiveReader::Read(void* Record)
+{
+	REFLECTIONTOOL_SCOPE(StructArchive);
+	// 非定长流无法预先判断末尾，读到末尾时 Archive 进入错误状态
+	if (!PlanSet.IsValid() || Archive.IsError() || (Archive.TotalSize() >= 0 && Archive.AtEnd()))
+		return false;
+	PlanSet->DecodeStruct(Archive, 0, PlanSet->RootPlan.Get(), static_cast<uint8*>(Record));
+	return !Archive.IsError();
+}
+
+void FReflectionStructArchiveReader::ClearCache()
+{
+	FWriteScopeLock WriteLock(ReflectionStructArchive::CacheLock);
+	ReflectionStructArchive::Cache.Empty();
+}
@@ -0,0 +1,249 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#include "ReflectionStructColumns.h"
+
+#include "ReflectionToolStats.h"
+
+namespace ReflectionStructColumns
+{
+	using ELeafKind = FReflectionPropertyPath::ELeafKind;
+
+	template<typename Type>
+	struct TTypeTag
+	{
+		using FType = Type;
+	};
+
+	// 按数值属性的具体类型调用 Functor(TTypeTag<T>)
+	template<typename FunctorType>
+	bool DispatchNumeric(const FNumericProperty* Property, FunctorType&& Functor)
+	{
+		if (Property->IsA<FInt8Property>()) Functor(TTypeTag<int8>());
+		else if (Property->IsA<FInt16Property>()) Functor(TTypeTag<int16>());
+		else if (Property->IsA<FIntProperty>()) Functor(TTypeTag<int32>());
+		else if (Property->IsA<FInt64Property>()) Functor(TTypeTag<int64>());
+		else if (Property->IsA<FByteProperty>()) Functor(TTypeTag<uint8>());
+		else if (Property->IsA<FUInt16Property>()) Functor(TTypeTag<uint16>());
+		else if (Property->IsA<FUInt32Property>()) Functor(TTypeTag<uint32>());
+		else if (Property->IsA<FUInt64Property>()) Functor(TTypeTag<uint64>());
+		else if (Property->IsA<FFloatProperty>()) Functor(TTypeTag<float>());
+		else if (Property->IsA<FDoubleProperty>()) Functor(TTypeTag<double>());
+		else return false;
+		return true;
+	}
+
+	template<typename DstType, typename SrcType>
+	FORCEINLINE DstType ConvertNumber(SrcType Value)
+	{
+		if constexpr (std::is_integral_v<DstType> && std::is_floating_point_v<SrcType>)
+		{
+			return static_cast<DstType>(FMath::RoundToInt64(static_cast<double>(Value)));
+		}
+		else
+		{
+			return static_cast<DstType>(Value);
+		}
+	}
+
+	// Base 指向第 0 个元素的叶子，相邻元素间隔 Stride
+	template<typename SrcType, typename DstType>
+	void GatherStrided(const uint8* Base, int32 Num, int32 Stride, DstType* Out)
+	{
+		if constexpr (std::is_same_v<SrcType, DstType>)
+		{
+			if (Stride == sizeof(SrcType))
+			{
+				FMemory::Memcpy(Out, Base, sizeof(SrcType) * Num);
+				return;
+			}
+		}
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Out[Index] = ConvertNumber<DstType>(*reinterpret_cast<const SrcType*>(Base + static_cast<SIZE_T>(Index) * Stride));
+		}
+	}
+
+	template<typename DstType, typename SrcType>
+	void ScatterStrided(uint8* Base, int32 Num, int32 Stride, const SrcType* In)
+	{
+		if constexpr (std::is_same_v<SrcType, DstType>)
+		{
+			if (Stride == sizeof(DstType))
+			{
+				FMemory::Memcpy(Base, In, sizeof(DstType) * Num);
+				return;
+			}
+		}
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			*reinterpret_cast<DstType*>(Base + static_cast<SIZE_T>(Index) * Stride) = ConvertNumber<DstType>(In[Index]);
+		}
+	}
+
+	// 叶子类型能否读写为 ValueType
+	template<typename ValueType>
+	bool IsCompatible(ELeafKind LeafKind)
+	{
+		if constexpr (std::is_same_v<ValueType, bool>)
+			return LeafKind == ELeafKind::Bool;
+		else if constexpr (std::is_arithmetic_v<ValueType>)
+			return LeafKind == ELeafKind::Integer || LeafKind == ELeafKind::Float || LeafKind == ELeafKind::Enum;
+		else if constexpr (std::is_same_v<ValueType, FName>)
+			return LeafKind == ELeafKind::Name;
+		else
+			return true;
+	}
+
+	template<typename ValueType>
+	bool ExtractTyped(const uint8* Elements, int32 Num, int32 Stride, const FReflectionPropertyPath& Path, ValueType* Out)
+	{
+		if (!IsCompatible<ValueType>(Path.LeafKind))
+			return false;
+
+		const int32 Offset = Path.GetFixedOffset();
+		if (Offset != INDEX_NONE)
+		{
+			const uint8* Base = Elements + Offset;
+			if constexpr (std::is_same_v<ValueType, bool>)
+			{
+				const FBoolProperty* BoolProperty = static_cast<const FBoolProperty*>(Path.LeafProperty);
+				for (int32 Index = 0; Index < Num; ++Index)
+				{
+					Out[Index] = BoolProperty->GetPropertyValue(Base + static_cast<SIZE_T>(Index) * Stride);
+				}
+				return true;
+			}
+			else if constexpr (std::is_arithmetic_v<ValueType>)
+			{
+				return DispatchNumeric(Path.LeafNumeric, [Base, Num, Stride, Out](auto Tag)
+				{
+					GatherStrided<typename decltype(Tag)::FType>(Base, Num, Stride, Out);
+				});
+			}
+			else
+			{
+				if (std::is_same_v<ValueType, FName> || Path.LeafKind == ELeafKind::String)
+				{
+					for (int32 Index = 0; Index < Num; ++Index)
+					{
+						Out[Index] = *reinterpret_cast<const ValueType*>(Base + static_cast<SIZE_T>(Index) * Stride);
+					}
+					return true;
+				}
+			}
+		}
+
+		// 路径经过 TArray / TMap，或需要转换为字符串，逐个元素解析
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			if (!Path.GetValue(Elements + static_cast<SIZE_T>(Index) * Stride, Out[Index]))
+			{
+				Out[Index] = ValueType();
+			}
+		}
+		return true;
+	}
+
+	template<typename ValueType>
+	bool ScatterTyped(uint8* Elements, int32 Num, int32 Stride, const FReflectionPropertyPath& Path, const ValueType* In)
+	{
+		if (!IsCompatible<ValueType>(Path.LeafKind))
+			return false;
+
+		const int32 Offset = Path.GetFixedOffset();
+		if (Offset != INDEX_NONE)
+		{
+			uint8* Base = Elements + Offset;
+			if constexpr (std::is_same_v<ValueType, bool>)
+			{
+				const FBoolProperty* BoolProperty = static_cast<const FBoolProperty*>(Path.LeafProperty);
+				for (int32 Index = 0; Index < Num; ++Index)
+				{
+					BoolProperty->SetPropertyValue(Base + static_cast<SIZE_T>(Index) * Stride, In[Index]);
+				}
+				return true;
+			}
+			else if constexpr (std::is_arithmetic_v<ValueType>)
+			{
+				return DispatchNumeric(Path.LeafNumeric, [Base, Num, Stride, In](auto Tag)
+				{
+					ScatterStrided<typename decltype(Tag)::FType>(Base, Num, Stride, In);
+				});
+			}
+			else
+			{
+				if (std::is_same_v<ValueType, FName> || Path.LeafKind == ELeafKind::String)
+				{
+					for (int32 Index = 0; Index < Num; ++Index)
+					{
+						*reinterpret_cast<ValueType*>(Base + static_cast<SIZE_T>(Index) * Stride) = In[Index];
+					}
+					return true;
+				}
+			}
+		}
+
+		bool bSuccess = true;
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			bSuccess &= Path.SetValue(Elements + static_cast<SIZE_T>(Index) * Stride, In[Index]);
+		}
+		return bSuccess;
+	}
+}
+
+bool FReflectionStructColumns::ExtractRaw(const UScriptStruct* ElementStruct, const void* Elements, int32 Num,
+	const FReflectionPropertyPath& Path, EReflectionColumnType Type, void* OutValues)
+{
+	using namespace ReflectionStructColumns;
+	REFLECTIONTOOL_SCOPE(StructColumns);
+
+	if (!Path.IsValidFor(ElementStruct) || Path.GetLeafArrayDim() != 1)
+		return false;
+	if (Num == 0)
+		return true;
+	if (!Elements || !OutValues)
+		return false;
+
+	const uint8* Base = static_cast<const uint8*>(Elements);
+	const int32 Stride = ElementStruct->GetStructureSize();
+	switch (Type)
+	{
+	case EReflectionColumnType::Bool: return ExtractTyped(Base, Num, Stride, Path, static_cast<bool*>(OutValues));
+	case EReflectionColumnType::Int32: return ExtractTyped(Base, Num, Stride, Path, static_cast<int32*>(OutValues));
+	case EReflectionColumnType::Int64: return ExtractTyped(Base, Num, Stride, Path, static_cast<int64*>(OutValues));
+	case EReflectionColumnType::Float: return ExtractTyped(Base, Num, Stride, Path, static_cast<float*>(OutValues));
+	case EReflectionColumnType::Double: return ExtractTyped(Base, Num, Stride, Path, static_cast<double*>(OutValues));
+	case EReflectionColumnType::Name: return ExtractTyped(Base, Num, Stride, Path, static_cast<FName*>(OutValues));
+	case EReflectionColumnType::String: return ExtractTyped(Base, Num, Stride, Path, static_cast<FString*>(OutValues));
+	default: return false;
+	}
+}
+
+bool FReflectionStructColumns::ScatterRaw(const UScriptStruct* ElementStruct, void* Elements, int32 Num,
+	const FReflectionPropertyPath& Path, EReflectionColumnType Type, const void* Values)
+{
+	using namespace ReflectionStructColumns;
+	REFLECTIONTOOL_SCOPE(StructColumns);
+
+	if (!Path.IsValidFor(ElementStruct) || Path.GetLeafArrayDim() != 1)
+		return false;
+	if (Num == 0)
+		return true;
+	if (!Elements || !Values)
+		return false;
+
+	uint8* Base = static_cast<uint8*>(Elements);
+	const int32 Stride = ElementStruct->GetStructureSize();
+	switch (Type)
+	{
+	case EReflectionColumnType::Bool: return ScatterTyped(Base, Num, Stride, Path, static_cast<const bool*>(Values));
+	case EReflectionColumnType::Int32: return ScatterTyped(Base, Num, Stride, Path, static_cast<const int32*>(Values));
+	case EReflectionColumnType::Int64: return ScatterTyped(Base, Num, Stride, Path, static_cast<const int64*>(Values));
+	case EReflectionColumnType::Float: return ScatterTyped(Base, Num, Stride, Path, static_cast<const float*>(Values));
+	case EReflectionColumnType::Double: return ScatterTyped(Base, Num, Stride, Path, static_cast<const double*>(Values));
+	case EReflectionColumnType::Name: return ScatterTyped(Base, Num, Stride, Path, static_cast<const FName*>(Values));
+	case EReflectionColumnType::String: return ScatterTyped(Base, Num, Stride, Path, static_cast<const FString*>(Values));
+	default: return false;
+	}
+}
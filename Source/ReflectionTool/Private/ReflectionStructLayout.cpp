@@ -0,0 +1,437 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#include "ReflectionStructLayout.h"
+
+#include "Hash/CityHash.h"
+#include "Misc/ScopeRWLock.h"
+
+namespace ReflectionStructLayout
+{
+	struct FCachedLayout
+	{
+		TWeakObjectPtr<const UStruct> Struct;
+		TSharedPtr<const FReflectionStructLayout> Layout;
+	};
+
+	FRWLock CacheLock;
+	TMap<const UStruct*, FCachedLayout> Cache;
+
+	// 当前线程正在构建的布局，外层在前
+	struct FBuildFrame
+	{
+		const UStruct* Struct;
+		FReflectionStructLayout* Layout;
+		// 引用了更外层的布局，生命周期依附于外层，不能单独缓存
+		bool bDependsOnOuter;
+	};
+	thread_local TArray<FBuildFrame> BuildStack;
+
+	FORCEINLINE uint64 Mix(uint64 Seed, uint64 Value)
+	{
+		return CityHash128to64(Uint128_64(Seed, Value));
+	}
+
+	FORCEINLINE uint64 HashBytes(const void* Data, int32 Size, uint64 Seed)
+	{
+		return CityHash64WithSeed(static_cast<const char*>(Data), Size, Seed);
+	}
+
+	// -0 归为 0，所有 NaN 归为同一个值
+	FORCEINLINE uint64 CanonicalBits(double Value)
+	{
+		if (Value == 0.0)
+			return 0;
+		if (FMath::IsNaN(Value))
+			return 0x7ff8000000000000ull;
+		uint64 Bits;
+		FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+		return Bits;
+	}
+
+	FORCEINLINE uint64 HashString(const TCHAR* Chars, int32 Len, uint64 Seed)
+	{
+		return HashBytes(Chars, Len * sizeof(TCHAR), Mix(Seed, Len));
+	}
+
+	// 自带拷贝 / 比较的非 POD 结构体不能展开为逐字段处理
+	bool HasNativeCopy(const UStruct* Struct)
+	{
+		const UScriptStruct* ScriptStruct = Cast<UScriptStruct>(Struct);
+		return ScriptStruct && ScriptStruct->HasAnyStructFlags(STRUCT_CopyNative | STRUCT_IdenticalNative)
+			&& !ScriptStruct->HasAnyStructFlags(STRUCT_IsPlainOldData);
+	}
+}
+
+TSharedPtr<const FReflectionStructLayout> FReflectionStructLayout::Get(const UStruct* Struct)
+{
+	using namespace ReflectionStructLayout;
+	if (!Struct)
+		return nullptr;
+
+	{
+		FReadScopeLock ReadLock(CacheLock);
+		if (const FCachedLayout* Found = Cache.Find(Struct))
+		{
+			if (Found->Struct.Get() == Struct)
+				return Found->Layout;
+		}
+	}
+
+	// 在锁外构建，嵌套的容器元素会递归调用 Get
+	TSharedPtr<FReflectionStructLayout> Layout = MakeShared<FReflectionStructLayout>();
+	BuildStack.Add({ Struct, Layout.Get(), false });
+	Layout->AddStruct(EPurpose::Hash, Struct, 0);
+	if (HasNativeCopy(Struct))
+	{
+		Layout->NativeStruct = CastChecked<UScriptStruct>(Struct);
+	}
+	else
+	{
+		Layout->AddStruct(EPurpose::Copy, Struct, 0);
+		Layout->AddStruct(EPurpose::Compare, Struct, 0);
+		Layout->bPlainOldData = Layout->CopyOps.Num() == 1 && Layout->CopyOps[0].Kind == EOpKind::PodRun
+			&& Layout->CopyOps[0].Offset == 0 && Layout->CopyOps[0].Size == Struct->GetPropertiesSize();
+	}
+	const bool bDependsOnOuter = BuildStack.Pop(false).bDependsOnOuter;
+	if (bDependsOnOuter)
+		return Layout;
+
+	FWriteScopeLock WriteLock(CacheLock);
+	FCachedLayout& Cached = Cache.FindOrAdd(Struct);
+	if (Cached.Struct.Get() != Struct || !Cached.Layout.IsValid())
+	{
+		Cached.Struct = Struct;
+		Cached.Layout = Layout;
+	}
+	return Cached.Layout;
+}
+
+void FReflectionStructLayout::ClearCache()
+{
+	FWriteScopeLock WriteLock(ReflectionStructLayout::CacheLock);
+	ReflectionStructLayout::Cache.Empty();
+}
+
+const FReflectionStructLayout* FReflectionStructLayout::BuildForProperty(const FProperty* Property)
+{
+	using namespace ReflectionStructLayout;
+	if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+	{
+		// 结构体通过容器引用自身或外层结构体（TArray<FSelf>）：指向构建中的布局，之间的各层都依附于它
+		const int32 Found = BuildStack.IndexOfByPredicate([StructProperty](const FBuildFrame& Frame) { return Frame.Struct == StructProperty->Struct; });
+		if (Found != INDEX_NONE)
+		{
+			for (int32 Index = Found + 1; Index < BuildStack.Num(); ++Index)
+			{
+				BuildStack[Index].bDependsOnOuter = true;
+			}
+			return BuildStack[Found].Layout;
+		}
+		return Dependencies.Add_GetRef(Get(StructProperty->Struct)).Get();
+	}
+
+	TSharedPtr<FReflectionStructLayout> Layout = MakeShared<FReflectionStructLayout>();
+	Layout->AddProperty(EPurpose::Hash, Property, 0);
+	Dependencies.Add(Layout);
+	return Layout.Get();
+}
+
+void FReflectionStructLayout::AddStruct(EPurpose Purpose, const UStruct* Struct, int32 BaseOffset)
+{
+	for (TFieldIterator<FProperty> It(Struct); It; ++It)
+	{
+		AddProperty(Purpose, *It, BaseOffset + It->GetOffset_ForInternal());
+	}
+}
+
+void FReflectionStructLayout::AddRun(TArray<FOp>& Ops, EOpKind Kind, int32 Offset, int32 Size)
+{
+	// 与上一段紧邻时合并
+	if (Ops.Num() > 0)
+	{
+		FOp& Last = Ops.Last();
+		if (Last.Kind == Kind && Last.Offset + Last.Size == Offset)
+		{
+			Last.Size += Size;
+			return;
+		}
+	}
+	FOp& Op = Ops.AddDefaulted_GetRef();
+	Op.Kind = Kind;
+	Op.Offset = Offset;
+	Op.Size = Size;
+}
+
+void FReflectionStructLayout::AddProperty(EPurpose Purpose, const FProperty* Property, int32 Offset)
+{
+	TArray<FOp>& Ops = Purpose == EPurpose::Hash ? HashOps : Purpose == EPurpose::Copy ? CopyOps : CompareOps;
+	const int32 ElementSize = Property->ElementSize;
+	const int32 ArrayDim = Property->ArrayDim;
+	const bool bHash = Purpose == EPurpose::Hash;
+	const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property);
+
+	EOpKind Kind = EOpKind::Other;
+	const FReflectionStructLayout* Inner = nullptr;
+	const FReflectionStructLayout* Value = nullptr;
+	if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+	{
+		if (bHash || !ReflectionStructLayout::HasNativeCopy(StructProperty->Struct))
+		{
+			for (int32 Index = 0; Index < ArrayDim; ++Index)
+			{
+				AddStruct(Purpose, StructProperty->Struct, Offset + Index * ElementSize);
+			}
+			return;
+		}
+		Kind = EOpKind::Struct;
+	}
+	else if (Property->IsA<FFloatProperty>() || Property->IsA<FDoubleProperty>())
+	{
+		// 拷贝时浮点数与整数一样按字节处理；比较需按值（-0 == 0、NaN != NaN），不能并入 memcmp 段
+		const EOpKind RunKind = Purpose == EPurpose::Copy ? EOpKind::PodRun : Property->IsA<FFloatProperty>() ? EOpKind::Float : EOpKind::Double;
+		AddRun(Ops, RunKind, Offset, ElementSize * ArrayDim);
+		return;
+	}
+	else if (Property->IsA<FNumericProperty>() || Property->IsA<FEnumProperty>()
+		|| (BoolProperty && BoolProperty->IsNativeBool())
+		|| (Purpose == EPurpose::Copy && Property->IsA<FNameProperty>()))
+	{
+		AddRun(Ops, EOpKind::PodRun, Offset, ElementSize * ArrayDim);
+		return;
+	}
+	else if (BoolProperty)
+	{
+		Kind = EOpKind::BitfieldBool;
+	}
+	else if (Property->IsA<FStrProperty>())
+	{
+		Kind = EOpKind::String;
+	}
+	else if (Property->IsA<FNameProperty>())
+	{
+		Kind = EOpKind::Name;
+	}
+	else if (Property->IsA<FTextProperty>())
+	{
+		Kind = EOpKind::Text;
+	}
+	else if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+	{
+		Kind = EOpKind::Array;
+		Inner = bHash ? BuildForProperty(ArrayProperty->Inner) : nullptr;
+	}
+	else if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+	{
+		Kind = EOpKind::Set;
+		Inner = bHash ? BuildForProperty(SetProperty->ElementProp) : nullptr;
+	}
+	else if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+	{
+		Kind = EOpKind::Map;
+		Inner = bHash ? BuildForProperty(MapProperty->KeyProp) : nullptr;
+		Value = bHash ? BuildForProperty(MapProperty->ValueProp) : nullptr;
+	}
+
+	for (int32 Index = 0; Index < ArrayDim; ++Index)
+	{
+		FOp& Op = Ops.AddDefaulted_GetRef();
+		Op.Kind = Kind;
+		Op.Offset = Offset + Index * ElementSize;
+		Op.Size = ElementSize;
+		Op.Property = Property;
+		Op.Inner = Inner;
+		Op.Value = Value;
+	}
+}
+
+uint64 FReflectionStructLayout::Hash(const void* Data, uint64 Seed) const
+{
+	using namespace ReflectionStructLayout;
+	const uint8* Base = static_cast<const uint8*>(Data);
+
+	for (const FOp& Op : HashOps)
+	{
+		const uint8* Addr = Base + Op.Offset;
+		switch (Op.Kind)
+		{
+		case EOpKind::PodRun:
+			Seed = HashBytes(Addr, Op.Size, Seed);
+			break;
+		case EOpKind::BitfieldBool:
+			Seed = Mix(Seed, static_cast<const FBoolProperty*>(Op.Property)->GetPropertyValue(Addr) ? 1 : 0);
+			break;
+		case EOpKind::Float:
+			for (const float* It = reinterpret_cast<const float*>(Addr), *End = It + Op.Size / sizeof(float); It < End; ++It)
+			{
+				Seed = Mix(Seed, CanonicalBits(*It));
+			}
+			break;
+		case EOpKind::Double:
+			for (const double* It = reinterpret_cast<const double*>(Addr), *End = It + Op.Size / sizeof(double); It < End; ++It)
+			{
+				Seed = Mix(Seed, CanonicalBits(*It));
+			}
+			break;
+		case EOpKind::String:
+			{
+				const FString& String = *reinterpret_cast<const FString*>(Addr);
+				Seed = HashString(*String, String.Len(), Seed);
+			}
+			break;
+		case EOpKind::Name:
+			{
+				// FName 的比较不区分大小写，Index 在不同进程中也不同，按小写字符串哈希
+				TCHAR Buffer[NAME_SIZE];
+				const uint32 Len = reinterpret_cast<const FName*>(Addr)->ToString(Buffer, NAME_SIZE);
+				for (uint32 Index = 0; Index < Len; ++Index)
+				{
+					Buffer[Index] = FChar::ToLower(Buffer[Index]);
+				}
+				Seed = HashString(Buffer, Len, Seed);
+			}
+			break;
+		case EOpKind::Text:
+			{
+				const FString& String = reinterpret_cast<const FText*>(Addr)->ToString();
+				Seed = HashString(*String, String.Len(), Seed);
+			}
+			break;
+		case EOpKind::Array:
+			{
+				FScriptArrayHelper Helper(static_cast<const FArrayProperty*>(Op.Property), Addr);
+				const int32 Num = Helper.Num();
+				Seed = Mix(Seed, Num);
+				for (int32 Index = 0; Index < Num; ++Index)
+				{
+					Seed = Op.Inner->Hash(Helper.GetRawPtr(Index), Seed);
+				}
+			}
+			break;
+		case EOpKind::Set:
+			{
+				// 与顺序无关：各元素独立哈希后求和
+				FScriptSetHelper Helper(static_cast<const FSetProperty*>(Op.Property), Addr);
+				uint64 Sum = 0;
+				for (int32 Index = 0, Remaining = Helper.Num(); Remaining > 0; ++Index)
+				{
+					if (Helper.IsValidIndex(Index))
+					{
+						Sum += Op.Inner->Hash(Helper.GetElementPtr(Index));
+						--Remaining;
+					}
+				}
+				Seed = Mix(Mix(Seed, Helper.Num()), Sum);
+			}
+			break;
+		case EOpKind::Map:
+			{
+				FScriptMapHelper Helper(static_cast<const FMapProperty*>(Op.Property), Addr);
+				uint64 Sum = 0;
+				for (int32 Index = 0, Remaining = Helper.Num(); Remaining > 0; ++Index)
+				{
+					if (Helper.IsValidIndex(Index))
+					{
+						Sum += Op.Value->Hash(Helper.GetValuePtr(Index), Op.Inner->Hash(Helper.GetKeyPtr(Index)));
+						--Remaining;
+					}
+				}
+				Seed = Mix(Mix(Seed, Helper.Num()), Sum);
+			}
+			break;
+		default:
+			{
+				FString Text;
+				Op.Property->ExportTextItem_Direct(Text, Addr, nullptr, nullptr, PPF_None);
+				Seed = HashString(*Text, Text.Len(), Seed);
+			}
+			break;
+		}
+	}
+	return Seed;
+}
+
+void FReflectionStructLayout::Copy(void* Dst, const void* Src) const
+{
+	if (NativeStruct)
+	{
+		NativeStruct->CopyScriptStruct(Dst, Src);
+		return;
+	}
+
+	uint8* DstBase = static_cast<uint8*>(Dst);
+	const uint8* SrcBase = static_cast<const uint8*>(Src);
+	for (const FOp& Op : CopyOps)
+	{
+		switch (Op.Kind)
+		{
+		case EOpKind::PodRun:
+			FMemory::Memcpy(DstBase + Op.Offset, SrcBase + Op.Offset, Op.Size);
+			break;
+		case EOpKind::BitfieldBool:
+			{
+				const FBoolProperty* BoolProperty = static_cast<const FBoolProperty*>(Op.Property);
+				BoolProperty->SetPropertyValue(DstBase + Op.Offset, BoolProperty->GetPropertyValue(SrcBase + Op.Offset));
+			}
+			break;
+		case EOpKind::String:
+			*reinterpret_cast<FString*>(DstBase + Op.Offset) = *reinterpret_cast<const FString*>(SrcBase + Op.Offset);
+			break;
+		default:
+			Op.Property->CopySingleValue(DstBase + Op.Offset, SrcBase + Op.Offset);
+			break;
+		}
+	}
+}
+
+bool FReflectionStructLayout::Identical(const void* A, const void* B) const
+{
+	if (NativeStruct)
+		return NativeStruct->CompareScriptStruct(A, B, PPF_None);
+
+	const uint8* BaseA = static_cast<const uint8*>(A);
+	const uint8* BaseB = static_cast<const uint8*>(B);
+	for (const FOp& Op : CompareOps)
+	{
+		switch (Op.Kind)
+		{
+		case EOpKind::PodRun:
+			if (FMemory::Memcmp(BaseA + Op.Offset, BaseB + Op.Offset, Op.Size) != 0)
+				return false;
+			break;
+		case EOpKind::Float:
+			for (int32 Offset = Op.Offset, End = Op.Offset + Op.Size; Offset < End; Offset += sizeof(float))
+			{
+				if (*reinterpret_cast<const float*>(BaseA + Offset) != *reinterpret_cast<const float*>(BaseB + Offset))
+					return false;
+			}
+			break;
+		case EOpKind::Double:
+			for (int32 Offset = Op.Offset, End = Op.Offset + Op.Size; Offset < End; Offset += sizeof(double))
+			{
+				if (*reinterpret_cast<const double*>(BaseA + Offset) != *reinterpret_cast<const double*>(BaseB + Offset))
+					return false;
+			}
+			break;
+		case EOpKind::Name:
+			if (*reinterpret_cast<const FName*>(BaseA + Op.Offset) != *reinterpret_cast<const FName*>(BaseB + Op.Offset))
+				return false;
+			break;
+		case EOpKind::BitfieldBool:
+			{
+				const FBoolProperty* BoolProperty = static_cast<const FBoolProperty*>(Op.Property);
+				if (BoolProperty->GetPropertyValue(BaseA + Op.Offset) != BoolProperty->GetPropertyValue(BaseB + Op.Offset))
+					return false;
+			}
+			break;
+		case EOpKind::String:
+			if (!reinterpret_cast<const FString*>(BaseA + Op.Offset)->Equals(*reinterpret_cast<const FString*>(BaseB + Op.Offset), ESearchCase::CaseSensitive))
+				return false;
+			break;
+		default:
+			if (!Op.Property->Identical(BaseA + Op.Offset, BaseB + Op.Offset, PPF_None))
+				return false;
+			break;
+		}
+	}
+	return true;
+}
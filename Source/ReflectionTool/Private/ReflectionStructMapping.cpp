@@ -0,0 +1,474 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#include "ReflectionStructMapping.h"
+
+#include "ReflectionPropertyPath.h"
+#include "ReflectionStructLayout.h"
+#include "ReflectionToolLib.h"
+#include "Misc/ScopeRWLock.h"
+
+namespace ReflectionStructMapping
+{
+	using FCacheKey = TPair<const UStruct*, const UStruct*>;
+
+	struct FCachedMapping
+	{
+		TWeakObjectPtr<const UStruct> SrcStruct;
+		TWeakObjectPtr<const UStruct> DstStruct;
+		TSharedPtr<const FReflectionStructMapping> Mapping;
+	};
+
+	FRWLock CacheLock;
+	TMap<FCacheKey, FCachedMapping> Cache;
+
+	// 当前线程正在构建的映射，外层在前
+	struct FBuildFrame
+	{
+		FCacheKey Key;
+		FReflectionStructMapping* Mapping;
+		// 引用了更外层的映射，生命周期依附于外层，不能单独缓存
+		bool bDependsOnOuter;
+	};
+	thread_local TArray<FBuildFrame> BuildStack;
+
+	// 结构体通过容器引用自身或外层结构体时返回构建中的映射，之间的各层都依附于它
+	const FReflectionStructMapping* FindBuilding(const FCacheKey& Key)
+	{
+		const int32 Found = BuildStack.IndexOfByPredicate([&Key](const FBuildFrame& Frame) { return Frame.Key == Key; });
+		if (Found == INDEX_NONE)
+			return nullptr;
+		for (int32 Index = Found + 1; Index < BuildStack.Num(); ++Index)
+		{
+			BuildStack[Index].bDependsOnOuter = true;
+		}
+		return BuildStack[Found].Mapping;
+	}
+
+	// 容器元素的临时值，按属性初始化与销毁
+	struct FScopedElement
+	{
+		const FProperty* Property;
+		void* Data;
+
+		FScopedElement(const FProperty* InProperty, void* InData)
+			: Property(InProperty)
+			, Data(InData)
+		{
+			Property->InitializeValue(Data);
+		}
+
+		~FScopedElement()
+		{
+			Property->DestroyValue(Data);
+		}
+	};
+
+	// 数值属性与其枚举（FEnumProperty 取底层属性）
+	const FNumericProperty* GetNumeric(const FProperty* Property, const UEnum*& OutEnum)
+	{
+		OutEnum = nullptr;
+		if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+		{
+			OutEnum = EnumProperty->GetEnum();
+			return EnumProperty->GetUnderlyingProperty();
+		}
+		if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+		{
+			OutEnum = NumericProperty->GetIntPropertyEnum();
+			return NumericProperty;
+		}
+		return nullptr;
+	}
+
+	bool IsPlainOldData(const FProperty* Property)
+	{
+		const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property);
+		return Property->HasAnyPropertyFlags(CPF_IsPlainOldData) && (!BoolProperty || BoolProperty->IsNativeBool());
+	}
+}
+
+TSharedPtr<const FReflectionStructMapping> FReflectionStructMapping::Get(const UStruct* SrcStruct, const UStruct* DstStruct)
+{
+	using namespace ReflectionStructMapping;
+	if (!SrcStruct || !DstStruct)
+		return nullptr;
+
+	const FCacheKey Key(SrcStruct, DstStruct);
+	{
+		FReadScopeLock ReadLock(CacheLock);
+		if (const FCachedMapping* Found = Cache.Find(Key))
+		{
+			if (Found->SrcStruct.Get() == SrcStruct && Found->DstStruct.Get() == DstStruct)
+				return Found->Mapping;
+		}
+	}
+
+	// 在锁外构建，嵌套结构体会递归调用 Get
+	TSharedPtr<FReflectionStructMapping> Mapping = MakeShared<FReflectionStructMapping>();
+	BuildStack.Add({ Key, Mapping.Get(), false });
+	Mapping->Build(SrcStruct, DstStruct);
+	if (BuildStack.Pop(false).bDependsOnOuter)
+		return Mapping;
+
+	FWriteScopeLock WriteLock(CacheLock);
+	FCachedMapping& Cached = Cache.FindOrAdd(Key);
+	if (Cached.SrcStruct.Get() != SrcStruct || Cached.DstStruct.Get() != DstStruct || !Cached.Mapping.IsValid())
+	{
+		Cached.SrcStruct = SrcStruct;
+		Cached.DstStruct = DstStruct;
+		Cached.Mapping = Mapping;
+	}
+	return Cached.Mapping;
+}
+
+void FReflectionStructMapping::ClearCache()
+{
+	FWriteScopeLock WriteLock(ReflectionStructMapping::CacheLock);
+	ReflectionStructMapping::Cache.Empty();
+}
+
+void FReflectionStructMapping::Build(const UStruct* SrcStruct, const UStruct* DstStruct)
+{
+	if (SrcStruct == DstStruct)
+	{
+		SameLayout = FReflectionStructLayout::Get(SrcStruct);
+		for (TFieldIterator<FProperty> It(SrcStruct); It; ++It)
+		{
+			++NumMappedFields;
+		}
+		return;
+	}
+
+	for (TFieldIterator<FProperty> It(SrcStruct); It; ++It)
+	{
+		const FProperty* SrcProperty = *It;
+		const FProperty* DstProperty = FReflectionPropertyPath::FindPropertyByAuthoredName(DstStruct, SrcProperty->GetAuthoredName());
+		if (!DstProperty)
+			continue;
+		TSharedPtr<const FConverter> Converter = MakeConverter(SrcProperty, DstProperty);
+		if (!Converter.IsValid())
+		{
+			UE_LOG(ReflectionTool, Verbose, TEXT("CopyStructByName: [%s.%s] -> [%s.%s] has incompatible types, skipped"),
+				*SrcStruct->GetName(), *SrcProperty->GetName(), *DstStruct->GetName(), *DstProperty->GetName());
+			continue;
+		}
+		++NumMappedFields;
+
+		const int32 Count = FMath::Min(SrcProperty->ArrayDim, DstProperty->ArrayDim);
+		const int32 SrcOffset = SrcProperty->GetOffset_ForInternal();
+		const int32 DstOffset = DstProperty->GetOffset_ForInternal();
+		if (Converter->Kind == EConvertKind::Memcpy)
+		{
+			// 与上一段在 Src、Dst 中都紧邻时合并为一次 memcpy
+			const int32 Size = Converter->Size * Count;
+			if (Ops.Num() > 0 && !Ops.Last().Converter.IsValid()
+				&& Ops.Last().SrcOffset + Ops.Last().Size == SrcOffset && Ops.Last().DstOffset + Ops.Last().Size == DstOffset)
+			{
+				Ops.Last().Size += Size;
+				continue;
+			}
+			FFieldOp& Op = Ops.AddDefaulted_GetRef();
+			Op.SrcOffset = SrcOffset;
+			Op.DstOffset = DstOffset;
+			Op.Size = Size;
+			continue;
+		}
+
+		FFieldOp& Op = Ops.AddDefaulted_GetRef();
+		Op.SrcOffset = SrcOffset;
+		Op.DstOffset = DstOffset;
+		Op.Converter = MoveTemp(Converter);
+		Op.Count = Count;
+		Op.SrcStride = SrcProperty->ElementSize;
+		Op.DstStride = DstProperty->ElementSize;
+	}
+}
+
+TSharedPtr<const FReflectionStructMapping::FConverter> FReflectionStructMapping::MakeConverter(const FProperty* SrcProperty,
+	const FProperty* DstProperty)
+{
+	using namespace ReflectionStructMapping;
+	TSharedPtr<FConverter> Converter = MakeShared<FConverter>();
+	Converter->SrcProperty = SrcProperty;
+	Converter->DstProperty = DstProperty;
+	Converter->Size = SrcProperty->ElementSize;
+
+	if (CastField<FBoolProperty>(SrcProperty) && CastField<FBoolProperty>(DstProperty))
+	{
+		const bool bSameNative = CastFieldChecked<FBoolProperty>(SrcProperty)->IsNativeBool()
+			&& CastFieldChecked<FBoolProperty>(DstProperty)->IsNativeBool();
+		Converter->Kind = bSameNative ? EConvertKind::Memcpy : EConvertKind::Bool;
+		return Converter;
+	}
+
+	const FStructProperty* SrcStructProperty = CastField<FStructProperty>(SrcProperty);
+	const FStructProperty* DstStructProperty = CastField<FStructProperty>(DstProperty);
+	if (SrcStructProperty && DstStructProperty)
+	{
+		if (SrcStructProperty->Struct == DstStructProperty->Struct && IsPlainOldData(SrcProperty))
+		{
+			Converter->Kind = EConvertKind::Memcpy;
+			return Converter;
+		}
+		Converter->Kind = EConvertKind::Struct;
+		Converter->StructMapping = FindBuilding(FCacheKey(SrcStructProperty->Struct, DstStructProperty->Struct));
+		if (!Converter->StructMapping)
+		{
+			Converter->StructMappingOwner = Get(SrcStructProperty->Struct, DstStructProperty->Struct);
+			Converter->StructMapping = Converter->StructMappingOwner.Get();
+		}
+		return Converter->StructMapping ? Converter : nullptr;
+	}
+
+	const UEnum* SrcEnum = nullptr;
+	const UEnum* DstEnum = nullptr;
+	Converter->SrcNumeric = GetNumeric(SrcProperty, SrcEnum);
+	Converter->DstNumeric = GetNumeric(DstProperty, DstEnum);
+	if (Converter->SrcNumeric && Converter->DstNumeric)
+	{
+		if (SrcEnum && DstEnum && SrcEnum != DstEnum)
+		{
+			// 枚举按名称对应，编译期建好数值映射表
+			Converter->Kind = EConvertKind::Enum;
+			Converter->SrcEnum = SrcEnum;
+			Converter->DstEnum = DstEnum;
+			for (int32 Index = 0; Index < SrcEnum->NumEnums(); ++Index)
+			{
+				const int64 DstValue = DstEnum->GetValueByNameString(SrcEnum->GetNameStringByIndex(Index));
+				if (DstValue != INDEX_NONE)
+				{
+					Converter->EnumValues.Add(SrcEnum->GetValueByIndex(Index), DstValue);
+				}
+			}
+			return Converter;
+		}
+		const bool bSameNumeric = Converter->SrcNumeric->GetClass() == Converter->DstNumeric->GetClass();
+		Converter->Kind = bSameNumeric ? EConvertKind::Memcpy : EConvertKind::Numeric;
+		return Converter;
+	}
+
+	if (SrcProperty->SameType(DstProperty))
+	{
+		Converter->Kind = IsPlainOldData(SrcProperty) ? EConvertKind::Memcpy : EConvertKind::CopyValue;
+		return Converter;
+	}
+
+	if (const FArrayProperty* SrcArray = CastField<FArrayProperty>(SrcProperty))
+	{
+		if (const FArrayProperty* DstArray = CastField<FArrayProperty>(DstProperty))
+		{
+			Converter->Kind = EConvertKind::Array;
+			Converter->Inner = MakeConverter(SrcArray->Inner, DstArray->Inner);
+			return Converter->Inner.IsValid() ? Converter : nullptr;
+		}
+	}
+	else if (const FSetProperty* SrcSet = CastField<FSetProperty>(SrcProperty))
+	{
+		if (const FSetProperty* DstSet = CastField<FSetProperty>(DstProperty))
+		{
+			Converter->Kind = EConvertKind::Set;
+			Converter->Inner = MakeConverter(SrcSet->ElementProp, DstSet->ElementProp);
+			return Converter->Inner.IsValid() ? Converter : nullptr;
+		}
+	}
+	else if (const FMapProperty* SrcMap = CastField<FMapProperty>(SrcProperty))
+	{
+		if (const FMapProperty* DstMap = CastField<FMapProperty>(DstProperty))
+		{
+			Converter->Kind = EConvertKind::Map;
+			Converter->Inner = MakeConverter(SrcMap->KeyProp, DstMap->KeyProp);
+			Converter->Value = MakeConverter(SrcMap->ValueProp, DstMap->ValueProp);
+			return Converter->Inner.IsValid() && Converter->Value.IsValid() ? Converter : nullptr;
+		}
+	}
+	else if (SrcProperty->IsA<FNameProperty>() && DstProperty->IsA<FStrProperty>())
+	{
+		Converter->Kind = EConvertKind::NameToString;
+		return Converter;
+	}
+	else if (SrcProperty->IsA<FStrProperty>() && DstProperty->IsA<FNameProperty>())
+	{
+		Converter->Kind = EConvertKind::StringToName;
+		return Converter;
+	}
+	return nullptr;
+}
+
+bool FReflectionStructMapping::FConverter::IsInjective() const
+{
+	return Kind == EConvertKind::Memcpy || Kind == EConvertKind::CopyValue || Kind == EConvertKind::Bool
+		|| Kind == EConvertKind::NameToString;
+}
+
+bool FReflectionStructMapping::FConverter::Convert(const void* Src, void* Dst) const
+{
+	using namespace ReflectionStructMapping;
+	switch (Kind)
+	{
+	case EConvertKind::Memcpy:
+		FMemory::Memcpy(Dst, Src, Size);
+		break;
+	case EConvertKind::CopyValue:
+		DstProperty->CopySingleValue(Dst, Src);
+		break;
+	case EConvertKind::Bool:
+		static_cast<const FBoolProperty*>(DstProperty)->SetPropertyValue(Dst,
+			static_cast<const FBoolProperty*>(SrcProperty)->GetPropertyValue(Src));
+		break;
+	case EConvertKind::Numeric:
+		if (SrcNumeric->IsFloatingPoint())
+		{
+			const double Value = SrcNumeric->GetFloatingPointPropertyValue(Src);
+			if (DstNumeric->IsFloatingPoint())
+				DstNumeric->SetFloatingPointPropertyValue(Dst, Value);
+			else
+				DstNumeric->SetIntPropertyValue(Dst, FMath::RoundToInt64(Value));
+		}
+		else
+		{
+			const int64 Value = SrcNumeric->GetSignedIntPropertyValue(Src);
+			if (DstNumeric->IsFloatingPoint())
+				DstNumeric->SetFloatingPointPropertyValue(Dst, static_cast<double>(Value));
+			else
+				DstNumeric->SetIntPropertyValue(Dst, Value);
+		}
+		break;
+	case EConvertKind::Enum:
+		{
+			const int64 SrcValue = SrcNumeric->GetSignedIntPropertyValue(Src);
+			if (const int64* DstValue = EnumValues.Find(SrcValue))
+			{
+				DstNumeric->SetIntPropertyValue(Dst, *DstValue);
+				break;
+			}
+			UE_LOG(ReflectionTool, Warning, TEXT("CopyStructByName: %s::%s has no counterpart in %s, value not converted"),
+				*SrcEnum->GetName(), *SrcEnum->GetNameStringByValue(SrcValue), *DstEnum->GetName());
+			return false;
+		}
+	case EConvertKind::Struct:
+		StructMapping->Copy(Src, Dst);
+		break;
+	case EConvertKind::Array:
+		{
+			FScriptArrayHelper SrcHelper(static_cast<const FArrayProperty*>(SrcProperty), Src);
+			FScriptArrayHelper DstHelper(static_cast<const FArrayProperty*>(DstProperty), Dst);
+			const int32 Num = SrcHelper.Num();
+			DstHelper.EmptyAndAddValues(Num);
+			for (int32 Index = 0; Index < Num; ++Index)
+			{
+				Inner->Convert(SrcHelper.GetRawPtr(Index), DstHelper.GetRawPtr(Index));
+			}
+		}
+		break;
+	case EConvertKind::Set:
+		{
+			FScriptSetHelper SrcHelper(static_cast<const FSetProperty*>(SrcProperty), Src);
+			FScriptSetHelper DstHelper(static_cast<const FSetProperty*>(DstProperty), Dst);
+			DstHelper.EmptyElements(SrcHelper.Num());
+			if (Inner->IsInjective())
+			{
+				// 源元素互不相同，转换后也互不相同，整体重建哈希
+				for (int32 Index = 0, Remaining = SrcHelper.Num(); Remaining > 0; ++Index)
+				{
+					if (SrcHelper.IsValidIndex(Index))
+					{
+						const int32 NewIndex = DstHelper.AddDefaultValue_Invalid_NeedsRehash();
+						Inner->Convert(SrcHelper.GetElementPtr(Index), DstHelper.GetElementPtr(NewIndex));
+						--Remaining;
+					}
+				}
+				DstHelper.Rehash();
+				break;
+			}
+			// 转换可能使不同的元素变得相同（数值截断、枚举、结构体丢弃字段），先转换到临时值再查重
+			const FProperty* ElementProp = Inner->DstProperty;
+			FScopedElement Element(ElementProp, FMemory_Alloca_Aligned(ElementProp->GetSize(), ElementProp->GetMinAlignment()));
+			for (int32 Index = 0, Remaining = SrcHelper.Num(); Remaining > 0; ++Index)
+			{
+				if (SrcHelper.IsValidIndex(Index))
+				{
+					--Remaining;
+					ElementProp->ClearValue(Element.Data);
+					if (Inner->Convert(SrcHelper.GetElementPtr(Index), Element.Data) && DstHelper.FindElementIndex(Element.Data) == INDEX_NONE)
+					{
+						DstHelper.AddElement(Element.Data);
+					}
+				}
+			}
+		}
+		break;
+	case EConvertKind::Map:
+		{
+			FScriptMapHelper SrcHelper(static_cast<const FMapProperty*>(SrcProperty), Src);
+			FScriptMapHelper DstHelper(static_cast<const FMapProperty*>(DstProperty), Dst);
+			DstHelper.EmptyValues(SrcHelper.Num());
+			if (Inner->IsInjective())
+			{
+				for (int32 Index = 0, Remaining = SrcHelper.Num(); Remaining > 0; ++Index)
+				{
+					if (SrcHelper.IsValidIndex(Index))
+					{
+						const int32 NewIndex = DstHelper.AddDefaultValue_Invalid_NeedsRehash();
+						Inner->Convert(SrcHelper.GetKeyPtr(Index), DstHelper.GetKeyPtr(NewIndex));
+						Value->Convert(SrcHelper.GetValuePtr(Index), DstHelper.GetValuePtr(NewIndex));
+						--Remaining;
+					}
+				}
+				DstHelper.Rehash();
+				break;
+			}
+			// 与 Set 相同，Key 先转换到临时值，已存在的 Key 保留第一个
+			const FProperty* KeyProp = Inner->DstProperty;
+			const FProperty* ValueProp = Value->DstProperty;
+			FScopedElement Key(KeyProp, FMemory_Alloca_Aligned(KeyProp->GetSize(), KeyProp->GetMinAlignment()));
+			FScopedElement Val(ValueProp, FMemory_Alloca_Aligned(ValueProp->GetSize(), ValueProp->GetMinAlignment()));
+			for (int32 Index = 0, Remaining = SrcHelper.Num(); Remaining > 0; ++Index)
+			{
+				if (SrcHelper.IsValidIndex(Index))
+				{
+					--Remaining;
+					KeyProp->ClearValue(Key.Data);
+					if (!Inner->Convert(SrcHelper.GetKeyPtr(Index), Key.Data) || DstHelper.FindMapIndexWithKey(Key.Data) != INDEX_NONE)
+						continue;
+					ValueProp->ClearValue(Val.Data);
+					Value->Convert(SrcHelper.GetValuePtr(Index), Val.Data);
+					DstHelper.AddPair(Key.Data, Val.Data);
+				}
+			}
+		}
+		break;
+	case EConvertKind::NameToString:
+		*static_cast<FString*>(Dst) = static_cast<const FName*>(Src)->ToString();
+		break;
+	case EConvertKind::StringToName:
+		*static_cast<FName*>(Dst) = FName(**static_cast<const FString*>(Src));
+		break;
+	}
+	return true;
+}
+
+void FReflectionStructMapping::Copy(const void* Src, void* Dst) const
+{
+	if (SameLayout.IsValid())
+	{
+		SameLayout->Copy(Dst, Src);
+		return;
+	}
+
+	const uint8* SrcBase = static_cast<const uint8*>(Src);
+	uint8* DstBase = static_cast<uint8*>(Dst);
+	for (const FFieldOp& Op : Ops)
+	{
+		const uint8* SrcAddr = SrcBase + Op.SrcOffset;
+		uint8* DstAddr = DstBase + Op.DstOffset;
+		if (!Op.Converter.IsValid())
+		{
+			FMemory::Memcpy(DstAddr, SrcAddr, Op.Size);
+			continue;
+		}
+		for (int32 Index = 0; Index < Op.Count; ++Index)
+		{
+			Op.Converter->Convert(SrcAddr + Index * Op.SrcStride, DstAddr + Index * Op.DstStride);
+		}
+	}
+}
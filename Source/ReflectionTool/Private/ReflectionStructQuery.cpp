@@ -0,0 +1,547 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#include "ReflectionStructQuery.h"
+
+#include "ReflectionToolLib.h"
+#include "Async/ParallelFor.h"
+#include "Misc/ScopeLock.h"
+
+namespace ReflectionStructQuery
+{
+	using FCacheKey = TPair<const UStruct*, FString>;
+
+	FCriticalSection CacheLock;
+	TMap<FCacheKey, TSharedPtr<const FReflectionStructQuery>> Cache;
+
+	template<typename ValueType>
+	FORCEINLINE bool CompareValues(uint8 Op, const ValueType& A, const ValueType& B)
+	{
+		switch (Op)
+		{
+		case 0: return A == B;
+		case 1: return !(A == B);
+		case 2: return A < B;
+		case 3: return A <= B;
+		case 4: return A > B;
+		default: return A >= B;
+		}
+	}
+}
+
+/**
+ * 递归下降解析：
+ * Or := And ('||' And)*；And := Unary ('&&' Unary)*；Unary := '!' Unary | '(' Or ')' | Path [Op Literal]
+ */
+struct FReflectionStructQueryParser
+{
+	using ECompareOp = FReflectionStructQuery::ECompareOp;
+	using ELoad = FReflectionStructQuery::ELoad;
+	using ENodeKind = FReflectionStructQuery::ENodeKind;
+
+	enum class ETokenKind : uint8
+	{
+		End,
+		Identifier,
+		Number,
+		String,
+		Compare,
+		And,
+		Or,
+		Not,
+		LParen,
+		RParen,
+	};
+
+	struct FToken
+	{
+		ETokenKind Kind = ETokenKind::End;
+		FString Text;
+		ECompareOp Op = ECompareOp::Equal;
+	};
+
+	FReflectionStructQueryParser(FReflectionStructQuery& InQuery, const UStruct* InStruct, const FString& InExpression)
+		: Query(InQuery)
+		, Struct(InStruct)
+		, Expression(InExpression)
+	{
+	}
+
+	bool Parse()
+	{
+		if (!Tokenize())
+			return false;
+		Query.RootNode = ParseOr();
+		if (Query.RootNode == INDEX_NONE)
+			return false;
+		if (Peek().Kind != ETokenKind::End)
+			return Fail(FString::Printf(TEXT("unexpected '%s'"), *Peek().Text));
+		return true;
+	}
+
+	FString Error;
+
+private:
+	bool Fail(const FString& Message)
+	{
+		if (Error.IsEmpty())
+		{
+			Error = Message;
+		}
+		return false;
+	}
+
+	const FToken& Peek() const { return Tokens[Cursor]; }
+	const FToken& Next() { return Tokens[Cursor < Tokens.Num() - 1 ? Cursor++ : Cursor]; }
+
+	static bool IsIdentifierStart(TCHAR Char) { return FChar::IsAlpha(Char) || Char == TEXT('_'); }
+
+	bool Tokenize()
+	{
+		const int32 Len = Expression.Len();
+		int32 Index = 0;
+		while (Index < Len)
+		{
+			const TCHAR Char = Expression[Index];
+			const TCHAR NextChar = Index + 1 < Len ? Expression[Index + 1] : TEXT('\0');
+			if (FChar::IsWhitespace(Char))
+			{
+				++Index;
+				continue;
+			}
+
+			FToken& Token = Tokens.AddDefaulted_GetRef();
+			if (Char == TEXT('('))
+			{
+				Token.Kind = ETokenKind::LParen;
+				++Index;
+			}
+			else if (Char == TEXT(')'))
+			{
+				Token.Kind = ETokenKind::RParen;
+				++Index;
+			}
+			else if (Char == TEXT('&') && NextChar == TEXT('&'))
+			{
+				Token.Kind = ETokenKind::And;
+				Index += 2;
+			}
+			else if (Char == TEXT('|') && NextChar == TEXT('|'))
+			{
+				Token.Kind = ETokenKind::Or;
+				Index += 2;
+			}
+			else if (Char == TEXT('!') || Char == TEXT('=') || Char == TEXT('<') || Char == TEXT('>'))
+			{
+				const bool bWithEqual = NextChar == TEXT('=');
+				Token.Kind = ETokenKind::Compare;
+				switch (Char)
+				{
+				case TEXT('!'):
+					Token.Kind = bWithEqual ? ETokenKind::Compare : ETokenKind::Not;
+					Token.Op = ECompareOp::NotEqual;
+					break;
+				case TEXT('='): Token.Op = ECompareOp::Equal; break;
+				case TEXT('<'): Token.Op = bWithEqual ? ECompareOp::LessEqual : ECompareOp::Less; break;
+				default: Token.Op = bWithEqual ? ECompareOp::GreaterEqual : ECompareOp::Greater; break;
+				}
+				Token.Text = Expression.Mid(Index, bWithEqual ? 2 : 1);
+				Index += bWithEqual ? 2 : 1;
+			}
+			else if (Char == TEXT('"') || Char == TEXT('\''))
+			{
+				Token.Kind = ETokenKind::String;
+				++Index;
+				while (Index < Len && Expression[Index] != Char)
+				{
+					if (Expression[Index] == TEXT('\\') && Index + 1 < Len)
+					{
+						++Index;
+					}
+					Token.Text.AppendChar(Expression[Index++]);
+				}
+				if (Index >= Len)
+					return Fail(TEXT("unterminated string"));
+				++Index;
+			}
+			else if (FChar::IsDigit(Char) || ((Char == TEXT('-') || Char == TEXT('.')) && FChar::IsDigit(NextChar)))
+			{
+				Token.Kind = ETokenKind::Number;
+				const int32 Start = Index++;
+				while (Index < Len)
+				{
+					const TCHAR C = Expression[Index];
+					const bool bExponentSign = (C == TEXT('-') || C == TEXT('+')) && (Expression[Index - 1] == TEXT('e') || Expression[Index - 1] == TEXT('E'));
+					if (!FChar::IsDigit(C) && C != TEXT('.') && C != TEXT('e') && C != TEXT('E') && !bExponentSign)
+						break;
+					++Index;
+				}
+				Token.Text = Expression.Mid(Start, Index - Start);
+			}
+			else if (IsIdentifierStart(Char))
+			{
+				// 标识符包含完整的属性路径："Items[3].Stats.Damage"、"Attributes[\"Move Speed\"]"、"EType::Weapon"
+				Token.Kind = ETokenKind::Identifier;
+				const int32 Start = Index;
+				int32 BracketDepth = 0;
+				TCHAR Quote = TEXT('\0');
+				while (Index < Len)
+				{
+					const TCHAR C = Expression[Index];
+					if (Quote != TEXT('\0'))
+					{
+						if (C == Quote) Quote = TEXT('\0');
+					}
+					else if (BracketDepth > 0)
+					{
+						if (C == TEXT('"') || C == TEXT('\'')) Quote = C;
+						else if (C == TEXT('[')) ++BracketDepth;
+						else if (C == TEXT(']')) --BracketDepth;
+					}
+					else if (C == TEXT('['))
+					{
+						++BracketDepth;
+					}
+					else if (!FChar::IsAlnum(C) && C != TEXT('_') && C != TEXT('.') && C != TEXT(':'))
+					{
+						break;
+					}
+					++Index;
+				}
+				Token.Text = Expression.Mid(Start, Index - Start);
+			}
+			else
+			{
+				return Fail(FString::Printf(TEXT("unexpected character '%c'"), Char));
+			}
+		}
+		Tokens.AddDefaulted();
+		return true;
+	}
+
+	int32 AddNode(ENodeKind Kind, int32 Left, int32 Right = INDEX_NONE)
+	{
+		FReflectionStructQuery::FNode& Node = Query.Nodes.AddDefaulted_GetRef();
+		Node.Kind = Kind;
+		Node.Left = Left;
+		Node.Right = Right;
+		return Query.Nodes.Num() - 1;
+	}
+
+	int32 ParseOr()
+	{
+		int32 Left = ParseAnd();
+		while (Left != INDEX_NONE && Peek().Kind == ETokenKind::Or)
+		{
+			Next();
+			const int32 Right = ParseAnd();
+			if (Right == INDEX_NONE)
+				return INDEX_NONE;
+			Left = AddNode(ENodeKind::Or, Left, Right);
+		}
+		return Left;
+	}
+
+	int32 ParseAnd()
+	{
+		int32 Left = ParseUnary();
+		while (Left != INDEX_NONE && Peek().Kind == ETokenKind::And)
+		{
+			Next();
+			const int32 Right = ParseUnary();
+			if (Right == INDEX_NONE)
+				return INDEX_NONE;
+			Left = AddNode(ENodeKind::And, Left, Right);
+		}
+		return Left;
+	}
+
+	int32 ParseUnary()
+	{
+		const FToken& Token = Next();
+		switch (Token.Kind)
+		{
+		case ETokenKind::Not:
+			{
+				const int32 Operand = ParseUnary();
+				return Operand == INDEX_NONE ? INDEX_NONE : AddNode(ENodeKind::Not, Operand);
+			}
+		case ETokenKind::LParen:
+			{
+				const int32 Inner = ParseOr();
+				if (Inner == INDEX_NONE)
+					return INDEX_NONE;
+				if (Next().Kind != ETokenKind::RParen)
+				{
+					Fail(TEXT("missing ')'"));
+					return INDEX_NONE;
+				}
+				return Inner;
+			}
+		case ETokenKind::Identifier:
+			return ParseComparison(Token.Text);
+		default:
+			Fail(FString::Printf(TEXT("expected field, got '%s'"), *Token.Text));
+			return INDEX_NONE;
+		}
+	}
+
+	int32 ParseComparison(const FString& PathString)
+	{
+		FReflectionStructQuery::FPredicate Predicate;
+		Predicate.Path = FReflectionPropertyPath::Compile(Struct, PathString);
+		if (!Predicate.Path.IsValid() || Predicate.Path->GetLeafArrayDim() != 1)
+		{
+			Fail(FString::Printf(TEXT("invalid field '%s'"), *PathString));
+			return INDEX_NONE;
+		}
+		Predicate.Offset = Predicate.Path->GetFixedOffset();
+
+		FToken Literal;
+		if (Peek().Kind == ETokenKind::Compare)
+		{
+			Predicate.Op = Next().Op;
+			Literal = Next();
+			if (Literal.Kind != ETokenKind::Identifier && Literal.Kind != ETokenKind::Number && Literal.Kind != ETokenKind::String)
+			{
+				Fail(FString::Printf(TEXT("expected value after '%s'"), *PathString));
+				return INDEX_NONE;
+			}
+		}
+		else
+		{
+			// 单独的字段：bool 字段为真
+			Literal.Kind = ETokenKind::Identifier;
+			Literal.Text = TEXT("true");
+		}
+
+		if (!BindLiteral(Predicate, Literal))
+			return INDEX_NONE;
+		Query.Predicates.Add(MoveTemp(Predicate));
+		return AddNode(ENodeKind::Predicate, Query.Predicates.Num() - 1);
+	}
+
+	static bool GetNumericLoad(const FNumericProperty* NumericProperty, ELoad& OutLoad)
+	{
+		if (NumericProperty->IsA<FInt8Property>()) OutLoad = ELoad::Int8;
+		else if (NumericProperty->IsA<FInt16Property>()) OutLoad = ELoad::Int16;
+		else if (NumericProperty->IsA<FIntProperty>()) OutLoad = ELoad::Int32;
+		else if (NumericProperty->IsA<FInt64Property>()) OutLoad = ELoad::Int64;
+		else if (NumericProperty->IsA<FByteProperty>()) OutLoad = ELoad::UInt8;
+		else if (NumericProperty->IsA<FUInt16Property>()) OutLoad = ELoad::UInt16;
+		else if (NumericProperty->IsA<FUInt32Property>()) OutLoad = ELoad::UInt32;
+		else if (NumericProperty->IsA<FUInt64Property>()) OutLoad = ELoad::UInt64;
+		else if (NumericProperty->IsA<FFloatProperty>()) OutLoad = ELoad::Float;
+		else if (NumericProperty->IsA<FDoubleProperty>()) OutLoad = ELoad::Double;
+		else return false;
+		return true;
+	}
+
+	bool BindLiteral(FReflectionStructQuery::FPredicate& Predicate, const FToken& Literal)
+	{
+		using ELeafKind = FReflectionPropertyPath::ELeafKind;
+		const FReflectionPropertyPath& Path = *Predicate.Path;
+		const bool bEquality = Predicate.Op == ECompareOp::Equal || Predicate.Op == ECompareOp::NotEqual;
+
+		switch (Path.LeafKind)
+		{
+		case ELeafKind::Bool:
+			if (!bEquality)
+				return Fail(FString::Printf(TEXT("'%s' only supports == and !="), *Path.PathString));
+			Predicate.Load = ELoad::Bool;
+			Predicate.BoolProperty = CastFieldChecked<FBoolProperty>(Path.LeafProperty);
+			if (Literal.Text.Equals(TEXT("true"), ESearchCase::IgnoreCase) || Literal.Text == TEXT("1"))
+				Predicate.bBoolValue = true;
+			else if (Literal.Text.Equals(TEXT("false"), ESearchCase::IgnoreCase) || Literal.Text == TEXT("0"))
+				Predicate.bBoolValue = false;
+			else
+				return Fail(FString::Printf(TEXT("'%s' is not a bool value"), *Literal.Text));
+			return true;
+		case ELeafKind::Enum:
+			GetNumericLoad(Path.LeafNumeric, Predicate.Load);
+			if (Literal.Kind == ETokenKind::Number)
+			{
+				Predicate.IntValue = FCString::Atoi64(*Literal.Text);
+			}
+			else
+			{
+				Predicate.IntValue = Path.LeafEnum->GetValueByNameString(Literal.Text);
+				if (Predicate.IntValue == INDEX_NONE)
+					return Fail(FString::Printf(TEXT("'%s' is not a value of %s"), *Literal.Text, *Path.LeafEnum->GetName()));
+			}
+			return true;
+		case ELeafKind::Integer:
+		case ELeafKind::Float:
+			if (Literal.Kind != ETokenKind::Number)
+				return Fail(FString::Printf(TEXT("'%s' expects a number"), *Path.PathString));
+			GetNumericLoad(Path.LeafNumeric, Predicate.Load);
+			Predicate.FloatValue = FCString::Atod(*Literal.Text);
+			Predicate.IntValue = FCString::Atoi64(*Literal.Text);
+			Predicate.bCompareAsDouble = Path.LeafKind == ELeafKind::Integer
+				&& static_cast<double>(Predicate.IntValue) != Predicate.FloatValue;
+			return true;
+		case ELeafKind::String:
+			Predicate.Load = ELoad::String;
+			Predicate.StringValue = Literal.Text;
+			return true;
+		case ELeafKind::Name:
+			if (!bEquality)
+				return Fail(FString::Printf(TEXT("'%s' only supports == and !="), *Path.PathString));
+			Predicate.Load = ELoad::Name;
+			Predicate.NameValue = FName(*Literal.Text);
+			return true;
+		default:
+			return Fail(FString::Printf(TEXT("'%s' has an unsupported type"), *Path.PathString));
+		}
+	}
+
+	FReflectionStructQuery& Query;
+	const UStruct* Struct;
+	const FString& Expression;
+	TArray<FToken> Tokens;
+	int32 Cursor = 0;
+};
+
+template<typename NumberType>
+FORCEINLINE bool FReflectionStructQuery::FPredicate::CompareNumber(NumberType Value) const
+{
+	if constexpr (std::is_floating_point_v<NumberType>)
+	{
+		return ReflectionStructQuery::CompareValues(static_cast<uint8>(Op), static_cast<double>(Value), FloatValue);
+	}
+	else
+	{
+		if (bCompareAsDouble)
+			return ReflectionStructQuery::CompareValues(static_cast<uint8>(Op), static_cast<double>(Value), FloatValue);
+		return ReflectionStructQuery::CompareValues(static_cast<uint8>(Op), static_cast<int64>(Value), IntValue);
+	}
+}
+
+bool FReflectionStructQuery::FPredicate::Evaluate(const uint8* Element) const
+{
+	const void* Addr = Offset != INDEX_NONE ? Element + Offset : Path->ResolveLeaf(Element);
+	if (!Addr)
+		return false;
+	switch (Load)
+	{
+	case ELoad::Int8: return CompareNumber(*static_cast<const int8*>(Addr));
+	case ELoad::Int16: return CompareNumber(*static_cast<const int16*>(Addr));
+	case ELoad::Int32: return CompareNumber(*static_cast<const int32*>(Addr));
+	case ELoad::Int64: return CompareNumber(*static_cast<const int64*>(Addr));
+	case ELoad::UInt8: return CompareNumber(*static_cast<const uint8*>(Addr));
+	case ELoad::UInt16: return CompareNumber(*static_cast<const uint16*>(Addr));
+	case ELoad::UInt32: return CompareNumber(*static_cast<const uint32*>(Addr));
+	case ELoad::UInt64: return CompareNumber(*static_cast<const uint64*>(Addr));
+	case ELoad::Float: return CompareNumber(*static_cast<const float*>(Addr));
+	case ELoad::Double: return CompareNumber(*static_cast<const double*>(Addr));
+	case ELoad::Bool: return (BoolProperty->GetPropertyValue(Addr) == bBoolValue) == (Op == ECompareOp::Equal);
+	case ELoad::String:
+		return ReflectionStructQuery::CompareValues(static_cast<uint8>(Op),
+			static_cast<const FString*>(Addr)->Compare(StringValue, ESearchCase::CaseSensitive), 0);
+	case ELoad::Name: return (*static_cast<const FName*>(Addr) == NameValue) == (Op == ECompareOp::Equal);
+	default: return false;
+	}
+}
+
+bool FReflectionStructQuery::EvaluateNode(int32 NodeIndex, const uint8* Element) const
+{
+	const FNode& Node = Nodes[NodeIndex];
+	switch (Node.Kind)
+	{
+	case ENodeKind::And: return EvaluateNode(Node.Left, Element) && EvaluateNode(Node.Right, Element);
+	case ENodeKind::Or: return EvaluateNode(Node.Left, Element) || EvaluateNode(Node.Right, Element);
+	case ENodeKind::Not: return !EvaluateNode(Node.Left, Element);
+	default: return Predicates[Node.Left].Evaluate(Element);
+	}
+}
+
+bool FReflectionStructQuery::Matches(const void* Element) const
+{
+	return RootNode != INDEX_NONE && Element && EvaluateNode(RootNode, static_cast<const uint8*>(Element));
+}
+
+void FReflectionStructQuery::Filter(const void* Elements, int32 Num, int32 Stride, TArray<int32>& OutIndices) const
+{
+	OutIndices.Reset();
+	if (RootNode == INDEX_NONE || !Elements || Num <= 0)
+		return;
+
+	const uint8* Base = static_cast<const uint8*>(Elements);
+	if (Num < ParallelThreshold)
+	{
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			if (EvaluateNode(RootNode, Base + static_cast<SIZE_T>(Index) * Stride))
+			{
+				OutIndices.Add(Index);
+			}
+		}
+		return;
+	}
+
+	// 按块并行，每块单独收集结果，最后按块顺序合并，保证下标升序
+	const int32 NumChunks = FMath::DivideAndRoundUp(Num, ParallelThreshold);
+	TArray<TArray<int32>> ChunkResults;
+	ChunkResults.SetNum(NumChunks);
+	ParallelFor(NumChunks, [this, Base, Num, Stride, &ChunkResults](int32 Chunk)
+	{
+		const int32 Begin = Chunk * ParallelThreshold;
+		const int32 End = FMath::Min(Begin + ParallelThreshold, Num);
+		TArray<int32>& Result = ChunkResults[Chunk];
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			if (EvaluateNode(RootNode, Base + static_cast<SIZE_T>(Index) * Stride))
+			{
+				Result.Add(Index);
+			}
+		}
+	});
+
+	int32 Total = 0;
+	for (const TArray<int32>& Result : ChunkResults)
+	{
+		Total += Result.Num();
+	}
+	OutIndices.Reserve(Total);
+	for (const TArray<int32>& Result : ChunkResults)
+	{
+		OutIndices.Append(Result);
+	}
+}
+
+TSharedPtr<const FReflectionStructQuery> FReflectionStructQuery::Compile(const UStruct* ElementStruct, const FString& Expression)
+{
+	if (!ElementStruct || Expression.IsEmpty())
+		return nullptr;
+
+	const ReflectionStructQuery::FCacheKey Key(ElementStruct, Expression);
+	{
+		FScopeLock Lock(&ReflectionStructQuery::CacheLock);
+		if (const TSharedPtr<const FReflectionStructQuery>* Found = ReflectionStructQuery::Cache.Find(Key))
+		{
+			if ((*Found)->ElementStruct.Get() == ElementStruct)
+			{
+				return *Found;
+			}
+		}
+	}
+
+	TSharedPtr<FReflectionStructQuery> Query = MakeShared<FReflectionStructQuery>();
+	Query->ElementStruct = ElementStruct;
+	Query->Expression = Expression;
+	FReflectionStructQueryParser Parser(*Query, ElementStruct, Expression);
+	if (!Parser.Parse())
+	{
+		UE_LOG(ReflectionTool, Warning, TEXT("CompileStructQuery failed: [%s] on [%s]: %s"), *Expression, *ElementStruct->GetName(), *Parser.Error);
+		return nullptr;
+	}
+
+	FScopeLock Lock(&ReflectionStructQuery::CacheLock);
+	ReflectionStructQuery::Cache.Add(Key, Query);
+	return Query;
+}
+
+void FReflectionStructQuery::ClearCache()
+{
+	FScopeLock Lock(&ReflectionStructQuery::CacheLock);
+	ReflectionStructQuery::Cache.Empty();
+}
@@ -0,0 +1,207 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#include "ReflectionStructSnapshot.h"
+
+#include "ReflectionStructLayout.h"
+#include "ReflectionToolStats.h"
+#include "Async/Async.h"
+#include "JsonObjectConverter.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "UObject/GarbageCollection.h"
+
+namespace ReflectionStructSnapshot
+{
+	// 工作线程上转换时阻止 GC，快照引用的对象及其 Outer 链在转换期间保持稳定
+	struct FConvertScope
+	{
+		FConvertScope()
+		{
+			if (!IsInGameThread())
+			{
+				GCGuard.Emplace();
+			}
+		}
+
+		TOptional<FGCScopeGuard> GCGuard;
+	};
+}
+
+FReflectionStructSnapshot::FReflectionStructSnapshot(const UStruct* InStruct)
+	: Struct(InStruct)
+{
+	Data = static_cast<uint8*>(FMemory::Malloc(FMath::Max(InStruct->GetStructureSize(), 1), InStruct->GetMinAlignment()));
+	InStruct->InitializeStruct(Data);
+}
+
+FReflectionStructSnapshot::~FReflectionStructSnapshot()
+{
+	if (Struct)
+	{
+		Struct->DestroyStruct(Data);
+	}
+	FMemory::Free(Data);
+}
+
+TSharedRef<FReflectionStructSnapshot> FReflectionStructSnapshot::Capture(const UStruct* Struct, const void* Data)
+{
+	REFLECTIONTOOL_SCOPE(CaptureSnapshot);
+	check(Struct && Data);
+	TSharedRef<FReflectionStructSnapshot> Snapshot = MakeShareable(new FReflectionStructSnapshot(Struct));
+	FReflectionStructLayout::Get(Struct)->Copy(Snapshot->Data, Data);
+	return Snapshot;
+}
+
+TSharedRef<FReflectionStructSnapshot> FReflectionStructSnapshot::CaptureObject(const UObject* Object)
+{
+	check(Object);
+	// 布局只包含 UPROPERTY，按原偏移拷贝到与类同样大小的缓冲，UObject 自身的数据不拷贝
+	return Capture(Object->GetClass(), Object);
+}
+
+TSharedRef<FReflectionStructSnapshot> FReflectionStructSnapshot::CreateEmpty(const UStruct* Struct)
+{
+	check(Struct);
+	return MakeShareable(new FReflectionStructSnapshot(Struct));
+}
+
+void FReflectionStructSnapshot::CaptureProperty(const FProperty* Property, const void* Container)
+{
+	REFLECTIONTOOL_SCOPE(CaptureSnapshot);
+	check(Property && Container && Property->GetOwnerStruct() && Struct->IsChildOf(Property->GetOwnerStruct()));
+	Property->CopyCompleteValue_InContainer(Data, Container);
+}
+
+int32 FReflectionStructSnapshot::CaptureContainerElements(const FProperty* Property, const void* Container, int32 StartIndex, int32 Count)
+{
+	REFLECTIONTOOL_SCOPE(CaptureSnapshot);
+	check(Property && Container && Count > 0 && StartIndex >= 0 && Property->GetOwnerStruct() && Struct->IsChildOf(Property->GetOwnerStruct()));
+	const void* SourceAddr = Property->ContainerPtrToValuePtr<void>(Container);
+	void* TargetAddr = Property->ContainerPtrToValuePtr<void>(Data);
+	if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+	{
+		FScriptArrayHelper Source(ArrayProperty, SourceAddr);
+		FScriptArrayHelper Target(ArrayProperty, TargetAddr);
+		// 先按源数组等长分配默认值，之后逐段覆盖
+		if (StartIndex == 0)
+		{
+			Target.Resize(Source.Num());
+		}
+		const int32 EndIndex = FMath::Min3(StartIndex + Count, Source.Num(), Target.Num());
+		for (int32 Index = StartIndex; Index < EndIndex; ++Index)
+		{
+			ArrayProperty->Inner->CopyCompleteValue(Target.GetRawPtr(Index), Source.GetRawPtr(Index));
+		}
+		return EndIndex < Source.Num() ? EndIndex : INDEX_NONE;
+	}
+	// Set / Map 逐个元素加入并计算哈希，源容器在两段之间被修改时也不会产生重复的键
+	if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+	{
+		FScriptSetHelper Source(SetProperty, SourceAddr);
+		FScriptSetHelper Target(SetProperty, TargetAddr);
+		if (StartIndex == 0)
+		{
+			Target.EmptyElements(Source.Num());
+		}
+		int32 Index = StartIndex;
+		for (int32 Copied = 0; Index < Source.GetMaxIndex() && Copied < Count; ++Index)
+		{
+			if (Source.IsValidIndex(Index))
+			{
+				Target.AddElement(Source.GetElementPtr(Index));
+				++Copied;
+			}
+		}
+		return Index < Source.GetMaxIndex() ? Index : INDEX_NONE;
+	}
+	if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+	{
+		FScriptMapHelper Source(MapProperty, SourceAddr);
+		FScriptMapHelper Target(MapProperty, TargetAddr);
+		if (StartIndex == 0)
+		{
+			Target.EmptyValues(Source.Num());
+		}
+		int32 Index = StartIndex;
+		for (int32 Copied = 0; Index < Source.GetMaxIndex() && Copied < Count; ++Index)
+		{
+			if (Source.IsValidIndex(Index))
+			{
+				Target.AddPair(Source.GetKeyPtr(Index), Source.GetValuePtr(Index));
+				++Copied;
+			}
+		}
+		return Index < Source.GetMaxIndex() ? Index : INDEX_NONE;
+	}
+	Property->CopyCompleteValue_InContainer(Data, Container);
+	return INDEX_NONE;
+}
+
+void FReflectionStructSnapshot::ToPPS(FPropertyParserStruct& OutPropertyParserStruct, const FPPSConvertOptions& Options) const
+{
+	ReflectionStructSnapshot::FConvertScope ConvertScope;
+	// 展开对象需要读取对象的实时数据，且共享对象缓存只在游戏线程访问
+	FPPSConvertOptions SnapshotOptions = Options;
+	SnapshotOptions.bExpandObjects = false;
+	FPPSConvertContext Context(SnapshotOptions);
+	UReflectionToolLib::FGetPropertyParserStruct(Data, Struct, OutPropertyParserStruct, &Context);
+}
+
+bool FReflectionStructSnapshot::ToJson(FString& OutJson) const
+{
+	ReflectionStructSnapshot::FConvertScope ConvertScope;
+	return FJsonObjectConverter::UStructToJsonObjectString(Struct, Data, OutJson);
+}
+
+void FReflectionStructSnapshot::ToBinary(TArray<uint8>& OutBytes) const
+{
+	ReflectionStructSnapshot::FConvertScope ConvertScope;
+	OutBytes.Reset();
+	FMemoryWriter Writer(OutBytes);
+	FObjectAndNameAsStringProxyArchive Archive(Writer, false);
+	Struct->SerializeBin(Archive, Data);
+}
+
+TFuture<FPropertyParserStruct> FReflectionStructSnapshot::ToPPSAsync(const FPPSConvertOptions& Options) const
+{
+	return Async(EAsyncExecution::ThreadPool, [Snapshot = AsShared(), Options]()
+	{
+		FPropertyParserStruct Result;
+		Snapshot->ToPPS(Result, Options);
+		return Result;
+	});
+}
+
+TFuture<FString> FReflectionStructSnapshot::ToJsonAsync() const
+{
+	return Async(EAsyncExecution::ThreadPool, [Snapshot = AsShared()]()
+	{
+		FString Result;
+		Snapshot->ToJson(Result);
+		return Result;
+	});
+}
+
+TFuture<TArray<uint8>> FReflectionStructSnapshot::ToBinaryAsync() const
+{
+	return Async(EAsyncExecution::ThreadPool, [Snapshot = AsShared()]()
+	{
+		TArray<uint8> Result;
+		Snapshot->ToBinary(Result);
+		return Result;
+	});
+}
+
+void FReflectionStructSnapshot::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	Collector.AddReferencedObject(Struct);
+	if (Struct)
+	{
+		Collector.AddPropertyReferences(Struct, Data);
+	}
+}
+
+FString FReflectionStructSnapshot::GetReferencerName() const
+{
+	return TEXT("FReflectionStructSnapshot");
+}
@@ -2,19 +2,116 @@
 
 #include "ReflectionTool.h"
 
+#include "ReflectionJsonStreamImporter.h"
+#include "ReflectionPropertyPath.h"
+#include "ReflectionStructArchive.h"
+#include "ReflectionStructLayout.h"
+#include "ReflectionStructMapping.h"
+#include "ReflectionStructQuery.h"
+#include "ReflectionToolLib.h"
+#include "Engine/StreamableManager.h"
+#include "UObject/UObjectGlobals.h"
+#if WITH_EDITOR
+#include "Kismet2/StructureEditorUtils.h"
+#endif
+
 #define LOCTEXT_NAMESPACE "FReflectionToolModule"
 
+namespace ReflectionToolModule
+{
+	FSimpleMulticastDelegate ReflectionDataChanging;
+	FSimpleMulticastDelegate ReflectionDataChanged;
+}
+
+#if WITH_EDITOR
+// 用户结构体重新编译时同一个 UStruct 地址不变，但 FProperty 全部重建
+class FReflectionToolStructChangeListener : public FStructureEditorUtils::INotifyOnStructChanged
+{
+public:
+	virtual void PreChange(const UUserDefinedStruct* Changed, FStructureEditorUtils::EStructureEditorChangeInfo ChangedType) override
+	{
+		ReflectionToolModule::ReflectionDataChanging.Broadcast();
+	}
+
+	virtual void PostChange(const UUserDefinedStruct* Changed, FStructureEditorUtils::EStructureEditorChangeInfo ChangedType) override
+	{
+		FReflectionToolModule::NotifyReflectionDataChanged();
+	}
+};
+#endif
+
+FReflectionToolModule::FReflectionToolModule() = default;
+
+FReflectionToolModule::~FReflectionToolModule() = default;
+
 void FReflectionToolModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+	StreamableManager = MakeUnique<FStreamableManager>();
+
+	ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([](EReloadCompleteReason)
+	{
+		NotifyReflectionDataChanged();
+	});
+	ObjectsReinstancedHandle = FCoreUObjectDelegates::OnObjectsReinstanced.AddLambda([](const TMap<UObject*, UObject*>&)
+	{
+		NotifyReflectionDataChanged();
+	});
+	// 对象图缓存的是资源与 CDO 的属性值，资源重新加载或被修改后失效
+	PackageReloadedHandle = FCoreUObjectDelegates::OnPackageReloaded.AddLambda([](EPackageReloadPhase Phase, FPackageReloadedEvent*)
+	{
+		if (Phase == EPackageReloadPhase::PostBatchPostGC)
+		{
+			UReflectionToolLib::ClearObjectGraphCache();
+		}
+	});
+#if WITH_EDITOR
+	ObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddLambda([](UObject*, FPropertyChangedEvent&)
+	{
+		UReflectionToolLib::ClearObjectGraphCache();
+	});
+	StructChangeListener = MakeUnique<FReflectionToolStructChangeListener>();
+#endif
 }
 
 void FReflectionToolModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+#if WITH_EDITOR
+	StructChangeListener.Reset();
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(ObjectPropertyChangedHandle);
+#endif
+	FCoreUObjectDelegates::OnPackageReloaded.Remove(PackageReloadedHandle);
+	FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+	FCoreUObjectDelegates::OnObjectsReinstanced.Remove(ObjectsReinstancedHandle);
+	StreamableManager.Reset();
+}
+
+void FReflectionToolModule::NotifyReflectionDataChanged()
+{
+	// 缓存只检查根结构体是否存活，无法发现同一结构体的属性被重建，因此全部丢弃
+	FReflectionPropertyPath::ClearCache();
+	FReflectionJsonStreamImporter::ClearCache();
+	FReflectionStructQuery::ClearCache();
+	FReflectionStructLayout::ClearCache();
+	FReflectionStructMapping::ClearCache();
+	FReflectionStructArchiveReader::ClearCache();
+	UReflectionToolLib::ClearObjectGraphCache();
+	UReflectionToolLib::ClearPropertyTypeNameCache();
+	ReflectionToolModule::ReflectionDataChanged.Broadcast();
+}
+
+FSimpleMulticastDelegate& FReflectionToolModule::OnReflectionDataChanging()
+{
+	return ReflectionToolModule::ReflectionDataChanging;
+}
+
+FSimpleMulticastDelegate& FReflectionToolModule::OnReflectionDataChanged()
+{
+	return ReflectionToolModule::ReflectionDataChanged;
 }
 
 #undef LOCTEXT_NAMESPACE
 	
-IMPLEMENT_MODULE(FReflectionToolModule, ReflectionTool)
\ No newline at end of file
+IMPLEMENT_MODULE(FReflectionToolModule, ReflectionTool)
@@ -4,80 +4,281 @@
 
 #include "ReflectionToolLib.h"
 
+#include "ReflectionTool.h"
+#include "ReflectionJsonStreamImporter.h"
+#include "ReflectionPPSDump.h"
+#include "ReflectionStructLayout.h"
+#include "ReflectionStructMapping.h"
+#include "ReflectionStructQuery.h"
+#include "ReflectionToolStats.h"
+#include "HelperUMG/SPPSTreeSourceView.h"
 #include "DataTableUtils.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/UserDefinedStruct.h"
 #include "JsonObjectConverter.h"
+#include "Misc/DelayedAutoRegister.h"
 #include "StructDeserializer.h"
 #include "Backends/JsonStructDeserializerBackend.h"
 #include "UObject/UnrealTypePrivate.h"
+#include "UObject/ObjectKey.h"
 
 DEFINE_LOG_CATEGORY(ReflectionTool)
 
 // 解析 InPropertyParserStruct
 #define PARSERINPROPERTYPARSERSTRUCT	\
-TMap<FString, FPropertyParserStruct> Name2Value;	\
-for (auto Child : InPropertyParserStruct.Children)	\
+TMap<FName, FPropertyParserStruct*> Name2Value;	\
+for (FPropertyParserStruct& Child : InPropertyParserStruct.Children)	\
 {	\
-	Name2Value.Add(Child.Name, Child);	\
+	Name2Value.Add(Child.GetNameId(), &Child);	\
 }
-#define TypeName_TArray L"TArray"
-#define TypeName_TSet L"TSet"
-#define TypeName_TMap L"TMap"
 
-void UReflectionToolLib::GetStructProperty(const UStruct* StructClass, const void* Struct,
-	FPropertyParserStruct& OutPropertyParserStruct)
+// PPS 中的固定类型名
+static const FName TypeName_Struct(TEXT("Struct"));
+static const FName TypeName_TArray(TEXT("TArray"));
+static const FName TypeName_TSet(TEXT("TSet"));
+static const FName TypeName_TMap(TEXT("TMap"));
+static const FName TypeName_MapItem(TEXT("MapItem"));
+static const FName TypeName_ObjectGraph(TEXT("ObjectGraph"));
+
+namespace ReflectionToolNames
 {
-	OutPropertyParserStruct.TypeName = TEXT("Struct");
-	OutPropertyParserStruct.bHaveChild = true;
-	for (FProperty* Property = StructClass->PropertyLink; Property; Property = Property->PropertyLinkNext)
+	// 属性 -> 类型名，每个线程一份，不加锁；ClearPropertyTypeNameCache 递增代数，各线程在下次访问时清空
+	std::atomic<uint32> TypeNameGeneration{0};
+
+	struct FTypeNameCache
 	{
-		FPropertyParserStruct PropertyParserStruct;
-		const void* Addr = Property->ContainerPtrToValuePtr<uint8>(Struct);
-		PropertyToPropertyStruct(Property, Addr, PropertyParserStruct);
-		OutPropertyParserStruct.Children.Add(PropertyParserStruct);
+		TMap<const FProperty*, FName> TypeNames;
+		uint32 Generation = 0;
+	};
+
+	thread_local FTypeNameCache TypeNameCache;
+
+	FName MakeTypeName(const FProperty* Property)
+	{
+		FString CPPType = Property->GetCPPType();
+		CPPType.Split(TEXT("<"), &CPPType, nullptr);
+		return FName(*CPPType);
+	}
+}
+
+namespace ReflectionToolObjectGraph
+{
+	// 共享对象展开结果的缓存
+	struct FCachedObjectNode
+	{
+		FPropertyParserStruct Node;
+		int32 NodeCount = 0;
+		int64 ByteCount = 0;
+		TArray<TWeakObjectPtr<const UObject>> References;
+	};
+
+	// 仅在游戏线程访问；资源与 CDO 被修改或重新加载时由 FReflectionToolModule 清空
+	TMap<FObjectKey, FCachedObjectNode> SharedObjectCache;
+
+	// 资源、CDO、Archetype 在运行时基本不变，可以缓存
+	bool IsSharedObject(const UObject* Object)
+	{
+		return Object->IsAsset() || Object->HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject);
+	}
+}
+
+void FPPSConvertContext::AddObjectReference(const UObject* Object)
+{
+	if (CurrentReferences)
+	{
+		CurrentReferences->Add(Object);
+	}
+	if (CurrentObjectDepth + 1 > Options.MaxObjectDepth || VisitedObjects.Contains(Object))
+		return;
+	VisitedObjects.Add(Object);
+	PendingObjects.Emplace(Object, CurrentObjectDepth + 1);
+}
+
+void FPPSConvertContext::AddNode(const FPropertyParserStruct& Node)
+{
+	++NodeCount;
+	ByteCount += sizeof(FPropertyParserStruct) + Node.Name.GetAllocatedSize() + Node.TypeName.GetAllocatedSize()
+		+ Node.Value.GetAllocatedSize();
+}
+
+namespace ReflectionToolGeneratedConverters
+{
+	struct FRegistry
+	{
+		FRWLock Lock;
+		TMap<const UScriptStruct*, FReflectionToolGeneratedConverters::FConverter> Converters;
+	};
+
+	FRegistry& GetRegistry()
+	{
+		static FRegistry Registry;
+		return Registry;
 	}
 }
 
+FReflectionToolGeneratedConverters::FRegistration::FRegistration(UScriptStruct* (*InGetStruct)(), const FConverter& InConverter)
+{
+	// 先构造注册表，保证静态析构时注册表晚于本对象销毁
+	ReflectionToolGeneratedConverters::GetRegistry();
+	// StaticStruct 需在对象系统就绪后调用；阶段已过时立即执行
+	FDelayedAutoRegisterHelper(EDelayedRegisterRunPhase::ObjectSystemReady, [this, InGetStruct, InConverter]()
+	{
+		Struct = InGetStruct();
+		Register(Struct, InConverter);
+	});
+}
+
+FReflectionToolGeneratedConverters::FRegistration::~FRegistration()
+{
+	if (Struct)
+	{
+		Unregister(Struct);
+	}
+}
+
+void FReflectionToolGeneratedConverters::Register(const UScriptStruct* Struct, const FConverter& Converter)
+{
+	check(Struct);
+	ReflectionToolGeneratedConverters::FRegistry& Registry = ReflectionToolGeneratedConverters::GetRegistry();
+	FWriteScopeLock WriteLock(Registry.Lock);
+	Registry.Converters.Add(Struct, Converter);
+}
+
+void FReflectionToolGeneratedConverters::Unregister(const UScriptStruct* Struct)
+{
+	ReflectionToolGeneratedConverters::FRegistry& Registry = ReflectionToolGeneratedConverters::GetRegistry();
+	FWriteScopeLock WriteLock(Registry.Lock);
+	Registry.Converters.Remove(Struct);
+}
+
+bool FReflectionToolGeneratedConverters::Find(const UScriptStruct* Struct, FConverter& OutConverter)
+{
+	ReflectionToolGeneratedConverters::FRegistry& Registry = ReflectionToolGeneratedConverters::GetRegistry();
+	FReadScopeLock ReadLock(Registry.Lock);
+	if (const FConverter* Found = Registry.Converters.Find(Struct))
+	{
+		OutConverter = *Found;
+		return true;
+	}
+	return false;
+}
+
+FString UReflectionToolLib::GetPropertyAuthoredName(const FProperty* Property)
+{
+	// 只有蓝图结构体的成员 FName 带 GUID 后缀，其余属性的名称即为变量名
+	const UStruct* OwnerStruct = Property->GetOwnerStruct();
+	if (OwnerStruct && OwnerStruct->IsA<UUserDefinedStruct>())
+		return Property->GetAuthoredName();
+	return Property->GetName();
+}
+
+FName UReflectionToolLib::GetPropertyAuthoredFName(const FProperty* Property)
+{
+	const UStruct* OwnerStruct = Property->GetOwnerStruct();
+	if (OwnerStruct && OwnerStruct->IsA<UUserDefinedStruct>())
+		return FName(*Property->GetAuthoredName());
+	return Property->GetFName();
+}
+
+FString UReflectionToolLib::GetPropertyTypeName(const FProperty* Property)
+{
+	return GetPropertyTypeFName(Property).ToString();
+}
+
+FName UReflectionToolLib::GetPropertyTypeFName(const FProperty* Property)
+{
+	using namespace ReflectionToolNames;
+	FTypeNameCache& Cache = TypeNameCache;
+	const uint32 Generation = TypeNameGeneration.load(std::memory_order_relaxed);
+	if (Cache.Generation != Generation)
+	{
+		Cache.TypeNames.Reset();
+		Cache.Generation = Generation;
+	}
+	if (const FName* Found = Cache.TypeNames.Find(Property))
+		return *Found;
+	return Cache.TypeNames.Add(Property, MakeTypeName(Property));
+}
+
+void UReflectionToolLib::ClearPropertyTypeNameCache()
+{
+	ReflectionToolNames::TypeNameGeneration.fetch_add(1, std::memory_order_relaxed);
+}
+
+namespace ReflectionToolConvert
+{
+	// 结构体 / 对象的所有属性转为子节点，供各个入口与对象图共用，本身不计入入口统计
+	void StructToChildren(const UStruct* StructClass, const void* Struct, FPropertyParserStruct& OutPropertyParserStruct,
+		FPPSConvertContext* Context)
+	{
+		OutPropertyParserStruct.SetTypeName(TypeName_Struct);
+		OutPropertyParserStruct.bHaveChild = true;
+		for (FProperty* Property = StructClass->PropertyLink; Property; Property = Property->PropertyLinkNext)
+		{
+			if (Context && Context->TruncateIfOverBudget(OutPropertyParserStruct))
+				break;
+			FPropertyParserStruct PropertyParserStruct;
+			const void* Addr = Property->ContainerPtrToValuePtr<uint8>(Struct);
+			UReflectionToolLib::PropertyToPropertyStruct(Property, Addr, PropertyParserStruct, Context);
+			OutPropertyParserStruct.Children.Add(PropertyParserStruct);
+		}
+	}
+}
+
+void UReflectionToolLib::GetStructProperty(const UStruct* StructClass, const void* Struct,
+	FPropertyParserStruct& OutPropertyParserStruct, FPPSConvertContext* Context)
+{
+	REFLECTIONTOOL_CONVERT_SCOPE(GetStructProperty, Context);
+	ReflectionToolConvert::StructToChildren(StructClass, Struct, OutPropertyParserStruct, Context);
+}
+
 void UReflectionToolLib::StructToPropertyStruct(FStructProperty* StructProperty, const void* Addr,
-	FPropertyParserStruct& OutPropertyParserStruct)
+	FPropertyParserStruct& OutPropertyParserStruct, FPPSConvertContext* Context)
 {
-	OutPropertyParserStruct.Name = StructProperty->GetAuthoredName();
+	OutPropertyParserStruct.SetName(GetPropertyAuthoredFName(StructProperty));
 	// OutPropertyParserStruct.TypeName = TEXT("Struct");
 	OutPropertyParserStruct.bHaveChild = true;
 	for (FProperty* Property = StructProperty->Struct->PropertyLink; Property; Property = Property->PropertyLinkNext)
 	{
+		if (Context && Context->TruncateIfOverBudget(OutPropertyParserStruct))
+			break;
 		FPropertyParserStruct PropertyParserStruct;
 		const void* NewAddr = Property->ContainerPtrToValuePtr<uint8>(Addr);
-		PropertyToPropertyStruct(Property, NewAddr, PropertyParserStruct);
+		PropertyToPropertyStruct(Property, NewAddr, PropertyParserStruct, Context);
 		OutPropertyParserStruct.Children.Add(PropertyParserStruct);
 	}
 }
 
 void UReflectionToolLib::TArrayToPropertyStruct(FArrayProperty* ArrayProperty, const void* Addr,
-                                                      FPropertyParserStruct& OutPropertyParserStruct)
+                                                      FPropertyParserStruct& OutPropertyParserStruct, FPPSConvertContext* Context)
 {
-	OutPropertyParserStruct.TypeName = TypeName_TArray;
+	OutPropertyParserStruct.SetTypeName(TypeName_TArray);
 	OutPropertyParserStruct.bHaveChild = true;
 	FScriptArrayHelper Helper(ArrayProperty, Addr);
 	for (int i = 0, n = Helper.Num(); i < n; ++i)
 	{
+		if (Context && Context->TruncateIfOverBudget(OutPropertyParserStruct))
+			break;
 		FPropertyParserStruct PropertyParserStruct;
-		PropertyToPropertyStruct(ArrayProperty->Inner, Helper.GetRawPtr(i), PropertyParserStruct);
+		PropertyToPropertyStruct(ArrayProperty->Inner, Helper.GetRawPtr(i), PropertyParserStruct, Context);
 		OutPropertyParserStruct.Children.Add(PropertyParserStruct);
 	}
 }
 
 void UReflectionToolLib::TSetToPropertyStruct(FSetProperty* SetProperty, const void* Addr,
-	FPropertyParserStruct& OutPropertyParserStruct)
+	FPropertyParserStruct& OutPropertyParserStruct, FPPSConvertContext* Context)
 {
-	OutPropertyParserStruct.TypeName = TypeName_TSet;
+	OutPropertyParserStruct.SetTypeName(TypeName_TSet);
 	OutPropertyParserStruct.bHaveChild = true;
 	FScriptSetHelper Helper(SetProperty, Addr);
 	for (int i = 0, n = Helper.Num(); n; ++i)
 	{
 		if (Helper.IsValidIndex(i))
 		{
+			if (Context && Context->TruncateIfOverBudget(OutPropertyParserStruct))
+				break;
 			FPropertyParserStruct PropertyParserStruct;
-			PropertyToPropertyStruct(SetProperty->ElementProp, Helper.GetElementPtr(i), PropertyParserStruct);
+			PropertyToPropertyStruct(SetProperty->ElementProp, Helper.GetElementPtr(i), PropertyParserStruct, Context);
 			OutPropertyParserStruct.Children.Add(PropertyParserStruct);
 			--n;
 		}
@@ -85,24 +286,30 @@ void UReflectionToolLib::TSetToPropertyStruct(FSetProperty* SetProperty, const v
 }
 
 void UReflectionToolLib::TMapToPropertyStruct(FMapProperty* MapProperty, const void* Addr,
-	FPropertyParserStruct& OutPropertyParserStruct)
+	FPropertyParserStruct& OutPropertyParserStruct, FPPSConvertContext* Context)
 {
-	OutPropertyParserStruct.TypeName = TypeName_TMap;
+	OutPropertyParserStruct.SetTypeName(TypeName_TMap);
 	OutPropertyParserStruct.bHaveChild = true;
 	FScriptMapHelper Helper(MapProperty, Addr);
 	for (int i = 0, n = Helper.Num(); n; ++i)
 	{
 		if (Helper.IsValidIndex(i))
 		{
+			if (Context && Context->TruncateIfOverBudget(OutPropertyParserStruct))
+				break;
 			FPropertyParserStruct KeyPropertyParserStruct, ValuePropertyParserStruct;
-			PropertyToPropertyStruct(MapProperty->KeyProp, Helper.GetKeyPtr(i), KeyPropertyParserStruct);
-			PropertyToPropertyStruct(MapProperty->ValueProp, Helper.GetValuePtr(i), ValuePropertyParserStruct);
+			PropertyToPropertyStruct(MapProperty->KeyProp, Helper.GetKeyPtr(i), KeyPropertyParserStruct, Context);
+			PropertyToPropertyStruct(MapProperty->ValueProp, Helper.GetValuePtr(i), ValuePropertyParserStruct, Context);
 			FPropertyParserStruct MapItemPropertyParserStruct;
 			MapItemPropertyParserStruct.Name = FString::FromInt(i);
-			MapItemPropertyParserStruct.TypeName = TEXT("MapItem");
+			MapItemPropertyParserStruct.SetTypeName(TypeName_MapItem);
 			MapItemPropertyParserStruct.bHaveChild = true;
 			MapItemPropertyParserStruct.Children.Add(KeyPropertyParserStruct);
 			MapItemPropertyParserStruct.Children.Add(ValuePropertyParserStruct);
+			if (Context)
+			{
+				Context->AddNode(MapItemPropertyParserStruct);
+			}
 			OutPropertyParserStruct.Children.Add(MapItemPropertyParserStruct);
 			--n;
 		}
@@ -111,17 +318,10 @@ void UReflectionToolLib::TMapToPropertyStruct(FMapProperty* MapProperty, const v
 }
 
 void UReflectionToolLib::PropertyToPropertyStruct(FProperty* Property, const void* Addr,
-                                                        FPropertyParserStruct& OutPropertyParserStruct)
+                                                        FPropertyParserStruct& OutPropertyParserStruct, FPPSConvertContext* Context)
 {
-	OutPropertyParserStruct.Name = Property->GetAuthoredName();
-	if (Property->GetCPPType().Contains(TEXT("<")))
-	{
-		Property->GetCPPType().Split(TEXT("<"), &OutPropertyParserStruct.TypeName, nullptr);
-	}
-	else
-	{
-		OutPropertyParserStruct.TypeName = Property->GetCPPType();
-	}
+	OutPropertyParserStruct.SetName(GetPropertyAuthoredFName(Property));
+	OutPropertyParserStruct.SetTypeName(GetPropertyTypeFName(Property));
 	if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
 	{
 		const UEnum* EnumDef = EnumProperty->GetEnum();
@@ -160,48 +360,145 @@ void UReflectionToolLib::PropertyToPropertyStruct(FProperty* Property, const voi
 	}
 	else if (FStructProperty* StructProperty = CastField<FStructProperty>(Property))
 	{
-		StructToPropertyStruct(StructProperty, Addr, OutPropertyParserStruct);
+		StructToPropertyStruct(StructProperty, Addr, OutPropertyParserStruct, Context);
 	}
 	else if (FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
 	{
-		TArrayToPropertyStruct(ArrayProperty, Addr, OutPropertyParserStruct);
+		TArrayToPropertyStruct(ArrayProperty, Addr, OutPropertyParserStruct, Context);
 	}
 	else if (FSetProperty* SetProperty = CastField<FSetProperty>(Property))
 	{
-		TSetToPropertyStruct(SetProperty, Addr, OutPropertyParserStruct);
+		TSetToPropertyStruct(SetProperty, Addr, OutPropertyParserStruct, Context);
 	}
 	else if (FMapProperty* MapProperty = CastField<FMapProperty>(Property))
 	{
-		TMapToPropertyStruct(MapProperty, Addr, OutPropertyParserStruct);
+		TMapToPropertyStruct(MapProperty, Addr, OutPropertyParserStruct, Context);
 	}
 	else if (const FObjectProperty* ObjectProperty = CastField<FObjectProperty>(Property))
 	{
 		if (UObject* Object = ObjectProperty->GetObjectPropertyValue(Addr))
 		{
-			OutPropertyParserStruct.TypeName = OutPropertyParserStruct.TypeName.Replace(TEXT("*"), TEXT("_Ptr"));
+			if (OutPropertyParserStruct.TypeName.ReplaceInline(TEXT("*"), TEXT("_Ptr")) > 0)
+			{
+				OutPropertyParserStruct.TypeNameId = FName(*OutPropertyParserStruct.TypeName);
+			}
 			OutPropertyParserStruct.Value = ObjectProperty->GetObjectPropertyValue(Addr)->GetPathName();
+			// 对象图模式下登记引用，对象本身在对象表中展开
+			if (Context && Context->Options.bExpandObjects)
+			{
+				Context->AddObjectReference(Object);
+			}
 		}
 	}
 	else
 	{
 		Property->ExportTextItem_Direct(OutPropertyParserStruct.Value, Addr, NULL, NULL, PPF_None);
 	}
+	if (Context)
+	{
+		++Context->PropertiesVisited;
+		Context->AddNode(OutPropertyParserStruct);
+	}
+}
+
+void UReflectionToolLib::GetObjectGraph(UObject* Root, const FPPSConvertOptions& Options,
+	FPropertyParserStruct& OutPropertyParserStruct)
+{
+	REFLECTIONTOOL_SCOPE(GetObjectGraph);
+	OutPropertyParserStruct = FPropertyParserStruct();
+	OutPropertyParserStruct.SetTypeName(TypeName_ObjectGraph);
+	OutPropertyParserStruct.bHaveChild = true;
+	if (!Root)
+		return;
+
+	FPPSConvertContext Context(Options);
+	REFLECTIONTOOL_CONTEXT_COUNTERS(Context);
+	Context.Options.bExpandObjects = true;
+	Context.VisitedObjects.Add(Root);
+	Context.PendingObjects.Emplace(Root, 0);
+
+	// 广度优先，PendingObjects 在展开过程中会继续增长
+	for (int32 Index = 0; Index < Context.PendingObjects.Num(); ++Index)
+	{
+		if (Context.TruncateIfOverBudget(OutPropertyParserStruct))
+		{
+			UE_LOG(ReflectionTool, Warning, TEXT("GetObjectGraph: budget reached (%d nodes, %lld bytes), %d objects not expanded"),
+				Context.NodeCount, Context.ByteCount, Context.PendingObjects.Num() - Index);
+			break;
+		}
+		const TPair<const UObject*, int32> Pending = Context.PendingObjects[Index];
+		Context.CurrentObjectDepth = Pending.Value;
+		ExpandObjectGraphNode(Pending.Key, Context, OutPropertyParserStruct.Children.AddDefaulted_GetRef());
+	}
+}
+
+void UReflectionToolLib::ClearObjectGraphCache()
+{
+	ReflectionToolObjectGraph::SharedObjectCache.Empty();
+}
+
+void UReflectionToolLib::ExpandObjectGraphNode(const UObject* Object, FPPSConvertContext& Context,
+	FPropertyParserStruct& OutPropertyParserStruct)
+{
+	using namespace ReflectionToolObjectGraph;
+
+	const bool bCacheable = Context.Options.bCacheSharedObjects && IsSharedObject(Object);
+	if (bCacheable)
+	{
+		// 缓存的子图超出剩余预算时不整体粘贴，重新展开并按节点截断
+		const FCachedObjectNode* Cached = SharedObjectCache.Find(FObjectKey(Object));
+		if (Cached && !Context.WouldExceedBudget(Cached->NodeCount, Cached->ByteCount))
+		{
+			OutPropertyParserStruct = Cached->Node;
+			Context.NodeCount += Cached->NodeCount;
+			Context.ByteCount += Cached->ByteCount;
+			for (const TWeakObjectPtr<const UObject>& Reference : Cached->References)
+			{
+				if (const UObject* ReferencedObject = Reference.Get())
+				{
+					Context.AddObjectReference(ReferencedObject);
+				}
+			}
+			return;
+		}
+	}
+
+	TArray<const UObject*> References;
+	TGuardValue<TArray<const UObject*>*> ReferencesGuard(Context.CurrentReferences, bCacheable ? &References : nullptr);
+	const int32 NodeCountBefore = Context.NodeCount;
+	const int64 ByteCountBefore = Context.ByteCount;
+
+	ReflectionToolConvert::StructToChildren(Object->GetClass(), Object, OutPropertyParserStruct, &Context);
+	OutPropertyParserStruct.Name = Object->GetPathName();
+	OutPropertyParserStruct.SetTypeName(Object->GetClass()->GetFName());
+	OutPropertyParserStruct.Value = OutPropertyParserStruct.Name;
+
+	// 超出节点预算的结果可能不完整，不缓存
+	if (bCacheable && !OutPropertyParserStruct.bTruncated && !Context.IsBudgetExceeded())
+	{
+		FCachedObjectNode& Cached = SharedObjectCache.Add(FObjectKey(Object));
+		Cached.Node = OutPropertyParserStruct;
+		Cached.NodeCount = Context.NodeCount - NodeCountBefore;
+		Cached.ByteCount = Context.ByteCount - ByteCountBefore;
+		Cached.References.Append(References);
+	}
 }
 
 void UReflectionToolLib::ParserPropertyParserStruct(const UStruct* StructClass, void* Struct,
 	FPropertyParserStruct& InPropertyParserStruct)
 {
+	REFLECTIONTOOL_SCOPE(ParserPropertyParserStruct);
+	REFLECTIONTOOL_PENDING_COUNTERS();
 	PARSERINPROPERTYPARSERSTRUCT
 	for (FProperty* Property = StructClass->PropertyLink; Property; Property = Property->PropertyLinkNext)
 	{
 		FPropertyParserStruct PropertyParserStruct;
 		void* Addr = Property->ContainerPtrToValuePtr<uint8>(Struct);
 		
-		const FString TempName = Property->GetAuthoredName();
-		if (FPropertyParserStruct* TargetPPS = Name2Value.Find(TempName))
+		if (FPropertyParserStruct* const* TargetPPS = Name2Value.Find(GetPropertyAuthoredFName(Property)))
 		{
 			// 开始对各个值的处理
-			ParserPPSToProperty(Property, Addr, *TargetPPS);
+			ParserPPSToProperty(Property, Addr, **TargetPPS);
 		}
 	}
 }
@@ -222,25 +519,104 @@ void UReflectionToolLib::ParserPPSToArrayProperty(FArrayProperty* ArrayProperty,
 void UReflectionToolLib::ParserPPSToSetProperty(FSetProperty* SetProperty, void* Addr,
 	FPropertyParserStruct& InPropertyParserStruct)
 {
+	const int32 Len = InPropertyParserStruct.Children.Num();
+	FProperty* ElementProp = SetProperty->ElementProp;
 	FScriptSetHelper Helper(SetProperty, Addr);
-	for	(int i = 0, Len =  InPropertyParserStruct.Children.Num(); i < Len; ++i)
+	// 清空旧数据并一次性预留容量，元素直接在集合内存中构造
+	Helper.EmptyElements(Len);
+
+	// Rehash 前哈希表不可用，用局部的 Hash -> 下标 表去重
+	TMultiMap<uint32, int32> HashToIndex;
+	HashToIndex.Reserve(Len);
+	// 重复元素占用的槽位，清空后留给下一个元素复用
+	int32 FreeIndex = INDEX_NONE;
+	for (int32 i = 0; i < Len; ++i)
 	{
-		const int32 NewIndex = Helper.AddDefaultValue_Invalid_NeedsRehash();
-		ParserPPSToProperty(SetProperty->ElementProp, Helper.GetElementPtr(NewIndex), InPropertyParserStruct.Children[i]);
+		const int32 Index = FreeIndex != INDEX_NONE ? FreeIndex : Helper.AddDefaultValue_Invalid_NeedsRehash();
+		FreeIndex = INDEX_NONE;
+		uint8* ElementPtr = Helper.GetElementPtr(Index);
+		ParserPPSToProperty(ElementProp, ElementPtr, InPropertyParserStruct.Children[i]);
+
+		const uint32 Hash = ElementProp->GetValueTypeHash(ElementPtr);
+		bool bDuplicate = false;
+		for (TMultiMap<uint32, int32>::TConstKeyIterator It = HashToIndex.CreateConstKeyIterator(Hash); It; ++It)
+		{
+			if (ElementProp->Identical(Helper.GetElementPtr(It.Value()), ElementPtr, PPF_None))
+			{
+				bDuplicate = true;
+				break;
+			}
+		}
+		if (bDuplicate)
+		{
+			ElementProp->ClearValue(ElementPtr);
+			FreeIndex = Index;
+			continue;
+		}
+		HashToIndex.Add(Hash, Index);
+	}
+
+	Helper.Rehash();
+	// 最后一个元素重复时留下的空槽位，Rehash 后可以安全移除
+	if (FreeIndex != INDEX_NONE)
+	{
+		Helper.RemoveAt(FreeIndex);
 	}
 }
 
 void UReflectionToolLib::ParserPPSToMapProperty(FMapProperty* MapProperty, void* Addr,
 	FPropertyParserStruct& InPropertyParserStruct)
 {
+	const int32 Len = InPropertyParserStruct.Children.Num();
+	FProperty* KeyProp = MapProperty->KeyProp;
+	FProperty* ValueProp = MapProperty->ValueProp;
 	FScriptMapHelper Helper(MapProperty, Addr);
-	for	(int i = 0, Len =  InPropertyParserStruct.Children.Num(); i < Len; ++i)
+	// 清空旧数据并一次性预留容量，键值直接在 Map 内存中构造
+	Helper.EmptyValues(Len);
+
+	// Rehash 前哈希表不可用，用局部的 Hash -> 下标 表去重，重复的 Key 与 TMap::Add 一致，后者覆盖前者
+	TMultiMap<uint32, int32> HashToIndex;
+	HashToIndex.Reserve(Len);
+	int32 FreeIndex = INDEX_NONE;
+	for (int32 i = 0; i < Len; ++i)
 	{
-		const int32 NewIndex = Helper.AddDefaultValue_Invalid_NeedsRehash();
-		ParserPPSToProperty(MapProperty->KeyProp, Helper.GetKeyPtr(NewIndex), InPropertyParserStruct.Children[i].Children[0]);
-		ParserPPSToProperty(MapProperty->ValueProp, Helper.GetValuePtr(NewIndex), InPropertyParserStruct.Children[i].Children[1]);
+		FPropertyParserStruct& MapItem = InPropertyParserStruct.Children[i];
+		if (MapItem.Children.Num() != 2)
+			continue;
+
+		const int32 Index = FreeIndex != INDEX_NONE ? FreeIndex : Helper.AddDefaultValue_Invalid_NeedsRehash();
+		FreeIndex = INDEX_NONE;
+		uint8* KeyPtr = Helper.GetKeyPtr(Index);
+		ParserPPSToProperty(KeyProp, KeyPtr, MapItem.Children[0]);
+
+		const uint32 Hash = KeyProp->GetValueTypeHash(KeyPtr);
+		int32 ExistingIndex = INDEX_NONE;
+		for (TMultiMap<uint32, int32>::TConstKeyIterator It = HashToIndex.CreateConstKeyIterator(Hash); It; ++It)
+		{
+			if (KeyProp->Identical(Helper.GetKeyPtr(It.Value()), KeyPtr, PPF_None))
+			{
+				ExistingIndex = It.Value();
+				break;
+			}
+		}
+		if (ExistingIndex != INDEX_NONE)
+		{
+			uint8* ExistingValuePtr = Helper.GetValuePtr(ExistingIndex);
+			ValueProp->ClearValue(ExistingValuePtr);
+			ParserPPSToProperty(ValueProp, ExistingValuePtr, MapItem.Children[1]);
+			KeyProp->ClearValue(KeyPtr);
+			FreeIndex = Index;
+			continue;
+		}
+		ParserPPSToProperty(ValueProp, Helper.GetValuePtr(Index), MapItem.Children[1]);
+		HashToIndex.Add(Hash, Index);
 	}
+
 	Helper.Rehash();
+	if (FreeIndex != INDEX_NONE)
+	{
+		Helper.RemoveAt(FreeIndex);
+	}
 }
 
 void UReflectionToolLib::ParserPPSToStructProperty(FStructProperty* StructProperty, void* Addr,
@@ -254,10 +630,9 @@ void UReflectionToolLib::ParserPPSToStructProperty(FStructProperty* StructProper
 		void* NewAddr = Property->ContainerPtrToValuePtr<uint8>(Addr);
 		
 		// 开始对各个值的处理
-		const FString TempName = Property->GetAuthoredName();
-		if (FPropertyParserStruct* TargetPPS = Name2Value.Find(TempName))
+		if (FPropertyParserStruct* const* TargetPPS = Name2Value.Find(GetPropertyAuthoredFName(Property)))
 		{
-			ParserPPSToProperty(Property, NewAddr, *TargetPPS);
+			ParserPPSToProperty(Property, NewAddr, **TargetPPS);
 		}
 	}
 }
@@ -278,9 +653,16 @@ void UReflectionToolLib::SetFStringToEnumProperty(FEnumProperty* EnumProperty, v
 	}
 }
 
+namespace ReflectionToolAsyncApply
+{
+	// 异步应用的回调中为 true：对象已批量加载过，未加载的视为加载失败，不再同步加载
+	thread_local bool bResolveOnly = false;
+}
+
 void UReflectionToolLib::ParserPPSToProperty(FProperty* Property, void* Addr,
 	FPropertyParserStruct& OutPropertyParserStruct)
 {
+	REFLECTIONTOOL_COUNTER_ACCUMULATE(PropertiesVisited, 1);
 	// 区分简单 / 复杂
 	if (OutPropertyParserStruct.bHaveChild)
 	{
@@ -335,7 +717,16 @@ void UReflectionToolLib::ParserSinglePPSToProperty(FProperty* Property, void* Ad
 	}
 	else if (const FObjectProperty* ObjectProperty = CastField<FObjectProperty>(Property))
 	{
-		UObject* Object = StaticLoadObject(UObject::StaticClass(), nullptr, *InPropertyParserStruct.Value);
+		UObject* Object = nullptr;
+		if (!InPropertyParserStruct.Value.IsEmpty())
+		{
+			// 已加载的对象直接查找，不访问磁盘
+			Object = FSoftObjectPath(InPropertyParserStruct.Value).ResolveObject();
+			if (!Object && !ReflectionToolAsyncApply::bResolveOnly)
+			{
+				Object = StaticLoadObject(ObjectProperty->PropertyClass, nullptr, *InPropertyParserStruct.Value);
+			}
+		}
 		ObjectProperty->SetObjectPropertyValue(Addr, Object);
 	}
 	else
@@ -349,6 +740,30 @@ void UReflectionToolLib::ParserSinglePPSToProperty(FProperty* Property, void* Ad
 void UReflectionToolLib::ParserComplexPPSToProperty(FProperty* Property, void* Addr,
 	FPropertyParserStruct& InPropertyParserStruct)
 {
+	// 截断的 TSet / TMap 内容不完整，整体跳过；TArray 只写入已有的前缀；结构体按名称写入已有成员
+	if (InPropertyParserStruct.bTruncated)
+	{
+		if (FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+		{
+			FScriptArrayHelper Helper(ArrayProperty, Addr);
+			const int32 Len = InPropertyParserStruct.Children.Num();
+			if (Helper.Num() < Len)
+			{
+				Helper.Resize(Len);
+			}
+			for (int32 i = 0; i < Len; ++i)
+			{
+				ParserPPSToProperty(ArrayProperty->Inner, Helper.GetRawPtr(i), InPropertyParserStruct.Children[i]);
+			}
+			return;
+		}
+		if (CastField<FSetProperty>(Property) || CastField<FMapProperty>(Property))
+		{
+			UE_LOG(ReflectionTool, Verbose, TEXT("Skip truncated container [%s]"), *Property->GetName());
+			return;
+		}
+	}
+
 	if (FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
 	{
 		ParserPPSToArrayProperty(ArrayProperty, Addr, InPropertyParserStruct);
@@ -367,6 +782,170 @@ void UReflectionToolLib::ParserComplexPPSToProperty(FProperty* Property, void* A
 	}
 }
 
+namespace ReflectionToolAsyncApply
+{
+	// 收集并批量加载 PPS 中尚未加载的对象，全部已在内存中时同步调用 OnLoaded；bAllLoaded 为 false 表示有对象加载失败
+	TSharedPtr<FStreamableHandle> RequestObjectPaths(const UStruct* StructClass,
+		const FPropertyParserStruct& InPropertyParserStruct, TFunction<void(bool bAllLoaded)>&& OnLoaded)
+	{
+		TArray<FSoftObjectPath> Paths;
+		UReflectionToolLib::CollectObjectPathsFromPPS(StructClass, InPropertyParserStruct, Paths);
+
+		TSet<FSoftObjectPath> UniquePaths;
+		TArray<FSoftObjectPath> PathsToLoad;
+		for (const FSoftObjectPath& Path : Paths)
+		{
+			bool bAlreadyInSet = false;
+			UniquePaths.Add(Path, &bAlreadyInSet);
+			if (!bAlreadyInSet && !Path.ResolveObject())
+			{
+				PathsToLoad.Add(Path);
+			}
+		}
+
+		if (PathsToLoad.IsEmpty())
+		{
+			OnLoaded(true);
+			return nullptr;
+		}
+		TArray<FSoftObjectPath> RequestedPaths = PathsToLoad;
+		return FReflectionToolModule::Get().GetStreamableManager().RequestAsyncLoad(MoveTemp(PathsToLoad),
+			FStreamableDelegate::CreateLambda([RequestedPaths = MoveTemp(RequestedPaths), OnLoaded = MoveTemp(OnLoaded)]()
+			{
+				bool bAllLoaded = true;
+				for (const FSoftObjectPath& Path : RequestedPaths)
+				{
+					if (!Path.ResolveObject())
+					{
+						UE_LOG(ReflectionTool, Warning, TEXT("Async apply: failed to load %s"), *Path.ToString());
+						bAllLoaded = false;
+					}
+				}
+				OnLoaded(bAllLoaded);
+			}));
+	}
+
+	// 写入时只查找已加载的对象
+	void Apply(const UStruct* StructClass, void* Struct, FPropertyParserStruct& PPS)
+	{
+		TGuardValue<bool> ResolveOnlyGuard(bResolveOnly, true);
+		UReflectionToolLib::ParserPropertyParserStruct(StructClass, Struct, PPS);
+	}
+}
+
+TSharedPtr<FStreamableHandle> UReflectionToolLib::ParserPropertyParserStructAsync(const UStruct* StructClass, void* Struct,
+	const UObject* Owner, const FPropertyParserStruct& InPropertyParserStruct, TFunction<void(bool bSuccess)>&& OnComplete)
+{
+	REFLECTIONTOOL_SCOPE(ParserPropertyParserStructAsync);
+	if (!StructClass || !Struct)
+		return nullptr;
+	// ParserPropertyParserStruct 需要可写的 PPS，这里保存一份拷贝到加载完成
+	TSharedRef<FPropertyParserStruct> PPS = MakeShared<FPropertyParserStruct>(InPropertyParserStruct);
+	TWeakObjectPtr<const UStruct> WeakStructClass(StructClass);
+	TWeakObjectPtr<const UObject> WeakOwner(Owner);
+	const bool bHasOwner = Owner != nullptr;
+	return ReflectionToolAsyncApply::RequestObjectPaths(StructClass, InPropertyParserStruct,
+		[WeakStructClass, WeakOwner, bHasOwner, Struct, PPS, OnComplete = MoveTemp(OnComplete)](bool bAllLoaded)
+		{
+			// 结构体所在的对象在加载期间被销毁时 Struct 已失效
+			const UStruct* LoadedStructClass = WeakStructClass.Get();
+			const bool bValid = LoadedStructClass && (!bHasOwner || WeakOwner.IsValid());
+			if (bValid)
+			{
+				ReflectionToolAsyncApply::Apply(LoadedStructClass, Struct, *PPS);
+			}
+			if (OnComplete)
+			{
+				OnComplete(bValid && bAllLoaded);
+			}
+		});
+}
+
+void UReflectionToolLib::SetObjectByPPSAsync(UObject* TargetObject, const FPropertyParserStruct& InPropertyParserStruct,
+	FOnPPSAppliedDynamic OnApplied)
+{
+	if (!TargetObject)
+	{
+		OnApplied.ExecuteIfBound(false);
+		return;
+	}
+	TSharedRef<FPropertyParserStruct> PPS = MakeShared<FPropertyParserStruct>(InPropertyParserStruct);
+	TWeakObjectPtr<UObject> WeakTarget(TargetObject);
+	ReflectionToolAsyncApply::RequestObjectPaths(TargetObject->GetClass(), InPropertyParserStruct,
+		[WeakTarget, PPS, OnApplied](bool bAllLoaded)
+		{
+			UObject* Target = WeakTarget.Get();
+			if (Target)
+			{
+				ReflectionToolAsyncApply::Apply(Target->GetClass(), Target, *PPS);
+			}
+			OnApplied.ExecuteIfBound(Target != nullptr && bAllLoaded);
+		});
+}
+
+void UReflectionToolLib::CollectObjectPathsFromPPS(const UStruct* StructClass,
+	const FPropertyParserStruct& InPropertyParserStruct, TArray<FSoftObjectPath>& OutPaths)
+{
+	TMap<FName, const FPropertyParserStruct*> Name2Value;
+	for (const FPropertyParserStruct& Child : InPropertyParserStruct.Children)
+	{
+		Name2Value.Add(Child.GetNameId(), &Child);
+	}
+	for (FProperty* Property = StructClass->PropertyLink; Property; Property = Property->PropertyLinkNext)
+	{
+		if (const FPropertyParserStruct* const* TargetPPS = Name2Value.Find(GetPropertyAuthoredFName(Property)))
+		{
+			CollectObjectPathsFromProperty(Property, **TargetPPS, OutPaths);
+		}
+	}
+}
+
+void UReflectionToolLib::CollectObjectPathsFromProperty(const FProperty* Property,
+	const FPropertyParserStruct& InPropertyParserStruct, TArray<FSoftObjectPath>& OutPaths)
+{
+	if (CastField<FObjectPropertyBase>(Property))
+	{
+		// 硬引用与软引用都收集
+		if (!InPropertyParserStruct.bHaveChild && !InPropertyParserStruct.Value.IsEmpty())
+		{
+			const FSoftObjectPath Path(InPropertyParserStruct.Value);
+			if (Path.IsValid())
+			{
+				OutPaths.Add(Path);
+			}
+		}
+	}
+	else if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+	{
+		CollectObjectPathsFromPPS(StructProperty->Struct, InPropertyParserStruct, OutPaths);
+	}
+	else if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+	{
+		for (const FPropertyParserStruct& Child : InPropertyParserStruct.Children)
+		{
+			CollectObjectPathsFromProperty(ArrayProperty->Inner, Child, OutPaths);
+		}
+	}
+	else if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+	{
+		for (const FPropertyParserStruct& Child : InPropertyParserStruct.Children)
+		{
+			CollectObjectPathsFromProperty(SetProperty->ElementProp, Child, OutPaths);
+		}
+	}
+	else if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+	{
+		for (const FPropertyParserStruct& Child : InPropertyParserStruct.Children)
+		{
+			if (Child.Children.Num() == 2)
+			{
+				CollectObjectPathsFromProperty(MapProperty->KeyProp, Child.Children[0], OutPaths);
+				CollectObjectPathsFromProperty(MapProperty->ValueProp, Child.Children[1], OutPaths);
+			}
+		}
+	}
+}
+
 #if WITH_EDITOR
 
 bool UReflectionToolLib::GetFunctionsByCategories(UClass* Class, const TArray<FString>& Categories,
@@ -508,6 +1087,7 @@ bool UReflectionToolLib::GetProperitesByCategories(UClass* Class, const TArray<F
 bool UReflectionToolLib::InvokeFunctionByName_Map(UObject* TargetObject, const FName& FunctionName,
 	const TMap<FString, FString>& InParams, TMap<FString, FString>& OutParams)
 {
+	REFLECTIONTOOL_SCOPE(InvokeFunctionByName_Map);
 	if (!TargetObject)
 		return false;
 	UFunction* Func = TargetObject->GetClass()->FindFunctionByName(FunctionName);
@@ -536,7 +1116,7 @@ bool UReflectionToolLib::InvokeFunctionByName(UClass* Class, UObject* TargetObje
 
 		for (auto Item : InParams)
 		{
-			FProperty* Property = Function->FindPropertyByName(FName(*Item.Key));
+			FProperty* Property = Function->FindPropertyByName(FName(*Item.Key, FNAME_Find));
 			SetJsonFieldByProperty(JsonObject, Property, Item.Key, Item.Value);
 		}
 
@@ -566,6 +1146,7 @@ bool UReflectionToolLib::InvokeFunctionByName(UClass* Class, UObject* TargetObje
 bool UReflectionToolLib::InvokeFunctionByName_Array(UObject* TargetObject, const FName& FunctionName,
 	const TArray<FString>& InParams)
 {
+	REFLECTIONTOOL_SCOPE(InvokeFunctionByName_Array);
 	if (!TargetObject)
 		return false;
 	UFunction* Func = TargetObject->GetClass()->FindFunctionByName(FunctionName);
@@ -615,36 +1196,49 @@ bool UReflectionToolLib::InvokeFunctionByName(UClass* Class, UObject* TargetObje
 	return true;
 }
 
-void UReflectionToolLib::SetStructValueByMap(const UStruct* StructClass, void* Struct,
-                                             const TMap<FString, FString>& InMap)
+namespace ReflectionToolConvert
 {
-	for (TFieldIterator<FProperty> i(StructClass); i; ++i)
+	// 按变量名把 Map 中的值写入结构体的各个属性，嵌套结构体递归处理，本身不计入入口统计
+	void SetFieldsByMap(const UStruct* StructClass, void* Struct, const TMap<FString, FString>& InMap)
 	{
-		FProperty* Property = *i;
-		void* Addr = Property->ContainerPtrToValuePtr<uint8>(Struct);
-		if (FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		for (TFieldIterator<FProperty> i(StructClass); i; ++i)
 		{
-			// 处理结构体类型
-			SetStructValueByMap(StructProperty, Addr, InMap);
-		}
-		else
-		{
-			// 单值数据处理
-			if (const FString* FoundString = InMap.Find(Property->GetAuthoredName()))
+			FProperty* Property = *i;
+			REFLECTIONTOOL_COUNTER_ACCUMULATE(PropertiesVisited, 1);
+			void* Addr = Property->ContainerPtrToValuePtr<uint8>(Struct);
+			if (FStructProperty* StructProperty = CastField<FStructProperty>(Property))
 			{
-				FPropertyParserStruct PropertyParserStruct;
-				PropertyParserStruct.Value = *FoundString;
-				ParserSinglePPSToProperty(Property, Addr, PropertyParserStruct);
+				// 处理结构体类型
+				UReflectionToolLib::SetStructValueByMap(StructProperty, Addr, InMap);
+			}
+			else
+			{
+				// 单值数据处理
+				if (const FString* FoundString = InMap.Find(Property->GetAuthoredName()))
+				{
+					FPropertyParserStruct PropertyParserStruct;
+					PropertyParserStruct.Value = *FoundString;
+					UReflectionToolLib::ParserSinglePPSToProperty(Property, Addr, PropertyParserStruct);
+				}
 			}
 		}
 	}
 }
 
+void UReflectionToolLib::SetStructValueByMap(const UStruct* StructClass, void* Struct,
+                                             const TMap<FString, FString>& InMap)
+{
+	REFLECTIONTOOL_SCOPE(SetStructValueByMap);
+	REFLECTIONTOOL_PENDING_COUNTERS();
+	ReflectionToolConvert::SetFieldsByMap(StructClass, Struct, InMap);
+}
+
 void UReflectionToolLib::SetStructValueByMap(FStructProperty* StructProperty, void* Addr,
 	const TMap<FString, FString>& InMap)
 {
 	for (FProperty* Property = StructProperty->Struct->PropertyLink; Property; Property = Property->PropertyLinkNext)
 	{
+		REFLECTIONTOOL_COUNTER_ACCUMULATE(PropertiesVisited, 1);
 		void* NewAddr = Property->ContainerPtrToValuePtr<uint8>(Addr);
 		if (FStructProperty* tempStructProperty = CastField<FStructProperty>(Property))
 		{
@@ -664,6 +1258,112 @@ void UReflectionToolLib::SetStructValueByMap(FStructProperty* StructProperty, vo
 	}
 }
 
+TSharedPtr<const FReflectionPropertyPath> UReflectionToolLib::CompilePropertyPath(const UStruct* Struct,
+	const FString& PropertyPath)
+{
+	return FReflectionPropertyPath::Compile(Struct, PropertyPath);
+}
+
+bool UReflectionToolLib::CompileObjectPropertyPath(UClass* Class, const FString& PropertyPath, FReflectionCompiledPath& OutPath)
+{
+	OutPath.Path = FReflectionPropertyPath::Compile(Class, PropertyPath);
+	return OutPath.Path.IsValid();
+}
+
+bool UReflectionToolLib::GetObjectPropertyByCompiledPath(const FReflectionCompiledPath& Path, UObject* Target, FString& OutValue)
+{
+	return Target && Path.Path.IsValid() && Path.Path->IsValidFor(Target->GetClass())
+		&& Path.Path->GetValueAsString(Target, OutValue);
+}
+
+bool UReflectionToolLib::SetObjectPropertyByCompiledPath(const FReflectionCompiledPath& Path, UObject* Target, const FString& Value)
+{
+	return Target && Path.Path.IsValid() && Path.Path->IsValidFor(Target->GetClass())
+		&& Path.Path->SetValueFromString(Target, Value);
+}
+
+bool UReflectionToolLib::GetObjectPropertyByPath(UObject* Target, const FString& PropertyPath, FString& OutValue)
+{
+	return Target && GetByPath(Target->GetClass(), Target, PropertyPath, OutValue);
+}
+
+bool UReflectionToolLib::SetObjectPropertyByPath(UObject* Target, const FString& PropertyPath, const FString& Value)
+{
+	return Target && SetByPath(Target->GetClass(), Target, PropertyPath, Value);
+}
+
+bool UReflectionToolLib::GetObjectNumberByPath(UObject* Target, const FString& PropertyPath, double& OutValue)
+{
+	return Target && GetByPath(Target->GetClass(), Target, PropertyPath, OutValue);
+}
+
+bool UReflectionToolLib::SetObjectNumberByPath(UObject* Target, const FString& PropertyPath, double Value)
+{
+	return Target && SetByPath(Target->GetClass(), Target, PropertyPath, Value);
+}
+
+bool UReflectionToolLib::QueryStructArray(const UScriptStruct* ElementStruct, const void* Elements, int32 Num,
+	const FString& Expression, TArray<int32>& OutIndices)
+{
+	REFLECTIONTOOL_SCOPE(QueryStructArray);
+	OutIndices.Reset();
+	const TSharedPtr<const FReflectionStructQuery> Query = FReflectionStructQuery::Compile(ElementStruct, Expression);
+	if (!Query.IsValid())
+		return false;
+	Query->Filter(Elements, Num, ElementStruct->GetStructureSize(), OutIndices);
+	return true;
+}
+
+bool UReflectionToolLib::SelectFromStructArray(const UScriptStruct* ElementStruct, const void* Elements, int32 Num,
+	const FString& Expression, const FString& ProjectionPath, TArray<FString>& OutValues)
+{
+	OutValues.Reset();
+	const TSharedPtr<const FReflectionPropertyPath> Projection = FReflectionPropertyPath::Compile(ElementStruct, ProjectionPath);
+	TArray<int32> Indices;
+	if (!Projection.IsValid() || !QueryStructArray(ElementStruct, Elements, Num, Expression, Indices))
+		return false;
+
+	const int32 Stride = ElementStruct->GetStructureSize();
+	OutValues.Reserve(Indices.Num());
+	for (const int32 Index : Indices)
+	{
+		FString& Value = OutValues.AddDefaulted_GetRef();
+		Projection->GetValueAsString(static_cast<const uint8*>(Elements) + static_cast<SIZE_T>(Index) * Stride, Value);
+	}
+	return true;
+}
+
+uint64 UReflectionToolLib::HashStruct(const UStruct* Struct, const void* StructAddr)
+{
+	REFLECTIONTOOL_SCOPE(HashStruct);
+	const TSharedPtr<const FReflectionStructLayout> Layout = FReflectionStructLayout::Get(Struct);
+	return Layout.IsValid() && StructAddr ? Layout->Hash(StructAddr) : 0;
+}
+
+void UReflectionToolLib::CopyStruct(const UStruct* Struct, void* DstAddr, const void* SrcAddr)
+{
+	if (const TSharedPtr<const FReflectionStructLayout> Layout = FReflectionStructLayout::Get(Struct))
+	{
+		Layout->Copy(DstAddr, SrcAddr);
+	}
+}
+
+bool UReflectionToolLib::CompareStruct(const UStruct* Struct, const void* AddrA, const void* AddrB)
+{
+	const TSharedPtr<const FReflectionStructLayout> Layout = FReflectionStructLayout::Get(Struct);
+	return Layout.IsValid() && Layout->Identical(AddrA, AddrB);
+}
+
+bool UReflectionToolLib::CopyStructByName(const UStruct* SrcStruct, const void* SrcAddr, const UStruct* DstStruct, void* DstAddr)
+{
+	REFLECTIONTOOL_SCOPE(CopyStructByName);
+	const TSharedPtr<const FReflectionStructMapping> Mapping = FReflectionStructMapping::Get(SrcStruct, DstStruct);
+	if (!Mapping.IsValid() || !SrcAddr || !DstAddr || Mapping->GetNumMappedFields() == 0)
+		return false;
+	Mapping->Copy(SrcAddr, DstAddr);
+	return true;
+}
+
 TArray<FPropertyParserStruct> UReflectionToolLib::GetPPSChildren(const FPropertyParserStruct& PPS)
 {
 	return PPS.Children;
@@ -680,7 +1380,8 @@ void UReflectionToolLib::GetKeyValueFromPPS(const FPropertyParserStruct& PPS, TM
 	if (PPS.bHaveChild)
 	{
 		// 目前无法处理存放复杂数据的 TArray TSet TMap，只处理简单数据的处理起来也很怪
-		if (PPS.TypeName == TypeName_TArray || PPS.TypeName == TypeName_TSet)
+		const FName TypeNameId = PPS.GetTypeNameId();
+		if (TypeNameId == TypeName_TArray || TypeNameId == TypeName_TSet)
 		{
 			for (int index = 0; index < PPS.Children.Num(); ++index)
 			{
@@ -692,7 +1393,7 @@ void UReflectionToolLib::GetKeyValueFromPPS(const FPropertyParserStruct& PPS, TM
 				}
 			}
 		}
-		else if (PPS.TypeName == TypeName_TMap)
+		else if (TypeNameId == TypeName_TMap)
 		{
 			for (int index = 0; index < PPS.Children.Num(); ++index)
 			{
@@ -724,18 +1425,42 @@ void UReflectionToolLib::GetPropertyParserStruct(const int32& StructReference, F
 }
 
 void UReflectionToolLib::FGetPropertyParserStruct(const void* StructAddr, const UStruct* StructProperty,
+	FPropertyParserStruct& OutPropertyParserStruct, FPPSConvertContext* Context)
+{
+	REFLECTIONTOOL_CONVERT_SCOPE(GetPropertyParserStruct, Context);
+	ReflectionToolConvert::StructToChildren(StructProperty, StructAddr, OutPropertyParserStruct, Context);
+}
+
+void UReflectionToolLib::GetPropertyParserStructWithOptions(const int32& StructReference, const FPPSConvertOptions& Options,
 	FPropertyParserStruct& OutPropertyParserStruct)
 {
-	OutPropertyParserStruct.TypeName = TEXT("Struct");
-	OutPropertyParserStruct.bHaveChild = true;
-	for (TFieldIterator<FProperty> i(StructProperty); i; ++i)
-    {
-    	FProperty* Property = *i;
-		FPropertyParserStruct PropertyParserStruct;
-		const void* Addr = Property->ContainerPtrToValuePtr<uint8>(StructAddr);
-		PropertyToPropertyStruct(Property, Addr, PropertyParserStruct);
-		OutPropertyParserStruct.Children.Add(PropertyParserStruct);
-    }
+	check(0);
+}
+
+int64 UReflectionToolLib::GetPPSMemoryFootprint(const FPropertyParserStruct& PPS)
+{
+	// 根节点本身 + 各级堆内存，子节点本体已包含在父节点 Children 的分配中
+	TFunction<int64(const FPropertyParserStruct&)> GetHeapSize = [&GetHeapSize](const FPropertyParserStruct& Node) -> int64
+	{
+		int64 Size = Node.Name.GetAllocatedSize() + Node.TypeName.GetAllocatedSize() + Node.Value.GetAllocatedSize()
+			+ Node.Children.GetAllocatedSize();
+		for (const FPropertyParserStruct& Child : Node.Children)
+		{
+			Size += GetHeapSize(Child);
+		}
+		return Size;
+	};
+	return sizeof(FPropertyParserStruct) + GetHeapSize(PPS);
+}
+
+bool UReflectionToolLib::SavePPSDump(const FPropertyParserStruct& PPS, const FString& Filename)
+{
+	return FReflectionPPSDump::Write(PPS, Filename);
+}
+
+bool UReflectionToolLib::OpenPPSDumpWindow(const FString& Filename)
+{
+	return SPPSTreeSourceView::OpenDumpFileWindow(Filename);
 }
 
 void UReflectionToolLib::SetStructByPPS(const int32& StructReference,
@@ -758,10 +1483,13 @@ void UReflectionToolLib::GetStructPropertyMap(const int32& StructReference, TMap
 void UReflectionToolLib::FGetStructPropertyMap(const void* StructAddr, const UStruct* StructProperty, void* MapAddr,
 	FMapProperty* MapProperty)
 {
+	REFLECTIONTOOL_SCOPE(GetStructPropertyMap);
 	if (!StructAddr || !MapAddr)
 		return;
 	FPropertyParserStruct OutPropertyParserStruct;
-	FGetPropertyParserStruct(StructAddr, StructProperty, OutPropertyParserStruct);
+	FPPSConvertContext Context;
+	REFLECTIONTOOL_CONTEXT_COUNTERS(Context);
+	ReflectionToolConvert::StructToChildren(StructProperty, StructAddr, OutPropertyParserStruct, &Context);
 	TMap<FString, FString> ResultMap;
 	GetKeyValueFromPPS(OutPropertyParserStruct, ResultMap);
 	
@@ -780,6 +1508,7 @@ void UReflectionToolLib::SetStructPropertyByMap(const int32& StructReference, co
 void UReflectionToolLib::FSetStructPropertyByMap(void* StructAddr, UStruct* StructProperty, const void* MapAddr,
 	const FMapProperty* MapProperty)
 {
+	REFLECTIONTOOL_SCOPE(SetStructPropertyByMap);
 	// @XXX
 	// Create Map
 	TMap<FString, FString> InMap;
@@ -804,7 +1533,82 @@ void UReflectionToolLib::FSetStructPropertyByMap(void* StructAddr, UStruct* Stru
 		}
 	}
 	// Map To Struct
-	SetStructValueByMap(StructProperty, StructAddr, InMap);
+	REFLECTIONTOOL_PENDING_COUNTERS();
+	ReflectionToolConvert::SetFieldsByMap(StructProperty, StructAddr, InMap);
+}
+
+void UReflectionToolLib::SetStructPropertyByPath(const int32& StructReference, const FString& PropertyPath,
+	const FString& Value, bool& bSuccess)
+{
+	check(0);
+}
+
+void UReflectionToolLib::SetStructByJson(const int32& StructReference, const FString& Json, bool& bSuccess)
+{
+	check(0);
+}
+
+void UReflectionToolLib::GetStructPropertyByPath(const int32& StructReference, const FString& PropertyPath,
+	FString& Value, bool& bSuccess)
+{
+	check(0);
+}
+
+bool UReflectionToolLib::FilterStructArray(const TArray<int32>& TargetArray, const FString& Expression,
+	TArray<int32>& OutIndices)
+{
+	check(0);
+	return false;
+}
+
+bool UReflectionToolLib::SelectStructArray(const TArray<int32>& TargetArray, const FString& Expression,
+	const FString& ProjectionPath, TArray<FString>& OutValues)
+{
+	check(0);
+	return false;
+}
+
+bool UReflectionToolLib::ExtractStructArrayNumbers(const TArray<int32>& TargetArray, const FString& PropertyPath,
+	TArray<double>& OutValues)
+{
+	check(0);
+	return false;
+}
+
+bool UReflectionToolLib::ScatterStructArrayNumbers(TArray<int32>& TargetArray, const FString& PropertyPath,
+	const TArray<double>& Values)
+{
+	check(0);
+	return false;
+}
+
+bool UReflectionToolLib::ExtractStructArrayStrings(const TArray<int32>& TargetArray, const FString& PropertyPath,
+	TArray<FString>& OutValues)
+{
+	check(0);
+	return false;
+}
+
+bool UReflectionToolLib::ScatterStructArrayStrings(TArray<int32>& TargetArray, const FString& PropertyPath,
+	const TArray<FString>& Values)
+{
+	check(0);
+	return false;
+}
+
+void UReflectionToolLib::GetStructHash(const int32& StructReference, int64& Hash)
+{
+	check(0);
+}
+
+void UReflectionToolLib::CopyStructFieldsByName(const int32& SourceStruct, int32& TargetStruct, bool& bSuccess)
+{
+	check(0);
+}
+
+bool UReflectionToolLib::FSetStructByJson(void* StructAddr, const UStruct* StructProperty, const FString& Json)
+{
+	return FReflectionJsonStreamImporter::ImportStruct(FStringView(Json), StructProperty, StructAddr);
 }
 
 void UReflectionToolLib::SetPPSChildren(FPropertyParserStruct& PPS, const TArray<FPropertyParserStruct>& PPSChildren)
@@ -829,6 +1633,3 @@ void UReflectionToolLib::SetJsonFieldByProperty(TSharedPtr<FJsonObject> JsonObje
 	}
 }
 
-#undef TypeName_TArray
-#undef TypeName_TSet
-#undef TypeName_TMap
\ No newline at end of file
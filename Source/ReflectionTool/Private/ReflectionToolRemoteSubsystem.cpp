@@ -0,0 +1,667 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#include "ReflectionToolRemoteSubsystem.h"
+
+#include "ReflectionPropertyPath.h"
+#include "ReflectionToolLib.h"
+#include "ReflectionToolStats.h"
+#include "ReflectionToolWatchSubsystem.h"
+#include "Common/TcpSocketBuilder.h"
+#include "Dom/JsonObject.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "JsonObjectConverter.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+
+#if REFLECTIONTOOL_REMOTE
+
+static TAutoConsoleVariable<int32> CVarReflectionToolRemotePort(
+	TEXT("ReflectionTool.Remote.Port"),
+	0,
+	TEXT("Loopback port of the ReflectionTool remote inspection server, started with each game world. 0 disables it."),
+	ECVF_Cheat);
+
+static TAutoConsoleVariable<float> CVarReflectionToolRemoteBudgetMs(
+	TEXT("ReflectionTool.Remote.BudgetMs"),
+	4.0f,
+	TEXT("Max milliseconds per tick spent processing remote requests, checked after each request. At least one request is processed per tick."),
+	ECVF_Cheat);
+
+namespace ReflectionToolRemote
+{
+	constexpr int32 MaxClients = 8;
+	// 单个批次的最大字节数，超过时断开连接
+	constexpr int32 MaxLineBytes = 16 * 1024 * 1024;
+	// 每帧每个连接最多读取的字节数
+	constexpr int32 MaxRecvPerTick = 4 * 1024 * 1024;
+	// 未发送的回复超过此值时认为对端不再读取
+	constexpr int32 MaxSendBuffer = 64 * 1024 * 1024;
+	constexpr int32 DefaultPageSize = 100;
+
+	TSharedRef<FJsonObject> MakeError(const FString& Error)
+	{
+		TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+		Result->SetBoolField(TEXT("ok"), false);
+		Result->SetStringField(TEXT("error"), Error);
+		return Result;
+	}
+
+	TSharedRef<FJsonObject> MakeOk()
+	{
+		TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+		Result->SetBoolField(TEXT("ok"), true);
+		return Result;
+	}
+
+	// 静态数组整体转换为 JSON 数组
+	TSharedPtr<FJsonValue> ValueToJson(const FProperty* Property, const void* Addr, int32 ArrayDim)
+	{
+		if (ArrayDim == 1)
+			return FJsonObjectConverter::UPropertyToJsonValue(const_cast<FProperty*>(Property), Addr);
+		TArray<TSharedPtr<FJsonValue>> Values;
+		for (int32 Index = 0; Index < ArrayDim; ++Index)
+		{
+			Values.Add(FJsonObjectConverter::UPropertyToJsonValue(const_cast<FProperty*>(Property),
+				static_cast<const uint8*>(Addr) + Index * Property->ElementSize));
+		}
+		return MakeShared<FJsonValueArray>(Values);
+	}
+
+	// 缺少字段时返回空值，不输出 JsonObject 的警告
+	FString GetString(const FJsonObject& Object, const TCHAR* Field)
+	{
+		FString Value;
+		Object.TryGetStringField(Field, Value);
+		return Value;
+	}
+
+	int32 GetInt(const FJsonObject& Object, const TCHAR* Field, int32 Default = 0)
+	{
+		int32 Value = Default;
+		Object.TryGetNumberField(Field, Value);
+		return Value;
+	}
+
+	FString ExportKey(const FProperty* Property, const void* Addr)
+	{
+		FString Key;
+		Property->ExportTextItem_Direct(Key, Addr, nullptr, nullptr, PPF_None);
+		return Key;
+	}
+}
+
+void UReflectionToolRemoteSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	UReflectionToolWatchSubsystem* WatchSubsystem = Collection.InitializeDependency<UReflectionToolWatchSubsystem>();
+	if (WatchSubsystem)
+	{
+		WatchChangedHandle = WatchSubsystem->OnPropertyWatchChangedNative.AddUObject(this, &UReflectionToolRemoteSubsystem::OnWatchChanged);
+	}
+
+	const int32 Port = CVarReflectionToolRemotePort.GetValueOnGameThread();
+	if (Port > 0)
+	{
+		StartServer(Port);
+	}
+}
+
+void UReflectionToolRemoteSubsystem::Deinitialize()
+{
+	StopServer();
+	if (UReflectionToolWatchSubsystem* WatchSubsystem = GetWorld()->GetSubsystem<UReflectionToolWatchSubsystem>())
+	{
+		WatchSubsystem->OnPropertyWatchChangedNative.Remove(WatchChangedHandle);
+	}
+	Super::Deinitialize();
+}
+
+bool UReflectionToolRemoteSubsystem::StartServer(int32 Port)
+{
+	StopServer();
+	if (Port <= 0 || Port > 65535)
+		return false;
+
+	// 只绑定回环地址，不对外暴露
+	const FIPv4Endpoint Endpoint(FIPv4Address(127, 0, 0, 1), static_cast<uint16>(Port));
+	ListenSocket = FTcpSocketBuilder(TEXT("ReflectionToolRemote"))
+		.AsNonBlocking()
+		.BoundToEndpoint(Endpoint)
+		.Listening(ReflectionToolRemote::MaxClients);
+	if (!ListenSocket)
+	{
+		UE_LOG(ReflectionTool, Warning, TEXT("Remote: failed to listen on %s"), *Endpoint.ToString());
+		return false;
+	}
+	UE_LOG(ReflectionTool, Log, TEXT("Remote: listening on %s"), *Endpoint.ToString());
+	return true;
+}
+
+void UReflectionToolRemoteSubsystem::StopServer()
+{
+	if (ListenSocket)
+	{
+		ListenSocket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ListenSocket);
+		ListenSocket = nullptr;
+	}
+	for (const TUniquePtr<FClient>& Client : Clients)
+	{
+		CloseClient(*Client);
+	}
+	Clients.Reset();
+}
+
+void UReflectionToolRemoteSubsystem::Tick(float DeltaTime)
+{
+	if (!ListenSocket)
+		return;
+	REFLECTIONTOOL_SCOPE(RemoteTick);
+
+	AcceptClients();
+	for (const TUniquePtr<FClient>& Client : Clients)
+	{
+		ReceiveFromClient(*Client);
+	}
+
+	// 按预算处理请求，至少处理一个，批次处理到一半时留到下一帧继续
+	const double Deadline = FPlatformTime::Seconds() + CVarReflectionToolRemoteBudgetMs.GetValueOnGameThread() * 0.001;
+	bool bProcessedAny = false;
+	bool bHasPending = true;
+	while (bHasPending && (!bProcessedAny || FPlatformTime::Seconds() < Deadline))
+	{
+		bHasPending = false;
+		for (int32 Step = 0; Step < Clients.Num(); ++Step)
+		{
+			const int32 ClientIndex = (NextClientIndex + Step) % Clients.Num();
+			FClient& Client = *Clients[ClientIndex];
+			if (Client.bClosed || (!Client.ActiveBatch.IsSet() && Client.PendingBatches.Num() == 0))
+				continue;
+			if (!Client.ActiveBatch.IsSet())
+			{
+				const FString Line = MoveTemp(Client.PendingBatches[0]);
+				Client.PendingBatches.RemoveAt(0, 1, false);
+				BeginBatch(Client, Line);
+				// 解析本身也计入预算
+				bProcessedAny = true;
+			}
+			if (Client.ActiveBatch.IsSet())
+			{
+				ContinueBatch(Client, Deadline, bProcessedAny);
+			}
+			bHasPending |= Client.ActiveBatch.IsSet() || Client.PendingBatches.Num() > 0;
+			if (FPlatformTime::Seconds() >= Deadline)
+				break;
+		}
+		NextClientIndex = Clients.Num() > 0 ? (NextClientIndex + 1) % Clients.Num() : 0;
+	}
+
+	for (const TUniquePtr<FClient>& Client : Clients)
+	{
+		FlushClient(*Client);
+	}
+	Clients.RemoveAll([this](const TUniquePtr<FClient>& Client)
+	{
+		if (Client->bClosed)
+		{
+			CloseClient(*Client);
+			return true;
+		}
+		return false;
+	});
+}
+
+void UReflectionToolRemoteSubsystem::AcceptClients()
+{
+	bool bHasPendingConnection = false;
+	while (ListenSocket->HasPendingConnection(bHasPendingConnection) && bHasPendingConnection)
+	{
+		FSocket* Socket = ListenSocket->Accept(TEXT("ReflectionToolRemoteClient"));
+		if (!Socket)
+			break;
+		if (Clients.Num() >= ReflectionToolRemote::MaxClients)
+		{
+			UE_LOG(ReflectionTool, Warning, TEXT("Remote: too many clients, connection rejected"));
+			Socket->Close();
+			ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+			continue;
+		}
+		Socket->SetNonBlocking(true);
+		Socket->SetNoDelay(true);
+		Clients.Add_GetRef(MakeUnique<FClient>())->Socket = Socket;
+	}
+}
+
+void UReflectionToolRemoteSubsystem::ReceiveFromClient(FClient& Client)
+{
+	if (Client.bClosed)
+		return;
+
+	int32 Received = 0;
+	uint32 PendingSize = 0;
+	while (Received < ReflectionToolRemote::MaxRecvPerTick && Client.Socket->HasPendingData(PendingSize))
+	{
+		const int32 Offset = Client.RecvBuffer.Num();
+		const int32 ReadSize = FMath::Min<int32>(static_cast<int32>(FMath::Min<uint32>(PendingSize, MAX_int32)), 64 * 1024);
+		Client.RecvBuffer.AddUninitialized(ReadSize);
+		int32 BytesRead = 0;
+		const bool bOk = Client.Socket->Recv(Client.RecvBuffer.GetData() + Offset, ReadSize, BytesRead);
+		if (!bOk || BytesRead <= 0)
+		{
+			Client.RecvBuffer.SetNum(Offset, false);
+			Client.bClosed |= !bOk;
+			break;
+		}
+		Client.RecvBuffer.SetNum(Offset + BytesRead, false);
+		Received += BytesRead;
+	}
+
+	// 对端关闭后 HasPendingData 为 false，连接状态也仍为已连接，只能试读一个字节：
+	// 关闭时 recv 返回 0，Recv 返回 false；没有数据时 Recv 返回 true 且读取 0 字节
+	if (!Client.bClosed && Received == 0)
+	{
+		uint8 Byte = 0;
+		int32 BytesRead = 0;
+		Client.bClosed = !Client.Socket->Recv(&Byte, 1, BytesRead, ESocketReceiveFlags::Peek);
+	}
+	if (Client.bClosed)
+		return;
+
+	// 按行拆分出批次
+	int32 LineStart = 0;
+	for (int32 Index = 0; Index < Client.RecvBuffer.Num(); ++Index)
+	{
+		if (Client.RecvBuffer[Index] != '\n')
+			continue;
+		const int32 LineLength = Index - LineStart;
+		if (LineLength > 0)
+		{
+			const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Client.RecvBuffer.GetData() + LineStart), LineLength);
+			Client.PendingBatches.Emplace(Converter.Length(), Converter.Get());
+		}
+		LineStart = Index + 1;
+	}
+	Client.RecvBuffer.RemoveAt(0, LineStart, false);
+	if (Client.RecvBuffer.Num() > ReflectionToolRemote::MaxLineBytes)
+	{
+		UE_LOG(ReflectionTool, Warning, TEXT("Remote: request batch too large, client disconnected"));
+		Client.bClosed = true;
+	}
+}
+
+void UReflectionToolRemoteSubsystem::FlushClient(FClient& Client)
+{
+	if (Client.bClosed || Client.SendBuffer.Num() == 0)
+		return;
+	int32 BytesSent = 0;
+	if (Client.Socket->Send(Client.SendBuffer.GetData(), Client.SendBuffer.Num(), BytesSent) && BytesSent > 0)
+	{
+		Client.SendBuffer.RemoveAt(0, BytesSent, false);
+	}
+	if (Client.SendBuffer.Num() > ReflectionToolRemote::MaxSendBuffer)
+	{
+		UE_LOG(ReflectionTool, Warning, TEXT("Remote: client is not reading responses, disconnected"));
+		Client.bClosed = true;
+	}
+}
+
+void UReflectionToolRemoteSubsystem::CloseClient(FClient& Client)
+{
+	if (UReflectionToolWatchSubsystem* WatchSubsystem = GetWorld()->GetSubsystem<UReflectionToolWatchSubsystem>())
+	{
+		for (int32 Handle : Client.WatchHandles)
+		{
+			WatchSubsystem->RemovePropertyWatch(Handle);
+		}
+	}
+	for (int32 Handle : Client.WatchHandles)
+	{
+		WatchOwners.Remove(Handle);
+	}
+	Client.WatchHandles.Reset();
+	if (Client.Socket)
+	{
+		Client.Socket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Client.Socket);
+		Client.Socket = nullptr;
+	}
+	Client.bClosed = true;
+}
+
+void UReflectionToolRemoteSubsystem::BeginBatch(FClient& Client, const FString& Line)
+{
+	TSharedPtr<FJsonObject> Batch;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Line);
+	if (!FJsonSerializer::Deserialize(Reader, Batch) || !Batch.IsValid())
+	{
+		SendResponse(Client, ReflectionToolRemote::MakeError(TEXT("invalid json")));
+		return;
+	}
+
+	FActiveBatch& ActiveBatch = Client.ActiveBatch.Emplace();
+	ActiveBatch.Id = Batch->TryGetField(TEXT("id"));
+	const TArray<TSharedPtr<FJsonValue>>* Requests = nullptr;
+	if (Batch->TryGetArrayField(TEXT("requests"), Requests))
+	{
+		ActiveBatch.Requests = *Requests;
+		ActiveBatch.Results.Reserve(Requests->Num());
+	}
+}
+
+void UReflectionToolRemoteSubsystem::ContinueBatch(FClient& Client, double Deadline, bool& bProcessedAny)
+{
+	FActiveBatch& ActiveBatch = Client.ActiveBatch.GetValue();
+	while (ActiveBatch.Results.Num() < ActiveBatch.Requests.Num())
+	{
+		if (bProcessedAny && FPlatformTime::Seconds() >= Deadline)
+			return;
+		const TSharedPtr<FJsonValue>& Request = ActiveBatch.Requests[ActiveBatch.Results.Num()];
+		const TSharedPtr<FJsonObject>* RequestObject = nullptr;
+		ActiveBatch.Results.Add(MakeShared<FJsonValueObject>(Request.IsValid() && Request->TryGetObject(RequestObject)
+			? ProcessRequest(Client, **RequestObject)
+			: ReflectionToolRemote::MakeError(TEXT("request must be an object"))));
+		bProcessedAny = true;
+	}
+
+	TSharedRef<FJsonObject> Response = MakeShared<FJsonObject>();
+	if (ActiveBatch.Id.IsValid())
+	{
+		Response->SetField(TEXT("id"), ActiveBatch.Id);
+	}
+	Response->SetArrayField(TEXT("results"), ActiveBatch.Results);
+	Client.ActiveBatch.Reset();
+	SendResponse(Client, Response);
+}
+
+void UReflectionToolRemoteSubsystem::SendResponse(FClient& Client, const TSharedRef<FJsonObject>& Response)
+{
+	FString Output;
+	const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+		TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Output);
+	FJsonSerializer::Serialize(Response, Writer);
+	Output.AppendChar(TEXT('\n'));
+	const FTCHARToUTF8 Converter(*Output, Output.Len());
+	Client.SendBuffer.Append(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length());
+}
+
+TSharedRef<FJsonObject> UReflectionToolRemoteSubsystem::ProcessRequest(FClient& Client, const FJsonObject& Request)
+{
+	using namespace ReflectionToolRemote;
+	const FString Op = GetString(Request, TEXT("op"));
+
+	if (Op == TEXT("poll"))
+	{
+		TSharedRef<FJsonObject> Result = MakeOk();
+		TArray<TSharedPtr<FJsonValue>> Changes;
+		for (const TPair<int32, TSharedPtr<FJsonValue>>& Delta : Client.PendingDeltas)
+		{
+			TSharedRef<FJsonObject> Change = MakeShared<FJsonObject>();
+			Change->SetNumberField(TEXT("handle"), Delta.Key);
+			Change->SetField(TEXT("value"), Delta.Value.IsValid() ? Delta.Value : MakeShared<FJsonValueNull>());
+			Changes.Add(MakeShared<FJsonValueObject>(Change));
+		}
+		Client.PendingDeltas.Reset();
+		Result->SetArrayField(TEXT("changes"), Changes);
+		return Result;
+	}
+	if (Op == TEXT("unwatch"))
+	{
+		const int32 Handle = GetInt(Request, TEXT("handle"), INDEX_NONE);
+		if (!Client.WatchHandles.Remove(Handle))
+			return MakeError(TEXT("unknown watch handle"));
+		WatchOwners.Remove(Handle);
+		Client.PendingDeltas.Remove(Handle);
+		if (UReflectionToolWatchSubsystem* WatchSubsystem = GetWorld()->GetSubsystem<UReflectionToolWatchSubsystem>())
+		{
+			WatchSubsystem->RemovePropertyWatch(Handle);
+		}
+		return MakeOk();
+	}
+
+	UObject* Object = ResolveObject(GetString(Request, TEXT("object")));
+	if (!Object)
+		return MakeError(TEXT("object not found"));
+	const FString Path = GetString(Request, TEXT("path"));
+
+	if (Op == TEXT("invoke"))
+	{
+		// 不为网络输入创建 FName，名称表中不存在的名称不可能是已有的函数
+		const FName FunctionName(*GetString(Request, TEXT("function")), FNAME_Find);
+		const UFunction* Function = Object->FindFunction(FunctionName);
+		if (!Function)
+			return MakeError(TEXT("function not found"));
+		// 只允许调用蓝图可调用的函数与控制台命令，不开放任意原生 UFUNCTION
+		if (!Function->HasAnyFunctionFlags(FUNC_BlueprintCallable | FUNC_Exec))
+			return MakeError(TEXT("function not callable"));
+
+		TMap<FString, FString> InParams;
+		TMap<FString, FString> OutParams;
+		// 输出参数与返回值按函数签名预先登记，调用后由 InvokeFunctionByName_Map 填入
+		for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+		{
+			if (It->HasAnyPropertyFlags(CPF_ReturnParm)
+				|| (It->HasAnyPropertyFlags(CPF_OutParm) && !It->HasAnyPropertyFlags(CPF_ConstParm)))
+			{
+				OutParams.Add(It->GetName());
+			}
+		}
+		const TSharedPtr<FJsonObject>* Params = nullptr;
+		if (Request.TryGetObjectField(TEXT("params"), Params))
+		{
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Param : (*Params)->Values)
+			{
+				InParams.Add(Param.Key, Param.Value->AsString());
+			}
+		}
+		if (!UReflectionToolLib::InvokeFunctionByName_Map(Object, FunctionName, InParams, OutParams))
+			return MakeError(TEXT("invoke failed"));
+		TSharedRef<FJsonObject> Result = MakeOk();
+		TSharedRef<FJsonObject> Outputs = MakeShared<FJsonObject>();
+		for (const TPair<FString, FString>& Param : OutParams)
+		{
+			Outputs->SetStringField(Param.Key, Param.Value);
+		}
+		Result->SetObjectField(TEXT("outputs"), Outputs);
+		return Result;
+	}
+
+	if (Op == TEXT("watch"))
+	{
+		UReflectionToolWatchSubsystem* WatchSubsystem = GetWorld()->GetSubsystem<UReflectionToolWatchSubsystem>();
+		const int32 Handle = WatchSubsystem ? WatchSubsystem->AddPropertyWatch(Object, Path) : INDEX_NONE;
+		if (Handle == INDEX_NONE)
+			return MakeError(TEXT("invalid path"));
+		Client.WatchHandles.Add(Handle);
+		WatchOwners.Add(Handle, &Client);
+		TSharedRef<FJsonObject> Result = MakeOk();
+		Result->SetNumberField(TEXT("handle"), Handle);
+		return Result;
+	}
+
+	if (Op == TEXT("set"))
+	{
+		if (!UReflectionToolLib::SetObjectPropertyByPath(Object, Path, GetString(Request, TEXT("value"))))
+			return MakeError(TEXT("set failed"));
+		return MakeOk();
+	}
+
+	// get / children：解析出路径末端的属性与地址，路径为空时为对象本身
+	const FProperty* Property = nullptr;
+	const void* Addr = Object;
+	int32 ArrayDim = 1;
+	if (!Path.IsEmpty())
+	{
+		TSharedPtr<const FReflectionPropertyPath> CompiledPath = FReflectionPropertyPath::Compile(Object->GetClass(), Path);
+		if (!CompiledPath.IsValid())
+			return MakeError(TEXT("invalid path"));
+		Addr = CompiledPath->Resolve(static_cast<const void*>(Object));
+		if (!Addr)
+			return MakeError(TEXT("element not found"));
+		Property = CompiledPath->LeafProperty;
+		ArrayDim = CompiledPath->GetLeafArrayDim();
+	}
+
+	if (Op == TEXT("get"))
+	{
+		TSharedRef<FJsonObject> Result = MakeOk();
+		if (Property)
+		{
+			Result->SetField(TEXT("value"), ValueToJson(Property, Addr, ArrayDim));
+		}
+		else
+		{
+			TSharedRef<FJsonObject> Value = MakeShared<FJsonObject>();
+			FJsonObjectConverter::UStructToJsonObject(Object->GetClass(), Object, Value);
+			Result->SetObjectField(TEXT("value"), Value);
+		}
+		return Result;
+	}
+
+	if (Op == TEXT("children"))
+	{
+		const int32 Offset = FMath::Max(0, GetInt(Request, TEXT("offset")));
+		const int32 Count = FMath::Max(0, GetInt(Request, TEXT("count"), DefaultPageSize));
+
+		TSharedRef<FJsonObject> Result = MakeOk();
+		TArray<TSharedPtr<FJsonValue>> Items;
+		int32 Num = 0;
+		if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+		{
+			FScriptArrayHelper Helper(ArrayProperty, Addr);
+			Num = Helper.Num();
+			for (int32 Index = Offset; Index < Num && Index - Offset < Count; ++Index)
+			{
+				Items.Add(ValueToJson(ArrayProperty->Inner, Helper.GetRawPtr(Index), 1));
+			}
+		}
+		else if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+		{
+			FScriptSetHelper Helper(SetProperty, Addr);
+			Num = Helper.Num();
+			for (int32 Index = 0, Logical = 0; Logical < Num && Logical - Offset < Count; ++Index)
+			{
+				if (!Helper.IsValidIndex(Index))
+					continue;
+				if (Logical >= Offset)
+				{
+					Items.Add(ValueToJson(SetProperty->ElementProp, Helper.GetElementPtr(Index), 1));
+				}
+				++Logical;
+			}
+		}
+		else if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+		{
+			FScriptMapHelper Helper(MapProperty, Addr);
+			Num = Helper.Num();
+			for (int32 Index = 0, Logical = 0; Logical < Num && Logical - Offset < Count; ++Index)
+			{
+				if (!Helper.IsValidIndex(Index))
+					continue;
+				if (Logical >= Offset)
+				{
+					TSharedRef<FJsonObject> Item = MakeShared<FJsonObject>();
+					Item->SetStringField(TEXT("key"), ExportKey(MapProperty->KeyProp, Helper.GetKeyPtr(Index)));
+					Item->SetField(TEXT("value"), ValueToJson(MapProperty->ValueProp, Helper.GetValuePtr(Index), 1));
+					Items.Add(MakeShared<FJsonValueObject>(Item));
+				}
+				++Logical;
+			}
+		}
+		else
+		{
+			// 结构体 / 对象：列出成员名与类型
+			const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+			const UStruct* Struct = StructProperty ? static_cast<const UStruct*>(StructProperty->Struct) : (Property ? nullptr : Object->GetClass());
+			if (!Struct)
+				return MakeError(TEXT("not a container"));
+			int32 Index = 0;
+			for (TFieldIterator<FProperty> It(Struct); It; ++It, ++Index)
+			{
+				if (Index < Offset || Index - Offset >= Count)
+					continue;
+				TSharedRef<FJsonObject> Item = MakeShared<FJsonObject>();
+				Item->SetStringField(TEXT("name"), UReflectionToolLib::GetPropertyAuthoredName(*It));
+				Item->SetStringField(TEXT("type"), UReflectionToolLib::GetPropertyTypeName(*It));
+				Items.Add(MakeShared<FJsonValueObject>(Item));
+			}
+			Num = Index;
+		}
+		Result->SetNumberField(TEXT("num"), Num);
+		Result->SetArrayField(TEXT("items"), Items);
+		return Result;
+	}
+
+	return MakeError(FString::Printf(TEXT("unknown op '%s'"), *Op));
+}
+
+UObject* UReflectionToolRemoteSubsystem::ResolveObject(const FString& Name) const
+{
+	if (Name.IsEmpty())
+		return nullptr;
+	// 完整路径
+	if (Name.Contains(TEXT("/")) || Name.Contains(TEXT(".")))
+		return StaticFindObject(UObject::StaticClass(), nullptr, *Name);
+	// 当前 World 中的 Actor 名称
+	for (TActorIterator<AActor> It(GetWorld()); It; ++It)
+	{
+		if (It->GetName() == Name)
+			return *It;
+	}
+	return nullptr;
+}
+
+void UReflectionToolRemoteSubsystem::OnWatchChanged(int32 WatchHandle, UObject* Object, const FProperty* LeafProperty,
+	const void* NewValueAddr)
+{
+	FClient** Owner = WatchOwners.Find(WatchHandle);
+	if (!Owner)
+		return;
+	// 同一监听在两次 poll 之间只保留最新值，路径无法解析时为 null
+	(*Owner)->PendingDeltas.Add(WatchHandle, NewValueAddr ? ReflectionToolRemote::ValueToJson(LeafProperty, NewValueAddr, 1) : nullptr);
+}
+
+#else
+
+void UReflectionToolRemoteSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+}
+
+void UReflectionToolRemoteSubsystem::Deinitialize()
+{
+	Super::Deinitialize();
+}
+
+void UReflectionToolRemoteSubsystem::Tick(float DeltaTime)
+{
+}
+
+bool UReflectionToolRemoteSubsystem::StartServer(int32 Port)
+{
+	UE_LOG(ReflectionTool, Warning, TEXT("Remote: the inspection server is not available in Shipping builds"));
+	return false;
+}
+
+void UReflectionToolRemoteSubsystem::StopServer()
+{
+}
+
+#endif
+
+bool UReflectionToolRemoteSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return REFLECTIONTOOL_REMOTE && Super::ShouldCreateSubsystem(Outer);
+}
+
+bool UReflectionToolRemoteSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UReflectionToolRemoteSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UReflectionToolRemoteSubsystem, STATGROUP_Tickables);
+}
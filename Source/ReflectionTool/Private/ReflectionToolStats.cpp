@@ -0,0 +1,78 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#include "ReflectionToolStats.h"
+
+#if REFLECTIONTOOL_STATS
+
+#include "HAL/IConsoleManager.h"
+
+DEFINE_STAT(STAT_ReflectionTool_GetStructProperty);
+DEFINE_STAT(STAT_ReflectionTool_GetPropertyParserStruct);
+DEFINE_STAT(STAT_ReflectionTool_GetObjectGraph);
+DEFINE_STAT(STAT_ReflectionTool_ParserPropertyParserStruct);
+DEFINE_STAT(STAT_ReflectionTool_ParserPropertyParserStructAsync);
+DEFINE_STAT(STAT_ReflectionTool_InvokeFunctionByName_Map);
+DEFINE_STAT(STAT_ReflectionTool_InvokeFunctionByName_Array);
+DEFINE_STAT(STAT_ReflectionTool_SetStructValueByMap);
+DEFINE_STAT(STAT_ReflectionTool_GetStructPropertyMap);
+DEFINE_STAT(STAT_ReflectionTool_SetStructPropertyByMap);
+DEFINE_STAT(STAT_ReflectionTool_WatchTick);
+DEFINE_STAT(STAT_ReflectionTool_ImportJson);
+DEFINE_STAT(STAT_ReflectionTool_QueryStructArray);
+DEFINE_STAT(STAT_ReflectionTool_StructColumns);
+DEFINE_STAT(STAT_ReflectionTool_HashStruct);
+DEFINE_STAT(STAT_ReflectionTool_CaptureSnapshot);
+DEFINE_STAT(STAT_ReflectionTool_CopyStructByName);
+DEFINE_STAT(STAT_ReflectionTool_StructArchive);
+DEFINE_STAT(STAT_ReflectionTool_SnapshotStore);
+DEFINE_STAT(STAT_ReflectionTool_RemoteTick);
+DEFINE_STAT(STAT_ReflectionTool_ConvertJob);
+
+DEFINE_STAT(STAT_ReflectionTool_NodesProduced);
+DEFINE_STAT(STAT_ReflectionTool_PropertiesVisited);
+DEFINE_STAT(STAT_ReflectionTool_BytesAllocated);
+
+std::atomic<uint64> FReflectionToolCounters::NodesProduced{0};
+std::atomic<uint64> FReflectionToolCounters::PropertiesVisited{0};
+std::atomic<uint64> FReflectionToolCounters::BytesAllocated{0};
+std::atomic<uint64> FReflectionToolCounters::EntryCalls{0};
+
+thread_local uint64 FReflectionToolPendingCounters::PropertiesVisited = 0;
+
+FReflectionToolPendingCounters::~FReflectionToolPendingCounters()
+{
+	REFLECTIONTOOL_COUNTER_ADD(PropertiesVisited, FReflectionToolPendingCounters::PropertiesVisited);
+	FReflectionToolPendingCounters::PropertiesVisited = 0;
+}
+
+FReflectionToolContextCounters::~FReflectionToolContextCounters()
+{
+	REFLECTIONTOOL_COUNTER_ADD(NodesProduced, Context.NodeCount - NodeCount);
+	REFLECTIONTOOL_COUNTER_ADD(PropertiesVisited, Context.PropertiesVisited - PropertiesVisited);
+	REFLECTIONTOOL_COUNTER_ADD(BytesAllocated, Context.ByteCount - ByteCount);
+}
+
+static FAutoConsoleCommandWithOutputDevice GReflectionToolDumpStatsCommand(
+	TEXT("ReflectionTool.DumpStats"),
+	TEXT("Dump accumulated ReflectionTool conversion counters since startup (or last ResetStats)."),
+	FConsoleCommandWithOutputDeviceDelegate::CreateLambda([](FOutputDevice& Ar)
+	{
+		Ar.Logf(TEXT("ReflectionTool stats:"));
+		Ar.Logf(TEXT("  Entry calls        : %llu"), FReflectionToolCounters::EntryCalls.load(std::memory_order_relaxed));
+		Ar.Logf(TEXT("  Nodes produced     : %llu"), FReflectionToolCounters::NodesProduced.load(std::memory_order_relaxed));
+		Ar.Logf(TEXT("  Properties visited : %llu"), FReflectionToolCounters::PropertiesVisited.load(std::memory_order_relaxed));
+		Ar.Logf(TEXT("  Bytes allocated    : %llu"), FReflectionToolCounters::BytesAllocated.load(std::memory_order_relaxed));
+	}));
+
+static FAutoConsoleCommand GReflectionToolResetStatsCommand(
+	TEXT("ReflectionTool.ResetStats"),
+	TEXT("Reset accumulated ReflectionTool conversion counters."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FReflectionToolCounters::EntryCalls = 0;
+		FReflectionToolCounters::NodesProduced = 0;
+		FReflectionToolCounters::PropertiesVisited = 0;
+		FReflectionToolCounters::BytesAllocated = 0;
+	}));
+
+#endif
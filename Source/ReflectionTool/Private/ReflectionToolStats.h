@@ -0,0 +1,126 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ReflectionToolLib.h"
+#include <atomic>
+
+// Shipping 下所有统计代码完全移除
+#define REFLECTIONTOOL_STATS (!UE_BUILD_SHIPPING)
+
+#if REFLECTIONTOOL_STATS
+
+DECLARE_STATS_GROUP(TEXT("ReflectionTool"), STATGROUP_ReflectionTool, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GetStructProperty"), STAT_ReflectionTool_GetStructProperty, STATGROUP_ReflectionTool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GetPropertyParserStruct"), STAT_ReflectionTool_GetPropertyParserStruct, STATGROUP_ReflectionTool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GetObjectGraph"), STAT_ReflectionTool_GetObjectGraph, STATGROUP_ReflectionTool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ParserPropertyParserStruct"), STAT_ReflectionTool_ParserPropertyParserStruct, STATGROUP_ReflectionTool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ParserPropertyParserStructAsync"), STAT_ReflectionTool_ParserPropertyParserStructAsync, STATGROUP_ReflectionTool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("InvokeFunctionByName_Map"), STAT_ReflectionTool_InvokeFunctionByName_Map, STATGROUP_ReflectionTool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("InvokeFunctionByName_Array"), STAT_ReflectionTool_InvokeFunctionByName_Array, STATGROUP_ReflectionTool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("SetStructValueByMap"), STAT_ReflectionTool_SetStructValueByMap, STATGROUP_ReflectionTool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GetStructPropertyMap"), STAT_ReflectionTool_GetStructPropertyMap, STATGROUP_ReflectionTool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("SetStructPropertyByMap"), STAT_ReflectionTool_SetStructPropertyByMap, STATGROUP_ReflectionTool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("WatchTick"), STAT_ReflectionTool_WatchTick, STATGROUP_ReflectionTool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ImportJson"), STAT_ReflectionTool_ImportJson, STATGROUP_ReflectionTool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("QueryStructArray"), STAT_ReflectionTool_QueryStructArray, STATGROUP_ReflectionTool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("StructColumns"), STAT_ReflectionTool_StructColumns, STATGROUP_ReflectionTool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("HashStruct"), STAT_ReflectionTool_HashStruct, STATGROUP_ReflectionTool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("CaptureSnapshot"), STAT_ReflectionTool_CaptureSnapshot, STATGROUP_ReflectionTool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("CopyStructByName"), STAT_ReflectionTool_CopyStructByName, STATGROUP_ReflectionTool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("StructArchive"), STAT_ReflectionTool_StructArchive, STATGROUP_ReflectionTool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("SnapshotStore"), STAT_ReflectionTool_SnapshotStore, STATGROUP_ReflectionTool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("RemoteTick"), STAT_ReflectionTool_RemoteTick, STATGROUP_ReflectionTool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ConvertJob"), STAT_ReflectionTool_ConvertJob, STATGROUP_ReflectionTool, );
+
+// 每帧清零的计数，用 stat ReflectionTool 查看；Bytes Allocated 为 FPPSConvertContext::ByteCount 的估算（节点本身 + 字符串）
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Nodes Produced"), STAT_ReflectionTool_NodesProduced, STATGROUP_ReflectionTool, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Properties Visited"), STAT_ReflectionTool_PropertiesVisited, STATGROUP_ReflectionTool, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bytes Allocated"), STAT_ReflectionTool_BytesAllocated, STATGROUP_ReflectionTool, );
+
+// 进程内累计值，用 ReflectionTool.DumpStats 输出
+struct FReflectionToolCounters
+{
+	static std::atomic<uint64> NodesProduced;
+	static std::atomic<uint64> PropertiesVisited;
+	static std::atomic<uint64> BytesAllocated;
+	static std::atomic<uint64> EntryCalls;
+};
+
+// 转换过程中只累加到 FPPSConvertContext，入口返回时把本次调用新增的部分一次发布
+struct FReflectionToolContextCounters
+{
+	explicit FReflectionToolContextCounters(const FPPSConvertContext& InContext)
+		: Context(InContext)
+		, NodeCount(InContext.NodeCount)
+		, PropertiesVisited(InContext.PropertiesVisited)
+		, ByteCount(InContext.ByteCount)
+	{
+	}
+
+	~FReflectionToolContextCounters();
+
+	const FPPSConvertContext& Context;
+	const int32 NodeCount;
+	const int32 PropertiesVisited;
+	const int64 ByteCount;
+};
+
+// 没有 Context 的路径（PPS / Map 应用到结构体）先累加到线程局部的普通计数，入口返回时一次发布
+struct FReflectionToolPendingCounters
+{
+	FReflectionToolPendingCounters() = default;
+	~FReflectionToolPendingCounters();
+
+	static thread_local uint64 PropertiesVisited;
+};
+
+// 公共入口：Insights 事件 + stat 耗时 + 调用次数，只放在公共入口上，递归 / 内部函数不加
+#define REFLECTIONTOOL_SCOPE(Name) \
+	TRACE_CPUPROFILER_EVENT_SCOPE(ReflectionTool_##Name); \
+	SCOPE_CYCLE_COUNTER(STAT_ReflectionTool_##Name); \
+	FReflectionToolCounters::EntryCalls.fetch_add(1, std::memory_order_relaxed)
+
+#define REFLECTIONTOOL_COUNTER_ADD(Name, Value) \
+	do \
+	{ \
+		const uint64 ReflectionToolCounterValue = static_cast<uint64>(Value); \
+		INC_DWORD_STAT_BY(STAT_ReflectionTool_##Name, ReflectionToolCounterValue); \
+		FReflectionToolCounters::Name.fetch_add(ReflectionToolCounterValue, std::memory_order_relaxed); \
+	} while (0)
+
+#define REFLECTIONTOOL_COUNTER_ACCUMULATE(Name, Value) \
+	FReflectionToolPendingCounters::Name += static_cast<uint64>(Value)
+
+// 作用域结束时发布线程局部计数
+#define REFLECTIONTOOL_PENDING_COUNTERS() \
+	const FReflectionToolPendingCounters ReflectionToolPendingCounters
+
+// 发布 Context 在当前作用域内新增的计数
+#define REFLECTIONTOOL_CONTEXT_COUNTERS(Context) \
+	const FReflectionToolContextCounters ReflectionToolContextCounters(Context)
+
+// PPS 转换入口：ContextPtr 为空时改用本地 Context 累计计数（默认选项，不影响转换结果）
+#define REFLECTIONTOOL_CONVERT_SCOPE(Name, ContextPtr) \
+	REFLECTIONTOOL_SCOPE(Name); \
+	FPPSConvertContext ReflectionToolLocalContext; \
+	if (!ContextPtr) \
+	{ \
+		ContextPtr = &ReflectionToolLocalContext; \
+	} \
+	REFLECTIONTOOL_CONTEXT_COUNTERS(*ContextPtr)
+
+#else
+
+#define REFLECTIONTOOL_SCOPE(Name)
+#define REFLECTIONTOOL_COUNTER_ADD(Name, Value) do {} while (0)
+#define REFLECTIONTOOL_COUNTER_ACCUMULATE(Name, Value) do {} while (0)
+#define REFLECTIONTOOL_PENDING_COUNTERS()
+#define REFLECTIONTOOL_CONTEXT_COUNTERS(Context)
+#define REFLECTIONTOOL_CONVERT_SCOPE(Name, ContextPtr)
+
+#endif
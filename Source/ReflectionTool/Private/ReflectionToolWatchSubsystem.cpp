@@ -0,0 +1,309 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#include "ReflectionToolWatchSubsystem.h"
+
+#include "ReflectionPropertyPath.h"
+#include "ReflectionTool.h"
+#include "ReflectionStructLayout.h"
+#include "ReflectionToolLib.h"
+#include "ReflectionToolStats.h"
+
+UReflectionToolWatchSubsystem::FValueSnapshot::FValueSnapshot(const FProperty* InProperty, int32 InArrayDim)
+	: Property(InProperty)
+	, ArrayDim(InArrayDim)
+	, Size(InProperty->ElementSize * InArrayDim)
+	// 位域 bool 与其他位共用一个字节，不能按字节比较
+	, bPlainOldData(InProperty->HasAnyPropertyFlags(CPF_IsPlainOldData) && !InProperty->IsA<FBoolProperty>())
+	, bBytewiseIdentical(bPlainOldData && !InProperty->IsA<FFloatProperty>() && !InProperty->IsA<FDoubleProperty>()
+		&& !InProperty->IsA<FNameProperty>() && !InProperty->IsA<FStructProperty>())
+{
+	if (const FStructProperty* StructProperty = CastField<FStructProperty>(InProperty))
+	{
+		// POD 结构体也可能含 float（FVector 等），比较时按布局逐段处理
+		Layout = FReflectionStructLayout::Get(StructProperty->Struct);
+	}
+	Data = static_cast<uint8*>(FMemory::Malloc(Size, InProperty->GetMinAlignment()));
+	if (bPlainOldData)
+	{
+		FMemory::Memzero(Data, Size);
+	}
+	else
+	{
+		for (int32 i = 0; i < ArrayDim; ++i)
+		{
+			Property->InitializeValue(Data + i * Property->ElementSize);
+		}
+	}
+}
+
+UReflectionToolWatchSubsystem::FValueSnapshot::~FValueSnapshot()
+{
+	if (!bPlainOldData)
+	{
+		for (int32 i = 0; i < ArrayDim; ++i)
+		{
+			Property->DestroyValue(Data + i * Property->ElementSize);
+		}
+	}
+	FMemory::Free(Data);
+}
+
+bool UReflectionToolWatchSubsystem::FValueSnapshot::Matches(const void* Addr) const
+{
+	if (bBytewiseIdentical)
+	{
+		return FMemory::Memcmp(Data, Addr, Size) == 0;
+	}
+	const uint8* Other = static_cast<const uint8*>(Addr);
+	for (int32 i = 0; i < ArrayDim; ++i)
+	{
+		if (Layout.IsValid())
+		{
+			if (!Layout->Identical(Data + i * Property->ElementSize, Other + i * Property->ElementSize))
+				return false;
+			continue;
+		}
+		if (!Property->Identical(Data + i * Property->ElementSize, Other + i * Property->ElementSize, PPF_None))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void UReflectionToolWatchSubsystem::FValueSnapshot::Store(const void* Addr)
+{
+	if (bPlainOldData)
+	{
+		FMemory::Memcpy(Data, Addr, Size);
+		return;
+	}
+	const uint8* Src = static_cast<const uint8*>(Addr);
+	for (int32 i = 0; i < ArrayDim; ++i)
+	{
+		if (Layout.IsValid())
+		{
+			Layout->Copy(Data + i * Property->ElementSize, Src + i * Property->ElementSize);
+			continue;
+		}
+		Property->CopySingleValue(Data + i * Property->ElementSize, Src + i * Property->ElementSize);
+	}
+}
+
+void UReflectionToolWatchSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	ReflectionDataChangingHandle = FReflectionToolModule::OnReflectionDataChanging().AddUObject(this, &UReflectionToolWatchSubsystem::HandleReflectionDataChanging);
+	ReflectionDataChangedHandle = FReflectionToolModule::OnReflectionDataChanged().AddUObject(this, &UReflectionToolWatchSubsystem::HandleReflectionDataChanged);
+}
+
+void UReflectionToolWatchSubsystem::Deinitialize()
+{
+	FReflectionToolModule::OnReflectionDataChanging().Remove(ReflectionDataChangingHandle);
+	FReflectionToolModule::OnReflectionDataChanged().Remove(ReflectionDataChangedHandle);
+	ClearPropertyWatches();
+	Super::Deinitialize();
+}
+
+void UReflectionToolWatchSubsystem::HandleReflectionDataChanging()
+{
+	for (FPropertyWatch& Watch : Watches)
+	{
+		Watch.Snapshot.Reset();
+		Watch.Path.Reset();
+		Watch.bResolved = false;
+	}
+}
+
+void UReflectionToolWatchSubsystem::HandleReflectionDataChanged()
+{
+	for (FPropertyWatch& Watch : Watches)
+	{
+		UObject* Object = Watch.Object.Get();
+		Watch.Snapshot.Reset();
+		Watch.Path = Object ? FReflectionPropertyPath::Compile(Object->GetClass(), Watch.PathString) : nullptr;
+		Watch.bResolved = false;
+		if (!Watch.Path)
+		{
+			Watch.Handle = INDEX_NONE;
+			Watch.Object.Reset();
+			continue;
+		}
+		Watch.Snapshot = MakeUnique<FValueSnapshot>(Watch.Path->LeafProperty, Watch.Path->GetLeafArrayDim());
+		if (const void* Addr = Watch.Path->Resolve(static_cast<void*>(Object)))
+		{
+			Watch.Snapshot->Store(Addr);
+			Watch.bResolved = true;
+		}
+	}
+	if (!bBroadcasting)
+	{
+		Watches.RemoveAllSwap([](const FPropertyWatch& Item) { return Item.Handle == INDEX_NONE; });
+	}
+}
+
+TStatId UReflectionToolWatchSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UReflectionToolWatchSubsystem, STATGROUP_Tickables);
+}
+
+int32 UReflectionToolWatchSubsystem::AddPropertyWatch(UObject* Object, const FString& PropertyPath,
+	FOnPropertyWatchChangedDynamic OnChanged)
+{
+	return AddWatchInternal(Object, PropertyPath, OnChanged);
+}
+
+int32 UReflectionToolWatchSubsystem::AddPropertyWatch(UObject* Object, const FString& PropertyPath)
+{
+	return AddWatchInternal(Object, PropertyPath, FOnPropertyWatchChangedDynamic());
+}
+
+int32 UReflectionToolWatchSubsystem::AddWatchInternal(UObject* Object, const FString& PropertyPath,
+	const FOnPropertyWatchChangedDynamic& OnChanged)
+{
+	if (!Object)
+		return INDEX_NONE;
+	TSharedPtr<const FReflectionPropertyPath> Path = FReflectionPropertyPath::Compile(Object->GetClass(), PropertyPath);
+	if (!Path)
+		return INDEX_NONE;
+
+	FPropertyWatch& Watch = Watches.AddDefaulted_GetRef();
+	Watch.Handle = NextHandle++;
+	Watch.Object = Object;
+	Watch.PathString = PropertyPath;
+	Watch.Path = Path;
+	Watch.OnChanged = OnChanged;
+	Watch.Snapshot = MakeUnique<FValueSnapshot>(Path->LeafProperty, Path->GetLeafArrayDim());
+	// 记录初始值，注册本身不触发事件
+	if (const void* Addr = Path->Resolve(static_cast<void*>(Object)))
+	{
+		Watch.Snapshot->Store(Addr);
+		Watch.bResolved = true;
+	}
+	return Watch.Handle;
+}
+
+bool UReflectionToolWatchSubsystem::RemovePropertyWatch(int32 WatchHandle)
+{
+	// 广播过程中只做标记，等本帧广播结束统一移除，避免下标失效
+	for (FPropertyWatch& Watch : Watches)
+	{
+		if (Watch.Handle == WatchHandle)
+		{
+			Watch.Handle = INDEX_NONE;
+			Watch.Object.Reset();
+			if (!bBroadcasting)
+			{
+				Watches.RemoveAllSwap([](const FPropertyWatch& Item) { return Item.Handle == INDEX_NONE; });
+			}
+			return true;
+		}
+	}
+	return false;
+}
+
+void UReflectionToolWatchSubsystem::RemoveAllWatchesForObject(UObject* Object)
+{
+	for (FPropertyWatch& Watch : Watches)
+	{
+		if (Watch.Object.Get() == Object)
+		{
+			Watch.Handle = INDEX_NONE;
+			Watch.Object.Reset();
+		}
+	}
+	if (!bBroadcasting)
+	{
+		Watches.RemoveAllSwap([](const FPropertyWatch& Item) { return Item.Handle == INDEX_NONE; });
+	}
+}
+
+void UReflectionToolWatchSubsystem::ClearPropertyWatches()
+{
+	if (bBroadcasting)
+	{
+		for (FPropertyWatch& Watch : Watches)
+		{
+			Watch.Handle = INDEX_NONE;
+			Watch.Object.Reset();
+		}
+		return;
+	}
+	Watches.Empty();
+}
+
+void UReflectionToolWatchSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	REFLECTIONTOOL_SCOPE(WatchTick);
+	REFLECTIONTOOL_COUNTER_ADD(PropertiesVisited, Watches.Num());
+
+	// 第一遍：只做比较，记录变化的下标
+	ChangedScratch.Reset();
+	bool bHasStale = false;
+	for (int32 Index = 0, Num = Watches.Num(); Index < Num; ++Index)
+	{
+		FPropertyWatch& Watch = Watches[Index];
+		UObject* Object = Watch.Object.Get();
+		if (!Object || !Watch.Path)
+		{
+			bHasStale = true;
+			continue;
+		}
+		const void* Addr = Watch.Path->Resolve(static_cast<void*>(Object));
+		const bool bResolved = Addr != nullptr;
+		if (bResolved != Watch.bResolved || (bResolved && !Watch.Snapshot->Matches(Addr)))
+		{
+			if (bResolved)
+			{
+				Watch.Snapshot->Store(Addr);
+			}
+			Watch.bResolved = bResolved;
+			ChangedScratch.Add(Index);
+		}
+	}
+
+	// 第二遍：统一广播，回调中增删监听不影响本帧的遍历
+	if (ChangedScratch.Num() > 0)
+	{
+		TGuardValue<bool> BroadcastGuard(bBroadcasting, true);
+		for (const int32 Index : ChangedScratch)
+		{
+			if (Watches[Index].Handle != INDEX_NONE)
+			{
+				BroadcastChange(Watches[Index], Watches[Index].bResolved ? Watches[Index].Snapshot->Data : nullptr);
+			}
+		}
+	}
+
+	// 对象已销毁 / 广播中被移除的监听
+	if (bHasStale || ChangedScratch.Num() > 0)
+	{
+		Watches.RemoveAllSwap([](const FPropertyWatch& Item)
+		{
+			return Item.Handle == INDEX_NONE || !Item.Object.IsValid() || !Item.Path;
+		});
+	}
+}
+
+void UReflectionToolWatchSubsystem::BroadcastChange(const FPropertyWatch& Watch, const void* NewValueAddr)
+{
+	// 拷贝一份，回调中新增监听可能导致 Watches 重新分配
+	const int32 Handle = Watch.Handle;
+	UObject* Object = Watch.Object.Get();
+	const FReflectionPropertyPath* Path = Watch.Path.Get();
+	const FOnPropertyWatchChangedDynamic OnChanged = Watch.OnChanged;
+
+	OnPropertyWatchChangedNative.Broadcast(Handle, Object, Path->LeafProperty, NewValueAddr);
+
+	// 只有蓝图侧绑定时才导出字符串
+	if (!OnChanged.IsBound() && !OnPropertyWatchChanged.IsBound())
+		return;
+	FString NewValue;
+	if (NewValueAddr)
+	{
+		Path->LeafProperty->ExportTextItem_Direct(NewValue, NewValueAddr, nullptr, nullptr, PPF_None);
+	}
+	OnChanged.ExecuteIfBound(Handle, Object, Path->PathString, NewValue);
+	OnPropertyWatchChanged.Broadcast(Handle, Object, Path->PathString, NewValue);
+}
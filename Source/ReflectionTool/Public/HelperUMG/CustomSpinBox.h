@@ -7,6 +7,8 @@
 #include "Components/SpinBox.h"
 #include "CustomSpinBox.generated.h"
 
+struct FReflectionPropertyPath;
+
 /**
  * 
  */
@@ -17,4 +19,28 @@ class REFLECTIONTOOL_API UCustomSpinBox : public USpinBox
 public:
 	UFUNCTION(BlueprintCallable, Category = "ReflectionTool|HelperUMG")
 	void SetTextSize(int32 NewSize);
+
+	/**
+	 * @brief 绑定对象上的数值属性：读取当前值，之后每次 OnValueChanged 只写回该属性
+	 * @param Target 
+	 * @param PropertyPath 例如 "Stats.Health"、"Items[3].Damage"
+	 * @return 路径无效或不是数值属性时返回 false
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ReflectionTool|HelperUMG")
+	bool BindPropertyPath(UObject* Target, const FString& PropertyPath);
+
+	UFUNCTION(BlueprintCallable, Category = "ReflectionTool|HelperUMG")
+	void UnbindPropertyPath();
+
+private:
+	UFUNCTION()
+	void HandleBoundValueChanged(float InValue);
+
+	// 反射数据变化后按原路径重新编译，失败时解除绑定
+	void HandleReflectionDataChanged();
+
+	TWeakObjectPtr<UObject> BoundObject;
+	// 编译好的路径，拖动时不再查找缓存
+	TSharedPtr<const FReflectionPropertyPath> BoundPath;
+	FDelegateHandle ReflectionDataChangedHandle;
 };
@@ -0,0 +1,75 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReflectionToolLib.h"
+
+class FReflectionPPSDump;
+
+/**
+ * UPPSTreeViewProvider 的数据来源：节点按广度优先编号，下标 0 为根节点（不显示），同一节点的子节点下标连续
+ */
+class REFLECTIONTOOL_API IPPSTreeSource
+{
+public:
+	virtual ~IPPSTreeSource() = default;
+
+	virtual int32 GetNumNodes() const = 0;
+	virtual int32 GetFirstChild(int32 NodeIndex) const = 0;
+	virtual int32 GetNumChildren(int32 NodeIndex) const = 0;
+	// 根节点的子节点深度为 0
+	virtual int32 GetDepth(int32 NodeIndex) const = 0;
+	virtual FString GetName(int32 NodeIndex) const = 0;
+	virtual FString GetTypeName(int32 NodeIndex) const = 0;
+	virtual FString GetValue(int32 NodeIndex) const = 0;
+
+	// 内存中的 PPS 返回节点本身，其余来源返回 nullptr
+	virtual const FPropertyParserStruct* GetNode(int32 NodeIndex) const { return nullptr; }
+};
+
+// 内存中的 PPS 树，构造时展平为下标数组
+class REFLECTIONTOOL_API FPPSMemoryTreeSource : public IPPSTreeSource
+{
+public:
+	explicit FPPSMemoryTreeSource(FPropertyParserStruct&& InRoot);
+
+	virtual int32 GetNumNodes() const override { return Nodes.Num(); }
+	virtual int32 GetFirstChild(int32 NodeIndex) const override { return Nodes.IsValidIndex(NodeIndex) ? Nodes[NodeIndex].FirstChild : 0; }
+	virtual int32 GetNumChildren(int32 NodeIndex) const override { return Nodes.IsValidIndex(NodeIndex) ? Nodes[NodeIndex].NumChildren : 0; }
+	virtual int32 GetDepth(int32 NodeIndex) const override { return Nodes.IsValidIndex(NodeIndex) ? Nodes[NodeIndex].Depth : 0; }
+	virtual FString GetName(int32 NodeIndex) const override;
+	virtual FString GetTypeName(int32 NodeIndex) const override;
+	virtual FString GetValue(int32 NodeIndex) const override;
+	virtual const FPropertyParserStruct* GetNode(int32 NodeIndex) const override { return Nodes.IsValidIndex(NodeIndex) ? Nodes[NodeIndex].Node : nullptr; }
+
+private:
+	struct FFlatNode
+	{
+		const FPropertyParserStruct* Node = nullptr;
+		int32 Depth = 0;
+		int32 FirstChild = 0;
+		int32 NumChildren = 0;
+	};
+
+	FPropertyParserStruct Root;
+	TArray<FFlatNode> Nodes;
+};
+
+// 内存映射的 PPS 转储文件，节点在访问时才读取
+class REFLECTIONTOOL_API FPPSDumpTreeSource : public IPPSTreeSource
+{
+public:
+	explicit FPPSDumpTreeSource(TSharedRef<const FReflectionPPSDump> InDump) : Dump(MoveTemp(InDump)) {}
+
+	virtual int32 GetNumNodes() const override;
+	virtual int32 GetFirstChild(int32 NodeIndex) const override;
+	virtual int32 GetNumChildren(int32 NodeIndex) const override;
+	virtual int32 GetDepth(int32 NodeIndex) const override;
+	virtual FString GetName(int32 NodeIndex) const override;
+	virtual FString GetTypeName(int32 NodeIndex) const override;
+	virtual FString GetValue(int32 NodeIndex) const override;
+
+private:
+	TSharedRef<const FReflectionPPSDump> Dump;
+};
@@ -0,0 +1,139 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "ReflectionToolLib.h"
+#include "PPSTreeViewProvider.generated.h"
+
+class IPPSTreeSource;
+class UPPSTreeViewProvider;
+class UTreeView;
+
+/**
+ * TreeView 的数据对象，记录 PPS 树中的节点下标与节点路径，由 UPPSTreeViewProvider 创建与回收
+ */
+UCLASS(BlueprintType)
+class REFLECTIONTOOL_API UPPSTreeViewItem : public UObject
+{
+	GENERATED_BODY()
+public:
+	// 对应的 PPS 节点，Provider 刷新后可能指向新的数据；数据来自转储文件时为 nullptr
+	const FPropertyParserStruct* GetNode() const;
+
+	UFUNCTION(BlueprintPure, Category = "ReflectionTool|HelperUMG")
+	FString GetNodeName() const;
+
+	UFUNCTION(BlueprintPure, Category = "ReflectionTool|HelperUMG")
+	FString GetNodeTypeName() const;
+
+	UFUNCTION(BlueprintPure, Category = "ReflectionTool|HelperUMG")
+	FString GetNodeValue() const;
+
+	UFUNCTION(BlueprintPure, Category = "ReflectionTool|HelperUMG")
+	bool HasChildren() const;
+
+	// 根节点的子节点深度为 0
+	UFUNCTION(BlueprintPure, Category = "ReflectionTool|HelperUMG")
+	int32 GetDepth() const;
+
+	UFUNCTION(BlueprintPure, Category = "ReflectionTool|HelperUMG")
+	int32 GetNodeIndex() const { return NodeIndex; }
+
+	UFUNCTION(BlueprintPure, Category = "ReflectionTool|HelperUMG")
+	UPPSTreeViewProvider* GetProvider() const { return Provider.Get(); }
+
+private:
+	friend class UPPSTreeViewProvider;
+
+	TWeakObjectPtr<UPPSTreeViewProvider> Provider;
+	// 数据刷新后尚未被 TreeView 再次请求时为 INDEX_NONE
+	int32 NodeIndex = INDEX_NONE;
+	// 从根开始的各级名称，同名的兄弟节点（数组元素）附加序号
+	FString Path;
+	// 最近一次被请求时的数据版本
+	uint32 Generation = 0;
+};
+
+/**
+ * PPS 树的 TreeView 数据源：
+ * 节点数据来自 IPPSTreeSource（内存中的 PPS 或内存映射的转储文件），Item 只在 TreeView 请求子节点时按需创建；
+ * 刷新时按节点路径复用同一个 Item，结构变化（如数组增删元素）后 TreeView 的展开状态仍跟随原来的节点；
+ * 连续两次刷新都未被请求的 Item 放回池中，因此大结构体频繁刷新也不会产生新的 UObject
+ */
+UCLASS(BlueprintType)
+class REFLECTIONTOOL_API UPPSTreeViewProvider : public UObject
+{
+	GENERATED_BODY()
+public:
+	// 设置新的 PPS 数据，已绑定的 TreeView 会自动刷新
+	UFUNCTION(BlueprintCallable, Category = "ReflectionTool|HelperUMG")
+	void SetSource(const FPropertyParserStruct& PPS);
+	void SetSource(FPropertyParserStruct&& PPS);
+
+	/**
+	 * @brief 以内存映射方式打开 FReflectionPPSDump 写出的转储文件，只读取文件头，展开节点时才读取对应数据
+	 * 绑定到自定义 Widget 蓝图的 TreeView 时使用；只需查看时可用 UReflectionToolLib::OpenPPSDumpWindow
+	 * @param Filename 
+	 * @return 文件无效时返回 false，原数据保持不变
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ReflectionTool|HelperUMG")
+	bool OpenDumpFile(const FString& Filename);
+
+	// 使用自定义数据来源
+	void SetTreeSource(TSharedPtr<const IPPSTreeSource> InSource);
+	const IPPSTreeSource* GetTreeSource() const { return Source.Get(); }
+
+	// 绑定 TreeView：设置根 Item 与 OnGetItemChildren
+	UFUNCTION(BlueprintCallable, Category = "ReflectionTool|HelperUMG")
+	void BindTreeView(UTreeView* TreeView);
+
+	// PPS 根节点的子节点
+	UFUNCTION(BlueprintCallable, Category = "ReflectionTool|HelperUMG")
+	void GetRootItems(TArray<UObject*>& OutItems);
+
+	// 可直接用于 TreeView 的 OnGetItemChildren
+	UFUNCTION(BlueprintCallable, Category = "ReflectionTool|HelperUMG")
+	void GetChildItems(UObject* Item, TArray<UObject*>& OutChildren);
+
+	// 池中最多保留 MaxFreeItems 个空闲 Item
+	UFUNCTION(BlueprintCallable, Category = "ReflectionTool|HelperUMG")
+	void TrimPool(int32 MaxFreeItems = 0);
+
+	UFUNCTION(BlueprintPure, Category = "ReflectionTool|HelperUMG")
+	int32 GetNumNodes() const;
+
+	UFUNCTION(BlueprintPure, Category = "ReflectionTool|HelperUMG")
+	int32 GetNumLiveItems() const { return LiveItems.Num(); }
+
+	UFUNCTION(BlueprintPure, Category = "ReflectionTool|HelperUMG")
+	int32 GetNumPooledItems() const { return FreeItems.Num(); }
+
+	const FPropertyParserStruct* GetNode(int32 NodeIndex) const;
+	int32 GetNodeDepth(int32 NodeIndex) const;
+	int32 GetNodeNumChildren(int32 NodeIndex) const;
+	FString GetNodeName(int32 NodeIndex) const;
+	FString GetNodeTypeName(int32 NodeIndex) const;
+	FString GetNodeValue(int32 NodeIndex) const;
+
+private:
+	void OnSourceChanged();
+	UPPSTreeViewItem* GetOrCreateItem(int32 NodeIndex, FString&& Path);
+	void GetItemsInRange(const FString& ParentPath, int32 FirstNode, int32 NumNodes, TArray<UObject*>& OutItems);
+	void RefreshBoundTreeView();
+
+	// 下标 0 为根节点，不显示
+	TSharedPtr<const IPPSTreeSource> Source;
+
+	// 只记录已创建的 Item，GC 只遍历这些对象；按节点路径索引
+	UPROPERTY(Transient)
+	TMap<FString, TObjectPtr<UPPSTreeViewItem>> LiveItems;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UPPSTreeViewItem>> FreeItems;
+
+	TWeakObjectPtr<UTreeView> BoundTreeView;
+	// 每次设置数据加一
+	uint32 Generation = 1;
+};
@@ -0,0 +1,30 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 流式 JSON 导入：逐个读取 JSON token，直接写入结构体内存，不构建 FJsonObject DOM，也不经过 PPS
+ * 字段通过按 UStruct 缓存的属性表查找，内存占用只与嵌套深度有关，与输入大小无关
+ * FArchive 输入的编码与 FJsonStructDeserializerBackend 一致（UCS2）
+ */
+class REFLECTIONTOOL_API FReflectionJsonStreamImporter
+{
+public:
+	// 顶层为 JSON 对象，写入 StructData，未出现的字段保持原值
+	static bool ImportStruct(FArchive& Archive, const UStruct* Struct, void* StructData);
+	static bool ImportStruct(FStringView Json, const UStruct* Struct, void* StructData);
+
+	/**
+	 * 顶层为结构体数组，逐个元素回调，始终只占用一个元素的内存
+	 * @param OnElement 每个元素解析完成后调用，返回 false 停止导入
+	 */
+	static bool ImportArray(FArchive& Archive, const UScriptStruct* ElementStruct,
+		TFunctionRef<bool(const void* Element, int32 Index)> OnElement);
+	static bool ImportArray(FStringView Json, const UScriptStruct* ElementStruct,
+		TFunctionRef<bool(const void* Element, int32 Index)> OnElement);
+
+	// 清空字段查找表缓存
+	static void ClearCache();
+};
@@ -0,0 +1,53 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "ReflectionToolLib.h"
+#include "ReflectionPPSConvertAsyncAction.generated.h"
+
+class FReflectionPPSConvertJob;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPPSConvertAsyncActionCompleted, const FPropertyParserStruct&, Result);
+
+/**
+ * 蓝图异步节点：分帧转换对象为 PPS，每帧最多占用 BudgetMicroseconds，完成后从 OnCompleted 输出，见 FReflectionPPSConvertJob
+ */
+UCLASS()
+class REFLECTIONTOOL_API UReflectionPPSConvertAsyncAction : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+public:
+	/**
+	 * @brief 分帧获取对象的解析结构体，先在预算内逐帧拷贝对象的顶层属性，拷贝之后对象的修改不影响结果
+	 * @param Object 被解析的对象
+	 * @param Options 节点数 / 内存预算，不展开对象引用
+	 * @param BudgetMicroseconds 每帧最多占用的时间（微秒）
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ReflectionTool", meta = (BlueprintInternalUseOnly = "true",
+		WorldContext = "WorldContextObject", DisplayName = "Get Property Parser Struct Time Sliced"))
+	static UReflectionPPSConvertAsyncAction* GetPropertyParserStructTimeSliced(UObject* WorldContextObject, UObject* Object,
+		const FPPSConvertOptions& Options, int32 BudgetMicroseconds = 1000);
+
+	// 转换完成
+	UPROPERTY(BlueprintAssignable)
+	FOnPPSConvertAsyncActionCompleted OnCompleted;
+
+	// 对象无效或在拷贝完成前被销毁，输出为空
+	UPROPERTY(BlueprintAssignable)
+	FOnPPSConvertAsyncActionCompleted OnFailed;
+
+	virtual void Activate() override;
+	virtual void SetReadyToDestroy() override;
+
+private:
+	void HandleCompleted(const FPropertyParserStruct& Result);
+
+	UPROPERTY()
+	TObjectPtr<UObject> TargetObject;
+
+	FPPSConvertOptions ConvertOptions;
+	int32 SliceBudgetMicroseconds = 1000;
+	TSharedPtr<FReflectionPPSConvertJob> Job;
+};
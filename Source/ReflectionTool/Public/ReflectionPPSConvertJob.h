@@ -0,0 +1,130 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "ReflectionToolLib.h"
+
+class FReflectionStructSnapshot;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnPPSConvertJobCompleted, const FPropertyParserStruct& /*Result*/);
+
+/**
+ * 可分帧执行的 PPS 转换：用显式栈代替 FGetPropertyParserStruct 的递归，每次 Advance 只在给定的时间预算内生成节点，
+ * 下次调用从上次停下的位置继续，适合在游戏中转换大型结构体 / Actor 而不造成卡顿
+ * 转换的是快照，数据在分帧转换期间不会变化，结果与 FReflectionStructSnapshot::ToPPS 相同
+ * CreateForObject 的拷贝同样分帧：转换前按预算逐个拷贝对象的顶层属性，大的 TArray / TSet / TMap 再按元素分段拷贝，
+ * 各属性 / 各段可能取自不同帧；分段之间容器长度变化时该属性改为一次整体拷贝
+ * 每个叶子节点 / 每步拷贝之后都检查时钟，超出预算的部分最多为一个叶子节点的转换，或一个非容器顶层属性 / 一段容器元素的拷贝耗时
+ */
+class REFLECTIONTOOL_API FReflectionPPSConvertJob : public TSharedFromThis<FReflectionPPSConvertJob>
+{
+public:
+	/**
+	 * @brief 创建转换任务，不做任何转换
+	 * @param InSnapshot 被转换的数据，任务持有到结束
+	 * @param Options 节点数 / 内存预算，不展开对象引用
+	 */
+	static TSharedRef<FReflectionPPSConvertJob> Create(const TSharedRef<FReflectionStructSnapshot>& InSnapshot,
+		const FPPSConvertOptions& Options = FPPSConvertOptions());
+
+	/**
+	 * @brief 创建转换对象的任务，不做任何拷贝；Advance 先在预算内逐个拷贝顶层属性到快照，再开始转换，需在游戏线程调用
+	 * @param Object 拷贝完成前只弱引用，被销毁时任务以 HasFailed 结束
+	 * @param Options 节点数 / 内存预算，不展开对象引用
+	 */
+	static TSharedRef<FReflectionPPSConvertJob> CreateForObject(const UObject* Object,
+		const FPPSConvertOptions& Options = FPPSConvertOptions());
+
+	~FReflectionPPSConvertJob();
+
+	/**
+	 * @brief 在预算内继续转换，完成时广播 OnCompleted
+	 * @param BudgetMicroseconds 本次最多占用的时间（微秒），<= 0 表示一次转换完
+	 * @return 是否已完成
+	 */
+	bool Advance(double BudgetMicroseconds);
+
+	// 注册到 FTSTicker，每帧调用一次 Advance，完成后自动注销；任务需由调用方持有
+	void StartTicking(double BudgetMicroseconds);
+	// 停止分帧执行，已生成的节点保留
+	void StopTicking();
+
+	bool IsDone() const { return Stack.Num() == 0; }
+	// 对象在拷贝完成前被销毁，结果为空
+	bool HasFailed() const { return bFailed; }
+	const FPropertyParserStruct& GetResult() const { return Result; }
+	// 取走结果，之后 GetResult 为空；未完成时结果中的节点仍被栈引用，不能取走
+	FPropertyParserStruct TakeResult()
+	{
+		check(IsDone());
+		return MoveTemp(Result);
+	}
+	int32 GetNodeCount() const { return Context.NodeCount; }
+	// 已调用 Advance 的次数，即分成了多少帧
+	int32 GetNumSlices() const { return NumSlices; }
+
+	FOnPPSConvertJobCompleted& OnCompleted() { return CompletedDelegate; }
+
+private:
+	// 栈中一个正在展开的节点
+	struct FFrame
+	{
+		enum class EKind : uint8
+		{
+			// 根结构体，属性取自 RootProperties
+			Root,
+			// 结构体属性，沿 PropertyLink 遍历
+			Struct,
+			Array,
+			Set,
+			Map,
+			// Map 的一项，依次生成 Key / Value
+			MapItem,
+		};
+
+		EKind Kind;
+		// 指向父节点 Children 中的元素；父节点只在自身位于栈顶时添加子节点，因此在出栈前保持有效
+		FPropertyParserStruct* Node;
+		FProperty* Property;
+		const void* Addr;
+		// Struct：下一个属性
+		FProperty* NextField;
+		// 下一个元素的下标（Set / Map 为稀疏下标）；MapItem 为所在元素的下标
+		int32 Index;
+		// Set / Map 剩余的元素数；MapItem 剩余的 Key / Value 数
+		int32 Remaining;
+	};
+
+	FReflectionPPSConvertJob(const TSharedRef<FReflectionStructSnapshot>& InSnapshot, const FPPSConvertOptions& Options);
+
+	// 拷贝 CaptureSource 的下一个顶层属性或其下一段容器元素，对象已销毁时返回 false
+	bool CaptureNextProperty();
+	// 生成栈顶节点的下一个子节点，栈顶节点没有剩余子节点时出栈
+	void Step();
+	// 转换一个属性：叶子直接转换，结构体与容器入栈
+	void ConvertProperty(FProperty* Property, const void* Addr, FPropertyParserStruct& OutNode);
+	void PushFrame(FFrame::EKind Kind, FPropertyParserStruct& Node, FProperty* Property, const void* Addr,
+		FProperty* NextField = nullptr, int32 Index = 0, int32 Remaining = 0);
+	void PopFrame();
+	bool Tick(float DeltaTime, double BudgetMicroseconds);
+
+	TSharedRef<FReflectionStructSnapshot> Snapshot;
+	FPPSConvertContext Context;
+	FPropertyParserStruct Result;
+	// 与 FGetPropertyParserStruct 相同，根结构体按 TFieldIterator 的顺序
+	TArray<FProperty*> RootProperties;
+	TArray<FFrame> Stack;
+	// CreateForObject：尚未拷贝完的对象，与已拷贝的 RootProperties 数
+	TWeakObjectPtr<const UObject> CaptureSource;
+	int32 NumCapturedProperties = 0;
+	// 正在分段拷贝的容器：下一段的起始下标（0 表示未开始）与开始拷贝时的元素数
+	int32 CaptureElementIndex = 0;
+	int32 CaptureElementNum = 0;
+	bool bCapturing = false;
+	bool bFailed = false;
+	int32 NumSlices = 0;
+	FTSTicker::FDelegateHandle TickerHandle;
+	FOnPPSConvertJobCompleted CompletedDelegate;
+};
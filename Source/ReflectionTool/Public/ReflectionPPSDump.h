@@ -0,0 +1,128 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FPropertyParserStruct;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+namespace ReflectionPPSDump
+{
+	struct FStringWriter;
+}
+
+/**
+ * PPS 树的只读二进制转储，通过内存映射访问：
+ * 文件由 文件头 + 定长节点表 + 字符串区 组成，下标 0 为根，同一节点的子节点下标连续且大于父节点（Write 按广度优先排列），
+ * 节点表只记录子节点范围与字符串偏移；打开时只读取文件头，节点与字符串在访问时才由系统按页载入，
+ * 因此打开耗时与文件大小无关，内存占用只与实际浏览过的节点有关
+ */
+class REFLECTIONTOOL_API FReflectionPPSDump
+{
+public:
+	// 把 PPS 树写入文件，Name / TypeName 相同的字符串只存一份
+	static bool Write(const FPropertyParserStruct& Root, const FString& Filename);
+
+	// 映射文件并检查文件头，失败返回空指针
+	static TSharedPtr<FReflectionPPSDump> Open(const FString& Filename);
+
+	~FReflectionPPSDump();
+
+	int32 GetNumNodes() const { return NumNodes; }
+	// 下标无效时返回 0 / 空字符串
+	int32 GetFirstChild(int32 NodeIndex) const;
+	int32 GetNumChildren(int32 NodeIndex) const;
+	int32 GetDepth(int32 NodeIndex) const;
+	bool IsTruncated(int32 NodeIndex) const;
+	FString GetName(int32 NodeIndex) const;
+	FString GetTypeName(int32 NodeIndex) const;
+	FString GetValue(int32 NodeIndex) const;
+
+	// 把以 NodeIndex 为根的子树还原为 PPS
+	void ToPPS(int32 NodeIndex, FPropertyParserStruct& OutPPS) const;
+
+private:
+	friend class FReflectionPPSDumpWriter;
+
+	// 节点表中的一项，按文件中的布局定义
+	struct FNodeRecord
+	{
+		int32 FirstChild;
+		int32 NumChildren;
+		int32 Depth;
+		uint32 Flags;
+		int64 NameOffset;
+		int64 TypeOffset;
+		int64 ValueOffset;
+		int32 NameLength;
+		int32 TypeLength;
+		int32 ValueLength;
+		int32 Reserved;
+	};
+
+	FReflectionPPSDump();
+
+	// 写入节点自身的标记、子节点数与字符串，不设置 FirstChild / Depth
+	static void FillRecord(FNodeRecord& Record, const FPropertyParserStruct& Node, ReflectionPPSDump::FStringWriter& Strings);
+
+	// 把 Parent 的所有后代按广度优先追加到 OutRecords，追加的第一个节点在文件中的下标为 BaseIndex
+	static void FlattenChildren(const FPropertyParserStruct& Parent, int32 ParentDepth, int64 BaseIndex,
+		ReflectionPPSDump::FStringWriter& Strings, TArray<FNodeRecord>& OutRecords);
+
+	// 写入文件头与节点表之前的对齐
+	static void WriteHeader(FArchive& Ar, int32 NumNodes, int64 StringsSize);
+
+	const FNodeRecord* GetRecord(int32 NodeIndex) const;
+	FString GetString(int64 Offset, int32 Length) const;
+
+	TUniquePtr<IMappedFileHandle> FileHandle;
+	TUniquePtr<IMappedFileRegion> Region;
+	const uint8* Data = nullptr;
+	int64 DataSize = 0;
+	const FNodeRecord* Records = nullptr;
+	int32 NumNodes = 0;
+	// 字符串区在文件中的偏移与大小
+	int64 StringsOffset = 0;
+	int64 StringsSize = 0;
+};
+
+/**
+ * 流式写入 PPS 转储，文件格式与 FReflectionPPSDump::Write 相同，适合无法整棵放入内存的树（如整张地图的导出）
+ * 根节点的子树逐个 Add，写出后即可释放：子树的后代按广度优先写入临时节点文件，字符串写入临时字符串文件，
+ * 内存中只保留每个子树根的一条节点记录与名称池；Close 时依次写出 根、各子树的根、临时节点（平移下标）、字符串区
+ */
+class REFLECTIONTOOL_API FReflectionPPSDumpWriter
+{
+public:
+	FReflectionPPSDumpWriter(const FString& InFilename, const FString& RootName, const FString& RootTypeName);
+	// 未 Close 时删除临时文件，不生成输出文件
+	~FReflectionPPSDumpWriter();
+
+	// 临时文件已创建且没有写入错误
+	bool IsValid() const;
+
+	// 追加根节点的一个子节点（含整棵子树）
+	void Add(const FPropertyParserStruct& Child);
+
+	int32 GetNumChildren() const { return TopRecords.Num(); }
+
+	// 合并临时文件写出最终文件
+	bool Close();
+
+private:
+	void DeleteTempFiles();
+
+	FString Filename;
+	FString NodesFilename;
+	FString StringsFilename;
+	TUniquePtr<FArchive> NodesWriter;
+	TUniquePtr<FArchive> StringsWriter;
+	TUniquePtr<ReflectionPPSDump::FStringWriter> Strings;
+	FReflectionPPSDump::FNodeRecord RootRecord;
+	// 各子树的根，FirstChild 为临时节点文件中的下标，Close 时平移
+	TArray<FReflectionPPSDump::FNodeRecord> TopRecords;
+	int64 NumTempNodes = 0;
+	bool bClosed = false;
+};
@@ -0,0 +1,246 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/UnrealType.h"
+
+/**
+ * 编译后的属性路径，例如 "Stats.Health"、"Items[3].Damage"、"Attributes[Speed]"
+ * 编译时把路径拆成 (FProperty, 下标) 链并缓存，解析时只做偏移与容器下标查找
+ */
+struct REFLECTIONTOOL_API FReflectionPropertyPath
+{
+	enum class ESegmentKind : uint8
+	{
+		// 结构体 / 类的成员
+		Member,
+		// TArray 元素
+		ArrayElement,
+		// 静态数组元素 (int32 Values[4])
+		StaticArrayElement,
+		// TMap 中 Key 对应的 Value
+		MapValue,
+	};
+
+	// MapValue 的 Key，编译时导入一次，解析时直接按哈希查找
+	struct FMapKey
+	{
+		explicit FMapKey(const FProperty* InKeyProperty);
+		~FMapKey();
+		FMapKey(const FMapKey&) = delete;
+		FMapKey& operator=(const FMapKey&) = delete;
+
+		const FProperty* KeyProperty = nullptr;
+		uint8* Data = nullptr;
+	};
+
+	// 叶子属性的类型，编译时确定，读写时不再 CastField
+	enum class ELeafKind : uint8
+	{
+		Bool,
+		Integer,
+		Float,
+		// FEnumProperty 或带 UEnum 的 FByteProperty，LeafNumeric 为底层整数属性
+		Enum,
+		String,
+		Name,
+		Text,
+		// 其余类型通过 ImportText / ExportText 读写
+		Other,
+	};
+
+	struct FSegment
+	{
+		// 所在容器中的成员属性
+		FProperty* Property = nullptr;
+		// 取完成员后对元素的处理方式
+		ESegmentKind Kind = ESegmentKind::Member;
+		// 元素下标，Kind 为 Member 时无效
+		int32 Index = INDEX_NONE;
+		// Kind 为 MapValue 时的 Key
+		TSharedPtr<const FMapKey> Key;
+	};
+
+	// 路径起点的结构体 / 类
+	TWeakObjectPtr<const UStruct> OwnerStruct;
+	// 原始路径字符串
+	FString PathString;
+	TArray<FSegment> Segments;
+	// 路径末端的属性（数组元素时为 Inner）
+	FProperty* LeafProperty = nullptr;
+	ELeafKind LeafKind = ELeafKind::Other;
+	// Integer / Float / Enum 叶子的数值属性
+	const FNumericProperty* LeafNumeric = nullptr;
+	// Enum 叶子的枚举
+	const UEnum* LeafEnum = nullptr;
+	// 编译时的缓存代数，ClearCache 之后旧路径中的 FProperty* 可能已失效
+	uint32 CacheGeneration = 0;
+
+	bool IsValid() const;
+
+	// 路径可用于 Struct 类型的容器（Struct 为起点或其子类）
+	bool IsValidFor(const UStruct* Struct) const { return IsValid() && Struct && Struct->IsChildOf(OwnerStruct.Get()); }
+
+	// 叶子值包含的元素个数，路径停在静态数组本身时为 ArrayDim，否则为 1
+	int32 GetLeafArrayDim() const
+	{
+		return Segments.Num() > 0 && Segments.Last().Kind != ESegmentKind::Member ? 1 : LeafProperty->ArrayDim;
+	}
+
+	// 路径只经过成员 / 静态数组元素时，叶子相对容器起点的固定偏移，否则返回 INDEX_NONE
+	int32 GetFixedOffset() const;
+
+	// 从容器地址解析出叶子属性的值地址，数组越界 / Map 中没有 Key 时返回 nullptr
+	void* Resolve(void* Container) const;
+	const void* Resolve(const void* Container) const { return Resolve(const_cast<void*>(Container)); }
+
+	// 解析出可读写的叶子地址，路径停在整个静态数组上时返回 nullptr
+	void* ResolveLeaf(void* Container) const { return GetLeafArrayDim() == 1 ? Resolve(Container) : nullptr; }
+	const void* ResolveLeaf(const void* Container) const { return ResolveLeaf(const_cast<void*>(Container)); }
+
+	// 只写入路径末端的一个属性：枚举按名称，数值按字符串解析，其余类型 ImportText（对象按路径查找），解析失败返回 false 且不修改数值叶子
+	bool SetValueFromString(void* Container, const FString& Value) const;
+
+	// 以字符串读取叶子：枚举为名称，数值与 PPS 格式一致，其余类型为 ExportText
+	bool GetValueAsString(const void* Container, FString& OutValue) const;
+
+	// 按类型写入叶子：数值（可跨数值类型转换，枚举写入底层值）、bool、FString、FName、FText、USTRUCT
+	template<typename ValueType>
+	bool SetValue(void* Container, const ValueType& Value) const;
+
+	// 按类型读取叶子，类型规则同 SetValue
+	template<typename ValueType>
+	bool GetValue(const void* Container, ValueType& OutValue) const;
+
+	// 数值叶子（含枚举底层值）
+	bool GetNumber(const void* Container, double& OutValue) const;
+	bool GetInteger(const void* Container, int64& OutValue) const;
+	bool SetNumber(void* Container, double Value) const;
+	bool SetInteger(void* Container, int64 Value) const;
+
+	// 编译路径，结果按 (UStruct, Path) 缓存（LRU，有条目上限），失败返回 nullptr
+	static TSharedPtr<const FReflectionPropertyPath> Compile(const UStruct* Struct, const FString& Path);
+
+	// 清空编译缓存，之前编译的路径全部失效（热重载 / 结构体重新编译后由模块调用）
+	static void ClearCache();
+
+	// 按变量名查找属性，同时匹配 GetName 与 GetAuthoredName（蓝图结构体的成员名带 GUID 后缀）
+	static FProperty* FindPropertyByAuthoredName(const UStruct* Struct, const FString& Name);
+
+private:
+	static TSharedPtr<FReflectionPropertyPath> CompileUncached(const UStruct* Struct, const FString& Path);
+};
+
+template<typename ValueType>
+bool FReflectionPropertyPath::SetValue(void* Container, const ValueType& Value) const
+{
+	if constexpr (std::is_same_v<ValueType, bool>)
+	{
+		void* Addr = LeafKind == ELeafKind::Bool ? ResolveLeaf(Container) : nullptr;
+		if (!Addr)
+			return false;
+		static_cast<const FBoolProperty*>(LeafProperty)->SetPropertyValue(Addr, Value);
+		return true;
+	}
+	else if constexpr (std::is_floating_point_v<ValueType>)
+	{
+		return SetNumber(Container, static_cast<double>(Value));
+	}
+	else if constexpr (std::is_arithmetic_v<ValueType> || std::is_enum_v<ValueType>)
+	{
+		return SetInteger(Container, static_cast<int64>(Value));
+	}
+	else if constexpr (std::is_same_v<ValueType, FString> || std::is_convertible_v<const ValueType&, const TCHAR*>)
+	{
+		return SetValueFromString(Container, FString(Value));
+	}
+	else if constexpr (std::is_same_v<ValueType, FName>)
+	{
+		void* Addr = LeafKind == ELeafKind::Name ? ResolveLeaf(Container) : nullptr;
+		if (!Addr)
+			return false;
+		*static_cast<FName*>(Addr) = Value;
+		return true;
+	}
+	else if constexpr (std::is_same_v<ValueType, FText>)
+	{
+		void* Addr = LeafKind == ELeafKind::Text ? ResolveLeaf(Container) : nullptr;
+		if (!Addr)
+			return false;
+		*static_cast<FText*>(Addr) = Value;
+		return true;
+	}
+	else
+	{
+		// 其余类型按 USTRUCT 处理
+		const FStructProperty* StructProperty = CastField<FStructProperty>(LeafProperty);
+		if (!StructProperty || StructProperty->Struct != ValueType::StaticStruct())
+			return false;
+		void* Addr = ResolveLeaf(Container);
+		if (!Addr)
+			return false;
+		StructProperty->CopySingleValue(Addr, &Value);
+		return true;
+	}
+}
+
+template<typename ValueType>
+bool FReflectionPropertyPath::GetValue(const void* Container, ValueType& OutValue) const
+{
+	if constexpr (std::is_same_v<ValueType, bool>)
+	{
+		const void* Addr = LeafKind == ELeafKind::Bool ? ResolveLeaf(Container) : nullptr;
+		if (!Addr)
+			return false;
+		OutValue = static_cast<const FBoolProperty*>(LeafProperty)->GetPropertyValue(Addr);
+		return true;
+	}
+	else if constexpr (std::is_floating_point_v<ValueType>)
+	{
+		double Number;
+		if (!GetNumber(Container, Number))
+			return false;
+		OutValue = static_cast<ValueType>(Number);
+		return true;
+	}
+	else if constexpr (std::is_arithmetic_v<ValueType> || std::is_enum_v<ValueType>)
+	{
+		int64 Integer;
+		if (!GetInteger(Container, Integer))
+			return false;
+		OutValue = static_cast<ValueType>(Integer);
+		return true;
+	}
+	else if constexpr (std::is_same_v<ValueType, FString>)
+	{
+		return GetValueAsString(Container, OutValue);
+	}
+	else if constexpr (std::is_same_v<ValueType, FName>)
+	{
+		const void* Addr = LeafKind == ELeafKind::Name ? ResolveLeaf(Container) : nullptr;
+		if (!Addr)
+			return false;
+		OutValue = *static_cast<const FName*>(Addr);
+		return true;
+	}
+	else if constexpr (std::is_same_v<ValueType, FText>)
+	{
+		const void* Addr = LeafKind == ELeafKind::Text ? ResolveLeaf(Container) : nullptr;
+		if (!Addr)
+			return false;
+		OutValue = *static_cast<const FText*>(Addr);
+		return true;
+	}
+	else
+	{
+		const FStructProperty* StructProperty = CastField<FStructProperty>(LeafProperty);
+		if (!StructProperty || StructProperty->Struct != ValueType::StaticStruct())
+			return false;
+		const void* Addr = ResolveLeaf(Container);
+		if (!Addr)
+			return false;
+		StructProperty->CopySingleValue(&OutValue, Addr);
+		return true;
+	}
+}
@@ -0,0 +1,108 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+
+class FReflectionStructLayout;
+
+/**
+ * 同一结构体连续快照的存储：每隔 KeyframeInterval 条存一个关键帧（全部字段），其余只存与上一条相比变化的字段
+ * 每帧可选用引擎内置压缩（NAME_Oodle / NAME_Zlib 等），读取任意一条时从最近的关键帧开始依次应用差量
+ * KeyframeInterval 越小读取越快、占用越大；顺序向后读取时复用上一次解码的结果，每条只应用一个差量
+ * 非线程安全，Add / Get 需在同一线程调用
+ */
+class REFLECTIONTOOL_API FReflectionSnapshotStore : public FGCObject
+{
+public:
+	/**
+	 * @param InStruct 快照的结构体类型
+	 * @param InKeyframeInterval 关键帧间隔，1 表示每条都是关键帧
+	 * @param InCompressionFormat 压缩格式，NAME_None 不压缩
+	 */
+	FReflectionSnapshotStore(const UStruct* InStruct, int32 InKeyframeInterval = 30, FName InCompressionFormat = NAME_None);
+	virtual ~FReflectionSnapshotStore() override;
+
+	FReflectionSnapshotStore(const FReflectionSnapshotStore&) = delete;
+	FReflectionSnapshotStore& operator=(const FReflectionSnapshotStore&) = delete;
+
+	// 追加一条快照，返回其下标
+	int32 Add(const void* Data);
+
+	template<typename StructType>
+	int32 Add(const StructType& Data)
+	{
+		check(StructType::StaticStruct() == Struct);
+		return Add(&Data);
+	}
+
+	/**
+	 * @brief 还原第 Index 条快照
+	 * @param OutData 需已初始化的结构体
+	 * @return 下标无效或数据损坏时返回 false
+	 */
+	bool Get(int32 Index, void* OutData);
+
+	template<typename StructType>
+	bool Get(int32 Index, StructType& OutData)
+	{
+		check(StructType::StaticStruct() == Struct);
+		return Get(Index, &OutData);
+	}
+
+	int32 Num() const { return Frames.Num(); }
+	bool IsKeyframe(int32 Index) const { return Frames.IsValidIndex(Index) && Frames[Index].bKeyframe; }
+
+	// 修改之后新增快照的关键帧间隔
+	void SetKeyframeInterval(int32 InKeyframeInterval) { KeyframeInterval = FMath::Max(InKeyframeInterval, 1); }
+	int32 GetKeyframeInterval() const { return KeyframeInterval; }
+
+	// 存储占用（压缩后）与压缩前的字节数
+	int64 GetStoredSize() const;
+	int64 GetRawSize() const;
+
+	// 清空所有快照
+	void Reset();
+
+	const UStruct* GetStruct() const { return Struct; }
+
+	//~ Begin FGCObject Interface
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override;
+	//~ End FGCObject Interface
+
+private:
+	// 顶层属性的一个元素（静态数组拆成多个）
+	struct FField
+	{
+		const FProperty* Property = nullptr;
+		int32 Offset = 0;
+	};
+
+	struct FFrame
+	{
+		TArray<uint8> Bytes;
+		int32 RawSize = 0;
+		bool bKeyframe = false;
+		bool bCompressed = false;
+	};
+
+	// 写入与 Base 不同的字段，Base 为空时写入全部字段
+	void EncodeFrame(const uint8* Data, const uint8* Base, FFrame& OutFrame) const;
+	bool ApplyFrame(const FFrame& Frame, uint8* Data) const;
+
+	TObjectPtr<const UStruct> Struct;
+	TSharedPtr<const FReflectionStructLayout> Layout;
+	int32 KeyframeInterval = 30;
+	FName CompressionFormat;
+	TArray<FField> Fields;
+	TArray<FFrame> Frames;
+	// 关键帧下标，升序
+	TArray<int32> Keyframes;
+	// 最近一次 Add 的数据，用于计算差量
+	uint8* LastData = nullptr;
+	// 最近一次 Get 还原出的数据
+	uint8* CachedData = nullptr;
+	int32 CachedIndex = INDEX_NONE;
+};
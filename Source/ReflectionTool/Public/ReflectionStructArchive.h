@@ -0,0 +1,102 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace ReflectionStructArchive
+{
+	struct FEncoder;
+	struct FDecodePlanSet;
+}
+
+/**
+ * 带版本容错的结构体二进制存档
+ * 文件头只写一次精简的结构描述（字段名、类型、在定长块中的偏移），之后每条记录为：
+ * 定长块（所有数值 / bool / 枚举字段按描述中的偏移紧密排列，整段读写）+ 按字段顺序编码的字符串、容器、嵌套结构体
+ * 读取时根据文件中的描述与当前 UStruct 生成重映射计划（按描述哈希缓存）：已删除的字段跳过，新增的字段保持默认值，
+ * 同名字段的数值类型变化、枚举（按名称）都会转换
+ * 容器长度按剩余字节数与元素的最小编码长度检查，不知道总长度的流中容器随读取增长，损坏的长度不会导致一次性大块分配
+ */
+class REFLECTIONTOOL_API FReflectionStructArchiveWriter
+{
+public:
+	// 构造时写入文件头与结构描述
+	FReflectionStructArchiveWriter(FArchive& InArchive, const UStruct* InStruct);
+	~FReflectionStructArchiveWriter();
+
+	// 写入一条记录
+	void Write(const void* Record);
+
+	int32 GetNumRecords() const { return NumRecords; }
+
+private:
+	FArchive& Archive;
+	TUniquePtr<ReflectionStructArchive::FEncoder> Encoder;
+	int32 NumRecords = 0;
+};
+
+class REFLECTIONTOOL_API FReflectionStructArchiveReader
+{
+public:
+	// 构造时读取文件头并取得 (描述哈希, InStruct) 对应的重映射计划
+	FReflectionStructArchiveReader(FArchive& InArchive, const UStruct* InStruct);
+	~FReflectionStructArchiveReader();
+
+	// 文件头有效且计划已生成
+	bool IsValid() const { return PlanSet.IsValid(); }
+
+	/**
+	 * @brief 读取下一条记录
+	 * @param Record 需已初始化（新增字段保持其中的值）
+	 * @return 已到文件末尾或数据损坏时返回 false；不知道总长度的流（TotalSize 为 -1）读到末尾时 Archive 处于错误状态
+	 */
+	bool Read(void* Record);
+
+	uint64 GetSchemaHash() const { return SchemaHash; }
+
+	// 清空重映射计划缓存（热重载 / 结构体重新编译后调用）
+	static void ClearCache();
+
+private:
+	FArchive& Archive;
+	TSharedPtr<const ReflectionStructArchive::FDecodePlanSet> PlanSet;
+	uint64 SchemaHash = 0;
+};
+
+// 常用的整表存取
+struct FReflectionStructArchive
+{
+	template<typename StructType>
+	static void SaveArray(const TArray<StructType>& Records, TArray<uint8>& OutBytes)
+	{
+		OutBytes.Reset();
+		FMemoryWriter Writer(OutBytes);
+		FReflectionStructArchiveWriter ArchiveWriter(Writer, StructType::StaticStruct());
+		for (const StructType& Record : Records)
+		{
+			ArchiveWriter.Write(&Record);
+		}
+	}
+
+	template<typename StructType>
+	static bool LoadArray(const TArray<uint8>& Bytes, TArray<StructType>& OutRecords)
+	{
+		OutRecords.Reset();
+		FMemoryReader Reader(Bytes);
+		FReflectionStructArchiveReader ArchiveReader(Reader, StructType::StaticStruct());
+		if (!ArchiveReader.IsValid())
+			return false;
+		while (!Reader.AtEnd())
+		{
+			if (!ArchiveReader.Read(&OutRecords.AddDefaulted_GetRef()))
+			{
+				OutRecords.Pop();
+				return false;
+			}
+		}
+		return true;
+	}
+};
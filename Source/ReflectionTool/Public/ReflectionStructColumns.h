@@ -0,0 +1,98 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReflectionPropertyPath.h"
+
+// 列缓冲的元素类型
+enum class EReflectionColumnType : uint8
+{
+	Bool,
+	Int32,
+	Int64,
+	Float,
+	Double,
+	Name,
+	String,
+};
+
+template<typename ValueType>
+struct TReflectionColumnType;
+
+template<> struct TReflectionColumnType<bool> { static constexpr EReflectionColumnType Value = EReflectionColumnType::Bool; };
+template<> struct TReflectionColumnType<int32> { static constexpr EReflectionColumnType Value = EReflectionColumnType::Int32; };
+template<> struct TReflectionColumnType<int64> { static constexpr EReflectionColumnType Value = EReflectionColumnType::Int64; };
+template<> struct TReflectionColumnType<float> { static constexpr EReflectionColumnType Value = EReflectionColumnType::Float; };
+template<> struct TReflectionColumnType<double> { static constexpr EReflectionColumnType Value = EReflectionColumnType::Double; };
+template<> struct TReflectionColumnType<FName> { static constexpr EReflectionColumnType Value = EReflectionColumnType::Name; };
+template<> struct TReflectionColumnType<FString> { static constexpr EReflectionColumnType Value = EReflectionColumnType::String; };
+
+/**
+ * 结构体数组的列式读写：把每个元素上同一路径的叶子复制到连续的类型化缓冲（SoA），或反向写回
+ * 路径只经过成员 / 静态数组时按固定偏移跨步复制，否则逐个元素解析路径
+ * 数值列可跨数值类型转换（枚举为底层值，浮点写入整数时四舍五入），字符串列可读取任意叶子（同 GetValueAsString）
+ */
+class REFLECTIONTOOL_API FReflectionStructColumns
+{
+public:
+	/**
+	 * @brief 提取一列，路径中的数组越界 / Map 中没有 Key 的元素为默认值
+	 * @param ElementStruct 元素类型
+	 * @param Elements 第 0 个元素地址
+	 * @param Num 元素个数
+	 * @param PropertyPath 例如 "Stats.Health"
+	 * @param OutValues 长度为 Num
+	 * @return 路径无效或叶子类型与 ValueType 不兼容时返回 false
+	 */
+	template<typename ValueType>
+	static bool Extract(const UScriptStruct* ElementStruct, const void* Elements, int32 Num,
+		const FString& PropertyPath, TArray<ValueType>& OutValues)
+	{
+		OutValues.Reset();
+		const TSharedPtr<const FReflectionPropertyPath> Path = FReflectionPropertyPath::Compile(ElementStruct, PropertyPath);
+		if (!Path.IsValid() || Num < 0)
+			return false;
+		OutValues.SetNum(Num);
+		if (!ExtractRaw(ElementStruct, Elements, Num, *Path, TReflectionColumnType<ValueType>::Value, OutValues.GetData()))
+		{
+			OutValues.Reset();
+			return false;
+		}
+		return true;
+	}
+
+	// 提取多列，OutColumns[i] 对应 PropertyPaths[i]，任意一列失败返回 false
+	template<typename ValueType>
+	static bool ExtractColumns(const UScriptStruct* ElementStruct, const void* Elements, int32 Num,
+		TArrayView<const FString> PropertyPaths, TArray<TArray<ValueType>>& OutColumns)
+	{
+		OutColumns.SetNum(PropertyPaths.Num());
+		bool bSuccess = true;
+		for (int32 Index = 0; Index < PropertyPaths.Num(); ++Index)
+		{
+			bSuccess &= Extract(ElementStruct, Elements, Num, PropertyPaths[Index], OutColumns[Index]);
+		}
+		return bSuccess;
+	}
+
+	/**
+	 * @brief 把一列写回每个元素，路径中的数组越界 / Map 中没有 Key 的元素跳过
+	 * @param Values 长度必须为 Num
+	 */
+	template<typename ValueType>
+	static bool Scatter(const UScriptStruct* ElementStruct, void* Elements, int32 Num,
+		const FString& PropertyPath, TArrayView<const ValueType> Values)
+	{
+		const TSharedPtr<const FReflectionPropertyPath> Path = FReflectionPropertyPath::Compile(ElementStruct, PropertyPath);
+		if (!Path.IsValid() || Values.Num() != Num)
+			return false;
+		return ScatterRaw(ElementStruct, Elements, Num, *Path, TReflectionColumnType<ValueType>::Value, Values.GetData());
+	}
+
+	static bool ExtractRaw(const UScriptStruct* ElementStruct, const void* Elements, int32 Num,
+		const FReflectionPropertyPath& Path, EReflectionColumnType Type, void* OutValues);
+
+	static bool ScatterRaw(const UScriptStruct* ElementStruct, void* Elements, int32 Num,
+		const FReflectionPropertyPath& Path, EReflectionColumnType Type, const void* Values);
+};
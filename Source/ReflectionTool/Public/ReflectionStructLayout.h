@@ -0,0 +1,101 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 按 UStruct 缓存的内存布局：把属性链展开为按偏移排列的操作序列
+ * 嵌套结构体与静态数组被展平，相邻且中间没有填充的 POD 属性合并为一段连续字节，整段 memcpy / memcmp / 哈希
+ * 哈希、拷贝、比较各用一份序列：拷贝只看字节；哈希与比较单独处理 float（-0 / NaN）与 FName（大小写），与 FProperty::Identical 一致
+ */
+class REFLECTIONTOOL_API FReflectionStructLayout
+{
+public:
+	enum class EOpKind : uint8
+	{
+		// 连续的 POD 字节，可整段处理
+		PodRun,
+		// 位域 bool
+		BitfieldBool,
+		// 连续的 float / double，Size 为字节数（哈希 / 比较）
+		Float,
+		Double,
+		String,
+		Name,
+		Text,
+		Array,
+		Set,
+		Map,
+		// 自定义拷贝 / 比较的结构体，整体交给 FStructProperty 处理（仅拷贝 / 比较）
+		Struct,
+		// 对象、委托、FieldPath 等
+		Other,
+	};
+
+	struct FOp
+	{
+		EOpKind Kind = EOpKind::PodRun;
+		int32 Offset = 0;
+		// PodRun / Float / Double 的字节数，其余为单个元素大小
+		int32 Size = 0;
+		const FProperty* Property = nullptr;
+		// Array / Set 的元素布局、Map 的 Key 布局（仅哈希），由所属布局的 Dependencies 持有
+		// 结构体通过容器引用自身或外层结构体时指向外层布局，不持有，避免引用环
+		const FReflectionStructLayout* Inner = nullptr;
+		// Map 的 Value 布局（仅哈希）
+		const FReflectionStructLayout* Value = nullptr;
+	};
+
+	// 获取 Struct 的布局，按 UStruct 缓存
+	static TSharedPtr<const FReflectionStructLayout> Get(const UStruct* Struct);
+
+	// 清空布局缓存（热重载 / 结构体重新编译后调用）
+	static void ClearCache();
+
+	/**
+	 * @brief 内容哈希，与内存地址、填充字节、Set / Map 的存放顺序无关
+	 * float / double 的 -0 与 0 相同，所有 NaN 相同；FName 不区分大小写；对象按路径
+	 * @param Data 结构体地址
+	 * @param Seed 
+	 * @return 64 位哈希，同一份数据在不同进程中结果相同
+	 */
+	uint64 Hash(const void* Data, uint64 Seed = 0) const;
+
+	// 把 Src 的内容拷贝到 Dst（两者都已初始化），POD 段整段 memcpy
+	void Copy(void* Dst, const void* Src) const;
+
+	// 内容是否相同，与 FProperty::Identical 一致：float 按值比较（-0 与 0 相同，NaN 与任何值都不同），FName 不区分大小写，其余 POD 段按字节比较
+	bool Identical(const void* A, const void* B) const;
+
+	const TArray<FOp>& GetHashOps() const { return HashOps; }
+	const TArray<FOp>& GetCopyOps() const { return CopyOps; }
+	const TArray<FOp>& GetCompareOps() const { return CompareOps; }
+
+	// 拷贝 / 比较序列是否只有一段覆盖整个结构体的 POD
+	bool IsPlainOldData() const { return bPlainOldData; }
+
+private:
+	enum class EPurpose : uint8
+	{
+		Hash,
+		Copy,
+		Compare,
+	};
+
+	// 单个属性（容器元素）的布局，加入 Dependencies；非结构体元素的布局不缓存
+	const FReflectionStructLayout* BuildForProperty(const FProperty* Property);
+
+	void AddStruct(EPurpose Purpose, const UStruct* Struct, int32 BaseOffset);
+	void AddProperty(EPurpose Purpose, const FProperty* Property, int32 Offset);
+	static void AddRun(TArray<FOp>& Ops, EOpKind Kind, int32 Offset, int32 Size);
+
+	TArray<FOp> HashOps;
+	TArray<FOp> CopyOps;
+	TArray<FOp> CompareOps;
+	// Op.Inner / Op.Value 指向的布局
+	TArray<TSharedPtr<const FReflectionStructLayout>> Dependencies;
+	// 结构体自带拷贝 / 比较，整体调用 UScriptStruct
+	const UScriptStruct* NativeStruct = nullptr;
+	bool bPlainOldData = false;
+};
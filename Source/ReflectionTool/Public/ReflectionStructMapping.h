@@ -0,0 +1,101 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FReflectionStructLayout;
+
+/**
+ * 两个按变量名兼容的结构体之间的字段映射，例如存档 V1 -> V2
+ * 按 (Src, Dst) 缓存：同名同类型字段直接拷贝（相邻的 POD 整段 memcpy），数值跨类型转换，枚举按名称转换，
+ * 嵌套结构体与容器元素递归使用子映射，全程不经过字符串
+ */
+class REFLECTIONTOOL_API FReflectionStructMapping
+{
+public:
+	// 获取 Src -> Dst 的映射，按 (Src, Dst) 缓存
+	static TSharedPtr<const FReflectionStructMapping> Get(const UStruct* SrcStruct, const UStruct* DstStruct);
+
+	// 清空映射缓存（热重载 / 结构体重新编译后调用）
+	static void ClearCache();
+
+	/**
+	 * @brief 按映射把 Src 的字段写入 Dst
+	 * Dst 需已初始化，Dst 中没有同名字段或类型不兼容的字段保持原值；枚举值在 Dst 中没有同名项时输出警告并保持原值，
+	 * 作为 Set 元素 / Map Key 时丢弃该元素；转换后相同的 Set 元素 / Map Key 只保留第一个
+	 */
+	void Copy(const void* Src, void* Dst) const;
+
+	// 能够映射的字段数
+	int32 GetNumMappedFields() const { return NumMappedFields; }
+
+private:
+	enum class EConvertKind : uint8
+	{
+		// 同类型 POD
+		Memcpy,
+		// 同类型非 POD，CopySingleValue
+		CopyValue,
+		Bool,
+		// 数值跨类型（含枚举与整数之间）
+		Numeric,
+		// 不同枚举之间按名称
+		Enum,
+		Struct,
+		Array,
+		Set,
+		Map,
+		NameToString,
+		StringToName,
+	};
+
+	// 单个值（字段的一个元素 / 容器元素）的转换方式
+	struct FConverter
+	{
+		EConvertKind Kind = EConvertKind::Memcpy;
+		int32 Size = 0;
+		const FProperty* SrcProperty = nullptr;
+		const FProperty* DstProperty = nullptr;
+		// Numeric / Enum 的数值属性（枚举为底层属性）
+		const FNumericProperty* SrcNumeric = nullptr;
+		const FNumericProperty* DstNumeric = nullptr;
+		// Enum：源值 -> 目标值，源中没有对应名称的值不写入
+		TMap<int64, int64> EnumValues;
+		const UEnum* SrcEnum = nullptr;
+		const UEnum* DstEnum = nullptr;
+		// 结构体通过容器引用自身或外层结构体时指向构建中的映射，此时 StructMappingOwner 为空，避免引用环
+		const FReflectionStructMapping* StructMapping = nullptr;
+		TSharedPtr<const FReflectionStructMapping> StructMappingOwner;
+		// Array / Set 的元素、Map 的 Key
+		TSharedPtr<const FConverter> Inner;
+		// Map 的 Value
+		TSharedPtr<const FConverter> Value;
+
+		// 返回 false 表示值无法转换（枚举没有同名项），Dst 保持原值
+		bool Convert(const void* Src, void* Dst) const;
+		// 不同的源值转换后一定不同，作为 Set 元素 / Map Key 时无需去重
+		bool IsInjective() const;
+	};
+
+	struct FFieldOp
+	{
+		int32 SrcOffset = 0;
+		int32 DstOffset = 0;
+		// 为空时整段拷贝 Size 字节
+		TSharedPtr<const FConverter> Converter;
+		int32 Size = 0;
+		// 静态数组的元素个数与步长
+		int32 Count = 1;
+		int32 SrcStride = 0;
+		int32 DstStride = 0;
+	};
+
+	static TSharedPtr<const FConverter> MakeConverter(const FProperty* SrcProperty, const FProperty* DstProperty);
+	void Build(const UStruct* SrcStruct, const UStruct* DstStruct);
+
+	TArray<FFieldOp> Ops;
+	// Src 与 Dst 为同一类型时直接按布局拷贝
+	TSharedPtr<const FReflectionStructLayout> SameLayout;
+	int32 NumMappedFields = 0;
+};
@@ -0,0 +1,116 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReflectionPropertyPath.h"
+
+/**
+ * 编译后的结构体过滤条件，例如 "Count > 5 && Type == Weapon"、"!(Stats.Damage <= 1.5) || Name == \"Sword\""
+ * 编译时把字段路径解析为偏移 / 访问链，把字面量转换为字段的类型（枚举按名称），求值时只做类型化比较
+ * 支持 == != < <= > >=、&& || !、括号，单独的 bool 字段等价于 "Field == true"
+ */
+class REFLECTIONTOOL_API FReflectionStructQuery
+{
+public:
+	// 编译条件，结果按 (UStruct, Expression) 缓存，失败返回 nullptr 并输出原因
+	static TSharedPtr<const FReflectionStructQuery> Compile(const UStruct* ElementStruct, const FString& Expression);
+
+	// 清空编译缓存
+	static void ClearCache();
+
+	// 单个元素是否满足条件
+	bool Matches(const void* Element) const;
+
+	/**
+	 * @brief 在连续存放的元素上求值，元素较多时并行，结果按下标升序
+	 * @param Elements 第 0 个元素地址
+	 * @param Num 元素个数
+	 * @param Stride 相邻元素间隔（字节）
+	 */
+	void Filter(const void* Elements, int32 Num, int32 Stride, TArray<int32>& OutIndices) const;
+
+	const UStruct* GetElementStruct() const { return ElementStruct.Get(); }
+	const FString& GetExpression() const { return Expression; }
+
+	// 超过该元素个数时并行求值
+	static constexpr int32 ParallelThreshold = 16 * 1024;
+
+private:
+	friend struct FReflectionStructQueryParser;
+
+	enum class ECompareOp : uint8
+	{
+		Equal,
+		NotEqual,
+		Less,
+		LessEqual,
+		Greater,
+		GreaterEqual,
+	};
+
+	// 叶子的读取方式
+	enum class ELoad : uint8
+	{
+		Int8,
+		Int16,
+		Int32,
+		Int64,
+		UInt8,
+		UInt16,
+		UInt32,
+		UInt64,
+		Float,
+		Double,
+		Bool,
+		String,
+		Name,
+	};
+
+	struct FPredicate
+	{
+		TSharedPtr<const FReflectionPropertyPath> Path;
+		// 路径只经过成员 / 静态数组时为固定偏移，否则为 INDEX_NONE，需要 Resolve
+		int32 Offset = INDEX_NONE;
+		ELoad Load = ELoad::Int32;
+		ECompareOp Op = ECompareOp::Equal;
+		const FBoolProperty* BoolProperty = nullptr;
+
+		int64 IntValue = 0;
+		double FloatValue = 0.0;
+		bool bBoolValue = false;
+		FString StringValue;
+		FName NameValue;
+		// 整数字段与非整数字面量比较时按 double 比较
+		bool bCompareAsDouble = false;
+
+		bool Evaluate(const uint8* Element) const;
+
+		template<typename NumberType>
+		bool CompareNumber(NumberType Value) const;
+	};
+
+	enum class ENodeKind : uint8
+	{
+		And,
+		Or,
+		Not,
+		Predicate,
+	};
+
+	struct FNode
+	{
+		ENodeKind Kind = ENodeKind::Predicate;
+		// And / Or 的两个子节点，Not 只用 Left；Predicate 时 Left 为 Predicates 下标
+		int32 Left = INDEX_NONE;
+		int32 Right = INDEX_NONE;
+	};
+
+	bool EvaluateNode(int32 NodeIndex, const uint8* Element) const;
+
+	TWeakObjectPtr<const UStruct> ElementStruct;
+	FString Expression;
+	TArray<FPredicate> Predicates;
+	TArray<FNode> Nodes;
+	int32 RootNode = INDEX_NONE;
+};
@@ -0,0 +1,83 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "UObject/GCObject.h"
+#include "ReflectionToolLib.h"
+
+/**
+ * 结构体 / 对象属性的不可变快照，用于把耗时的转换移到工作线程
+ * 第一步在拥有数据的线程（通常是游戏线程）上 Capture：按布局整段拷贝，代价只有一次内存拷贝
+ * 第二步在任意线程上转换为 PPS / JSON / 二进制：只读快照本身，引用到的对象由快照持有，转换期间阻止 GC
+ */
+class REFLECTIONTOOL_API FReflectionStructSnapshot : public FGCObject, public TSharedFromThis<FReflectionStructSnapshot>
+{
+public:
+	/**
+	 * @brief 拷贝一份结构体
+	 * @param Struct 结构体类型
+	 * @param Data 结构体地址
+	 */
+	static TSharedRef<FReflectionStructSnapshot> Capture(const UStruct* Struct, const void* Data);
+
+	template<typename StructType>
+	static TSharedRef<FReflectionStructSnapshot> Capture(const StructType& Struct)
+	{
+		return Capture(StructType::StaticStruct(), &Struct);
+	}
+
+	// 拷贝对象上由 UPROPERTY 声明的属性，转换结果与直接转换对象相同
+	static TSharedRef<FReflectionStructSnapshot> CaptureObject(const UObject* Object);
+
+	/**
+	 * @brief 创建未拷贝任何属性的快照（属性为默认值），之后用 CaptureProperty 逐个拷贝，可把拷贝分摊到多帧
+	 * 拷贝完成前快照仍会变化，不应转换或交给其他线程
+	 * @param Struct 结构体类型，对象为其 UClass
+	 */
+	static TSharedRef<FReflectionStructSnapshot> CreateEmpty(const UStruct* Struct);
+
+	// 拷贝 Struct 的一个属性，Container 为源结构体 / 对象的地址
+	void CaptureProperty(const FProperty* Property, const void* Container);
+
+	/**
+	 * @brief 拷贝 TArray / TSet / TMap 属性的一段元素，可把大容器的拷贝分摊到多帧；其他属性整体拷贝
+	 * StartIndex 为 0 时先清空快照中的容器（数组按源数组等长分配），Set / Map 的下标为稀疏下标
+	 * 各段之间源容器被修改时结果可能混合多帧的数据，调用方应检查长度并在变化时改用 CaptureProperty
+	 * @param StartIndex 源容器中的起始下标，首段为 0，之后为上一段的返回值
+	 * @param Count 本段最多拷贝的元素数
+	 * @return 下一段的起始下标，已拷贝完时返回 INDEX_NONE
+	 */
+	int32 CaptureContainerElements(const FProperty* Property, const void* Container, int32 StartIndex, int32 Count);
+
+	virtual ~FReflectionStructSnapshot() override;
+
+	// 转换为 PPS，不展开对象引用（对象只输出路径）
+	void ToPPS(FPropertyParserStruct& OutPropertyParserStruct, const FPPSConvertOptions& Options = FPPSConvertOptions()) const;
+
+	// 转换为 JSON 字符串
+	bool ToJson(FString& OutJson) const;
+
+	// 转换为二进制（按属性顺序，FName 与对象按字符串 / 路径写入）
+	void ToBinary(TArray<uint8>& OutBytes) const;
+
+	// 在线程池中转换，快照在转换完成前保持有效
+	TFuture<FPropertyParserStruct> ToPPSAsync(const FPPSConvertOptions& Options = FPPSConvertOptions()) const;
+	TFuture<FString> ToJsonAsync() const;
+	TFuture<TArray<uint8>> ToBinaryAsync() const;
+
+	const UStruct* GetStruct() const { return Struct; }
+	const void* GetData() const { return Data; }
+
+	//~ Begin FGCObject Interface
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override;
+	//~ End FGCObject Interface
+
+private:
+	FReflectionStructSnapshot(const UStruct* InStruct);
+
+	TObjectPtr<const UStruct> Struct;
+	uint8* Data = nullptr;
+};
@@ -5,11 +5,46 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 
+struct FStreamableManager;
+#if WITH_EDITOR
+class FReflectionToolStructChangeListener;
+#endif
+
 class FReflectionToolModule : public IModuleInterface
 {
 public:
+	FReflectionToolModule();
+	virtual ~FReflectionToolModule() override;
 
 	/** IModuleInterface implementation */
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
+
+	static FReflectionToolModule& Get()
+	{
+		return FModuleManager::LoadModuleChecked<FReflectionToolModule>("ReflectionTool");
+	}
+
+	// 异步加载 PPS 中对象引用时使用
+	FStreamableManager& GetStreamableManager() const { return *StreamableManager; }
+
+	// 清空所有按 UStruct 缓存的编译结果（属性路径、布局、映射、查询、JSON 导入、归档）与对象图缓存，之后广播 OnReflectionDataChanged
+	static void NotifyReflectionDataChanged();
+
+	// 用户结构体重新编译前广播，旧的 FProperty 仍然有效，按旧属性分配的数据需在此释放
+	static FSimpleMulticastDelegate& OnReflectionDataChanging();
+	// 热重载 / 重新实例化 / 用户结构体重新编译后广播，缓存已清空，持有编译结果的对象需重新编译
+	static FSimpleMulticastDelegate& OnReflectionDataChanged();
+
+private:
+	TUniquePtr<FStreamableManager> StreamableManager;
+	FDelegateHandle ReloadCompleteHandle;
+	FDelegateHandle ObjectsReinstancedHandle;
+	FDelegateHandle PackageReloadedHandle;
+#if WITH_EDITOR
+	FDelegateHandle ObjectPropertyChangedHandle;
+#endif
+#if WITH_EDITOR
+	TUniquePtr<FReflectionToolStructChangeListener> StructChangeListener;
+#endif
 };
@@ -6,11 +6,18 @@
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "Logging/LogMacros.h"
+#include "ReflectionPropertyPath.h"
+#include "ReflectionStructColumns.h"
 #include "ReflectionToolLib.generated.h"
 
-DECLARE_LOG_CATEGORY_EXTERN(ReflectionTool, Log, All);
+REFLECTIONTOOL_API DECLARE_LOG_CATEGORY_EXTERN(ReflectionTool, Log, All);
 
 class FJsonObject;
+struct FStreamableHandle;
+struct FSoftObjectPath;
+
+// 异步应用 PPS 完成回调
+DECLARE_DYNAMIC_DELEGATE_OneParam(FOnPPSAppliedDynamic, bool, bSuccess);
 
 USTRUCT(BlueprintType)
 struct FPropertyParserStruct
@@ -33,8 +40,160 @@ struct FPropertyParserStruct
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "ReflectionTool")
 	bool bHaveChild = false;
 
+	// 转换时超出节点 / 内存预算，Children 不完整
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "ReflectionTool")
+	bool bTruncated = false;
+
 	// 存储 TArray 中元素、Struct 中成员等
 	TArray<FPropertyParserStruct> Children;
+
+	// Name / TypeName 的驻留形式，原生转换时与字符串一起写入，原生代码按 FName 查找与比较（整数比较）
+	// 蓝图中构造的节点为 None，读取时回退到字符串；蓝图中修改 Name / TypeName 不会同步到这里
+	FName NameId;
+	FName TypeNameId;
+
+	// 同时写入驻留形式与字符串
+	void SetName(FName InName)
+	{
+		NameId = InName;
+		InName.ToString(Name);
+	}
+
+	void SetTypeName(FName InTypeName)
+	{
+		TypeNameId = InTypeName;
+		InTypeName.ToString(TypeName);
+	}
+
+	// 没有驻留形式时由字符串生成
+	FName GetNameId() const { return NameId.IsNone() && !Name.IsEmpty() ? FName(*Name) : NameId; }
+	FName GetTypeNameId() const { return TypeNameId.IsNone() && !TypeName.IsEmpty() ? FName(*TypeName) : TypeNameId; }
+};
+
+// PPS 转换选项
+USTRUCT(BlueprintType)
+struct FPPSConvertOptions
+{
+	GENERATED_BODY()
+
+	// 是否展开 UObject 引用（对象图模式），默认只输出对象路径
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "ReflectionTool|ConvertOptions")
+	bool bExpandObjects = false;
+
+	// 对象图最大深度，根对象深度为 0
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "ReflectionTool|ConvertOptions")
+	int32 MaxObjectDepth = 3;
+
+	// 最多生成的 PPS 节点数，<= 0 表示不限制
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "ReflectionTool|ConvertOptions")
+	int32 MaxNodes = 0;
+
+	// PPS 最多占用的内存（字节），<= 0 表示不限制；超出后不再展开，节点标记 bTruncated
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "ReflectionTool|ConvertOptions")
+	int64 MaxBytes = 0;
+
+	// 缓存共享对象（资源、CDO、Archetype）的展开结果，重复导出时不再遍历
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "ReflectionTool|ConvertOptions")
+	bool bCacheSharedObjects = true;
+};
+
+// 一次 PPS 转换过程中的状态，沿各个 XXXToPropertyStruct 向下传递，为空时走默认行为
+struct REFLECTIONTOOL_API FPPSConvertContext
+{
+	FPPSConvertContext() = default;
+	explicit FPPSConvertContext(const FPPSConvertOptions& InOptions)
+		: Options(InOptions)
+	{
+	}
+
+	FPPSConvertOptions Options;
+
+	// 已生成的节点数
+	int32 NodeCount = 0;
+	// 已生成节点的内存估算（节点本身 + 字符串）
+	int64 ByteCount = 0;
+	// 已访问的属性数，与 NodeCount / ByteCount 一起在转换入口返回时发布到统计
+	int32 PropertiesVisited = 0;
+	// 是否有节点因为预算被截断
+	bool bTruncated = false;
+
+	// 对象图：正在展开的对象深度
+	int32 CurrentObjectDepth = 0;
+	// 对象图：已登记的对象，每个对象只展开一次，之后只通过路径引用
+	TSet<const UObject*> VisitedObjects;
+	// 对象图：待展开的对象与其深度（广度优先）
+	TArray<TPair<const UObject*, int32>> PendingObjects;
+	// 对象图：记录当前对象引用到的所有对象，用于缓存子图
+	TArray<const UObject*>* CurrentReferences = nullptr;
+
+	bool IsBudgetExceeded() const
+	{
+		return (Options.MaxNodes > 0 && NodeCount >= Options.MaxNodes) || (Options.MaxBytes > 0 && ByteCount >= Options.MaxBytes);
+	}
+
+	// 再生成 ExtraNodes 个节点、ExtraBytes 字节后是否超出预算
+	bool WouldExceedBudget(int32 ExtraNodes, int64 ExtraBytes) const
+	{
+		return (Options.MaxNodes > 0 && NodeCount + ExtraNodes > Options.MaxNodes)
+			|| (Options.MaxBytes > 0 && ByteCount + ExtraBytes > Options.MaxBytes);
+	}
+
+	// 展开子节点前调用，超出预算时标记 Node 为截断并返回 true
+	bool TruncateIfOverBudget(FPropertyParserStruct& Node)
+	{
+		if (!IsBudgetExceeded())
+			return false;
+		Node.bTruncated = true;
+		bTruncated = true;
+		return true;
+	}
+
+	// 登记一个已生成的节点
+	void AddNode(const FPropertyParserStruct& Node);
+
+	// 遇到对象引用时调用，满足深度限制且未访问过时加入待展开队列
+	void AddObjectReference(const UObject* Object);
+};
+
+/**
+ * 预生成的结构体转换器，由 ReflectionToolCodegen Commandlet 为热点结构体生成
+ * 生成的 .cpp 在模块加载后按 UScriptStruct 注册，UStructToPropertyStruct / SetStructByMap 在运行时查找，未注册时走通用的 FProperty 遍历
+ * 选用哪条路径只取决于是否注册，与调用处包含了哪些头文件无关
+ */
+struct REFLECTIONTOOL_API FReflectionToolGeneratedConverters
+{
+	using FToPropertyStructFunc = void(*)(const void* Struct, FPropertyParserStruct& OutPropertyParserStruct);
+	using FSetFromMapFunc = void(*)(void* Struct, const TMap<FString, FString>& InMap);
+
+	struct FConverter
+	{
+		FToPropertyStructFunc ToPropertyStruct = nullptr;
+		FSetFromMapFunc SetFromMap = nullptr;
+	};
+
+	// 生成代码中的静态对象：对象系统就绪后注册，所在模块卸载时注销
+	class REFLECTIONTOOL_API FRegistration : public FNoncopyable
+	{
+	public:
+		FRegistration(UScriptStruct* (*InGetStruct)(), const FConverter& InConverter);
+		~FRegistration();
+
+	private:
+		const UScriptStruct* Struct = nullptr;
+	};
+
+	static void Register(const UScriptStruct* Struct, const FConverter& Converter);
+	static void Unregister(const UScriptStruct* Struct);
+	static bool Find(const UScriptStruct* Struct, FConverter& OutConverter);
+};
+
+// 编译好的属性路径，供蓝图保存后反复使用
+USTRUCT(BlueprintType)
+struct FReflectionCompiledPath
+{
+	GENERATED_BODY()
+
+	TSharedPtr<const FReflectionPropertyPath> Path;
 };
 
 USTRUCT(BlueprintType)
@@ -96,23 +255,62 @@ public:
 	static void UStructToMap(const InStructType& InStruct, TMap<FString, FString>& ResultMap);
 	
 	// ↑ 中调用，首个结构体拿不到 FProperty，特殊处理
-	static void GetStructProperty(const UStruct* StructClass, const void* Struct,  FPropertyParserStruct& OutPropertyParserStruct);
+	static void GetStructProperty(const UStruct* StructClass, const void* Struct,  FPropertyParserStruct& OutPropertyParserStruct,
+		FPPSConvertContext* Context = nullptr);
 
 	// Struct to PPS
-	static void StructToPropertyStruct(FStructProperty* StructProperty, const void* Addr, FPropertyParserStruct& OutPropertyParserStruct);
+	static void StructToPropertyStruct(FStructProperty* StructProperty, const void* Addr, FPropertyParserStruct& OutPropertyParserStruct,
+		FPPSConvertContext* Context = nullptr);
 
 	// TArray to PPS
-	static void TArrayToPropertyStruct(FArrayProperty* ArrayProperty, const void* Addr, FPropertyParserStruct& OutPropertyParserStruct);
+	static void TArrayToPropertyStruct(FArrayProperty* ArrayProperty, const void* Addr, FPropertyParserStruct& OutPropertyParserStruct,
+		FPPSConvertContext* Context = nullptr);
 
 	// TSet to PPS
-	static void TSetToPropertyStruct(FSetProperty* SetProperty, const void* Addr, FPropertyParserStruct& OutPropertyParserStruct);
+	static void TSetToPropertyStruct(FSetProperty* SetProperty, const void* Addr, FPropertyParserStruct& OutPropertyParserStruct,
+		FPPSConvertContext* Context = nullptr);
 
 	// TMap to PPS
-	static void TMapToPropertyStruct(FMapProperty* MapProperty, const void* Addr, FPropertyParserStruct& OutPropertyParserStruct);
+	static void TMapToPropertyStruct(FMapProperty* MapProperty, const void* Addr, FPropertyParserStruct& OutPropertyParserStruct,
+		FPPSConvertContext* Context = nullptr);
 
 	// Any Property to PPS
-	static void PropertyToPropertyStruct(FProperty* Property, const void* Addr, FPropertyParserStruct& OutPropertyParserStruct);
-	
+	static void PropertyToPropertyStruct(FProperty* Property, const void* Addr, FPropertyParserStruct& OutPropertyParserStruct,
+		FPPSConvertContext* Context = nullptr);
+
+	// PPS 中使用的变量名（蓝图结构体为去掉 GUID 后缀的名称）
+	static FString GetPropertyAuthoredName(const FProperty* Property);
+	static FName GetPropertyAuthoredFName(const FProperty* Property);
+
+	// PPS 中使用的类型名（CPPType 去掉模板参数），按属性缓存，每个线程一份，不加锁
+	static FString GetPropertyTypeName(const FProperty* Property);
+	static FName GetPropertyTypeFName(const FProperty* Property);
+
+	// 清空类型名缓存（热重载 / 结构体重新编译后由模块调用）
+	static void ClearPropertyTypeNameCache();
+
+#pragma endregion
+
+#pragma region 对象图
+
+	/**
+	 * @brief 导出对象图：从 Root 开始广度优先展开引用到的对象，每个对象只展开一次，之后通过对象路径引用
+	 * @param Root 根对象
+	 * @param Options 深度、节点数限制等
+	 * @param OutPropertyParserStruct 结果，Children 为对象表，每项 Name 为对象路径（即 ID）、TypeName 为类名
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ReflectionTool|ObjectGraph")
+	static void GetObjectGraph(UObject* Root, const FPPSConvertOptions& Options, FPropertyParserStruct& OutPropertyParserStruct);
+
+	// 清空共享对象的子图缓存；热重载、重新实例化、资源重新加载与编辑器中修改属性时自动清空
+	UFUNCTION(BlueprintCallable, Category = "ReflectionTool|ObjectGraph")
+	static void ClearObjectGraphCache();
+
+protected:
+	// 展开单个对象，共享对象优先读缓存
+	static void ExpandObjectGraphNode(const UObject* Object, FPPSConvertContext& Context, FPropertyParserStruct& OutPropertyParserStruct);
+public:
+
 #pragma endregion
 
 #pragma region 构造结构体
@@ -148,6 +346,36 @@ public:
 	// 复杂数据解析
 	static void ParserComplexPPSToProperty(FProperty* Property, void* Addr, FPropertyParserStruct& InPropertyParserStruct);
 #pragma endregion
+
+#pragma region 异步构造结构体
+
+	/**
+	 * @brief 异步应用 PPS：先收集 PPS 中所有对象路径，通过 StreamableManager 一次性批量加载，加载完成后再写入结构体
+	 * @param StructClass 结构体类型
+	 * 加载失败的对象写入为空并输出警告，不会在游戏线程上同步加载
+	 * @param StructClass 结构体类型
+	 * @param Struct 结构体地址，Owner 为空时调用者需保证在回调前有效
+	 * @param Owner 结构体所在的对象，回调时已被销毁则不写入
+	 * @param InPropertyParserStruct PPS 数据
+	 * @param OnComplete 写入完成后调用，所有对象都已加载时会同步调用；Owner 已销毁、结构体类型失效或有对象加载失败时 bSuccess 为 false
+	 * @return 加载句柄，无需加载时为空
+	 */
+	static TSharedPtr<FStreamableHandle> ParserPropertyParserStructAsync(const UStruct* StructClass, void* Struct, const UObject* Owner,
+		const FPropertyParserStruct& InPropertyParserStruct, TFunction<void(bool bSuccess)>&& OnComplete);
+
+	// 使用 PPS 异步设置对象的属性，对象在加载期间被销毁或有对象加载失败时回调 bSuccess 为 false
+	UFUNCTION(BlueprintCallable, Category = "ReflectionTool")
+	static void SetObjectByPPSAsync(UObject* TargetObject, const FPropertyParserStruct& InPropertyParserStruct,
+		FOnPPSAppliedDynamic OnApplied);
+
+	// 收集 PPS 中所有 (软)对象引用的路径
+	static void CollectObjectPathsFromPPS(const UStruct* StructClass, const FPropertyParserStruct& InPropertyParserStruct,
+		TArray<FSoftObjectPath>& OutPaths);
+
+	// ↑ 中调用，按属性类型递归
+	static void CollectObjectPathsFromProperty(const FProperty* Property, const FPropertyParserStruct& InPropertyParserStruct,
+		TArray<FSoftObjectPath>& OutPaths);
+#pragma endregion
 	
 #if WITH_EDITOR
 	/**
@@ -235,6 +463,142 @@ public:
 
 #pragma endregion
 
+#pragma region 按路径读写属性
+
+	/**
+	 * @brief 编译属性路径：成员偏移、数组下标、Map Key 查找与叶子类型处理组成的访问链，按 (Struct, Path) 缓存
+	 * @param Struct 起点结构体 / 类
+	 * @param PropertyPath 例如 "Inventory.Items[3].Stats.Damage"、"Attributes[Speed]"
+	 * @return 失败返回空指针
+	 */
+	static TSharedPtr<const FReflectionPropertyPath> CompilePropertyPath(const UStruct* Struct, const FString& PropertyPath);
+
+	/**
+	 * @brief 只写入路径指向的一个属性，不重建 PPS；每次只做 O(深度) 的偏移 / 容器查找
+	 * @param Struct 起点结构体 / 类
+	 * @param Container 起点地址
+	 * @param PropertyPath 
+	 * @param Value 数值、bool、FString（枚举按名称）、FName、FText、USTRUCT，见 FReflectionPropertyPath::SetValue
+	 */
+	template<typename ValueType>
+	static bool SetByPath(const UStruct* Struct, void* Container, const FString& PropertyPath, const ValueType& Value);
+
+	// 读取路径指向的一个属性，类型规则同 SetByPath
+	template<typename ValueType>
+	static bool GetByPath(const UStruct* Struct, const void* Container, const FString& PropertyPath, ValueType& OutValue);
+
+	/**
+	 * @brief 编译对象属性路径，结果可保存后反复使用
+	 * @param Class 
+	 * @param PropertyPath 
+	 * @param OutPath 
+	 * @return 路径无效时返回 false
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ReflectionTool|PropertyPath")
+	static bool CompileObjectPropertyPath(UClass* Class, const FString& PropertyPath, FReflectionCompiledPath& OutPath);
+
+	// 使用编译好的路径读取对象属性（字符串形式，枚举为名称）
+	UFUNCTION(BlueprintCallable, Category = "ReflectionTool|PropertyPath")
+	static bool GetObjectPropertyByCompiledPath(const FReflectionCompiledPath& Path, UObject* Target, FString& OutValue);
+
+	// 使用编译好的路径写入对象属性（字符串形式，枚举为名称）
+	UFUNCTION(BlueprintCallable, Category = "ReflectionTool|PropertyPath")
+	static bool SetObjectPropertyByCompiledPath(const FReflectionCompiledPath& Path, UObject* Target, const FString& Value);
+
+	// 读取对象上路径指向的一个属性（字符串形式，枚举为名称）
+	UFUNCTION(BlueprintCallable, Category = "ReflectionTool|PropertyPath")
+	static bool GetObjectPropertyByPath(UObject* Target, const FString& PropertyPath, FString& OutValue);
+
+	/**
+	 * @brief 写入对象上路径指向的一个属性
+	 * @param Target 
+	 * @param PropertyPath 
+	 * @param Value 
+	 * @return 路径无效或元素不存在时返回 false
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ReflectionTool|PropertyPath")
+	static bool SetObjectPropertyByPath(UObject* Target, const FString& PropertyPath, const FString& Value);
+
+	// 读取数值属性（含枚举底层值）
+	UFUNCTION(BlueprintCallable, Category = "ReflectionTool|PropertyPath")
+	static bool GetObjectNumberByPath(UObject* Target, const FString& PropertyPath, double& OutValue);
+
+	// 写入数值属性，整数属性四舍五入
+	UFUNCTION(BlueprintCallable, Category = "ReflectionTool|PropertyPath")
+	static bool SetObjectNumberByPath(UObject* Target, const FString& PropertyPath, double Value);
+
+#pragma endregion
+
+#pragma region 结构体数组查询
+
+	/**
+	 * @brief 在结构体数组上执行过滤条件，条件按 (Struct, Expression) 编译并缓存，元素较多时并行求值
+	 * @param ElementStruct 元素类型
+	 * @param Elements 第 0 个元素地址
+	 * @param Num 元素个数
+	 * @param Expression 例如 "Count > 5 && Type == Weapon"，语法见 FReflectionStructQuery
+	 * @param OutIndices 满足条件的元素下标，升序
+	 * @return 条件无效时返回 false
+	 */
+	static bool QueryStructArray(const UScriptStruct* ElementStruct, const void* Elements, int32 Num,
+		const FString& Expression, TArray<int32>& OutIndices);
+
+	template<typename StructType>
+	static bool QueryStructArray(const TArray<StructType>& Elements, const FString& Expression, TArray<int32>& OutIndices)
+	{
+		return QueryStructArray(StructType::StaticStruct(), Elements.GetData(), Elements.Num(), Expression, OutIndices);
+	}
+
+	/**
+	 * @brief 过滤后读取每个满足条件元素上 ProjectionPath 指向的值（字符串形式，枚举为名称）
+	 * @param ProjectionPath 例如 "Stats.Damage"
+	 * @return 条件或路径无效时返回 false
+	 */
+	static bool SelectFromStructArray(const UScriptStruct* ElementStruct, const void* Elements, int32 Num,
+		const FString& Expression, const FString& ProjectionPath, TArray<FString>& OutValues);
+
+#pragma endregion
+
+#pragma region 结构体哈希 / 拷贝 / 比较
+
+	/**
+	 * @brief 结构体内容的 64 位哈希，使用按 UStruct 缓存的布局，连续的整数字段整段哈希
+	 * 与填充字节、Set / Map 的存放顺序无关，-0 与 0、所有 NaN 视为相同，结果在不同进程中稳定
+	 * @param Struct 
+	 * @param StructAddr 
+	 * @return Struct 为空时返回 0
+	 */
+	static uint64 HashStruct(const UStruct* Struct, const void* StructAddr);
+
+	// 拷贝结构体内容（两者都已初始化），相邻的 POD 属性整段 memcpy
+	static void CopyStruct(const UStruct* Struct, void* DstAddr, const void* SrcAddr);
+
+	// 比较结构体内容，与 FProperty::Identical 一致：浮点数按值比较（-0 与 0 相同，NaN 与任何值都不同），FName 不区分大小写，其余相邻的 POD 属性整段 memcmp
+	static bool CompareStruct(const UStruct* Struct, const void* AddrA, const void* AddrB);
+
+#pragma endregion
+
+#pragma region 按变量名拷贝结构体
+
+	/**
+	 * @brief 在两个按变量名兼容的结构体之间拷贝，映射按 (Src, Dst) 缓存，不经过 PPS / 字符串
+	 * 同类型字段直接拷贝，数值跨类型转换，枚举按名称转换，嵌套结构体与容器元素递归映射
+	 * @param SrcStruct 源结构体类型
+	 * @param SrcAddr 
+	 * @param DstStruct 目标结构体类型
+	 * @param DstAddr 需已初始化，没有对应字段的成员保持原值
+	 * @return 没有任何字段可以映射时返回 false
+	 */
+	static bool CopyStructByName(const UStruct* SrcStruct, const void* SrcAddr, const UStruct* DstStruct, void* DstAddr);
+
+	template<typename SrcStructType, typename DstStructType>
+	static bool CopyStructByName(const SrcStructType& Src, DstStructType& Dst)
+	{
+		return CopyStructByName(SrcStructType::StaticStruct(), &Src, DstStructType::StaticStruct(), &Dst);
+	}
+
+#pragma endregion
+
 #pragma region Blueprint Function
 	/**
 	 * @brief 获取解析结构体中的所有子节点
@@ -289,7 +653,69 @@ public:
 		FGetPropertyParserStruct(StructAddr, StructProperty->Struct, OutPropertyParserStruct);
 		P_NATIVE_END;
 	}
-	static void FGetPropertyParserStruct(const void* StructAddr, const UStruct* StructProperty, FPropertyParserStruct& OutPropertyParserStruct);
+	static void FGetPropertyParserStruct(const void* StructAddr, const UStruct* StructProperty, FPropertyParserStruct& OutPropertyParserStruct,
+		FPPSConvertContext* Context = nullptr);
+
+	/**
+	 * @brief 蓝图泛型节点，按预算获取结构体的解析结构体，超出预算的节点标记 bTruncated，结果仍是合法的树
+	 * @param StructReference 被解析的结构体
+	 * @param Options 节点数 / 内存预算
+	 * @param OutPropertyParserStruct 解析后的结构体
+	 */
+	UFUNCTION(BlueprintPure, CustomThunk, Category = "ReflectionTool", meta = (CustomStructureParam = "StructReference"))
+	static void GetPropertyParserStructWithOptions(const int32& StructReference, const FPPSConvertOptions& Options,
+		FPropertyParserStruct& OutPropertyParserStruct);
+	DECLARE_FUNCTION(execGetPropertyParserStructWithOptions)
+	{
+		// ----------------------------- Begin Get Property ----------------------------
+		// 获取 Struct 数据
+		Stack.MostRecentProperty = nullptr;
+		Stack.MostRecentPropertyAddress = nullptr;
+		Stack.Step(Stack.Object, NULL);
+		FStructProperty* StructProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
+		void* StructAddr = Stack.MostRecentPropertyAddress;
+
+		if (!StructProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+		P_GET_STRUCT_REF(FPPSConvertOptions, Options);
+		P_GET_STRUCT_REF(FPropertyParserStruct, OutPropertyParserStruct);
+		P_FINISH;
+		// ----------------------------- End Get Property -----------------------------
+
+		// 调用函数
+		P_NATIVE_BEGIN;
+		FPPSConvertContext Context(Options);
+		FGetPropertyParserStruct(StructAddr, StructProperty->Struct, OutPropertyParserStruct, &Context);
+		P_NATIVE_END;
+	}
+
+	/**
+	 * @brief 计算 PPS 树实际占用的内存（节点、字符串与 Children 数组，含预留空间）
+	 * @param PPS 
+	 * @return 字节数
+	 */
+	UFUNCTION(BlueprintPure, Category = "ReflectionTool")
+	static int64 GetPPSMemoryFootprint(const FPropertyParserStruct& PPS);
+
+	/**
+	 * @brief 把 PPS 写入可内存映射的转储文件，之后可用 OpenPPSDumpWindow / UPPSTreeViewProvider::OpenDumpFile 浏览，见 FReflectionPPSDump
+	 * @param PPS 
+	 * @param Filename 
+	 * @return 是否写入成功
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ReflectionTool")
+	static bool SavePPSDump(const FPropertyParserStruct& PPS, const FString& Filename);
+
+	/**
+	 * @brief 在新窗口中浏览转储文件，不需要 Widget 蓝图，展开节点时才读取数据；控制台命令 ReflectionTool.OpenDump 相同
+	 * @param Filename 
+	 * @return 文件无效或没有 Slate 时返回 false
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ReflectionTool")
+	static bool OpenPPSDumpWindow(const FString& Filename);
 	
 	/**
 	 * @brief 使用 PPS 设置 Struct 的值
@@ -412,6 +838,416 @@ public:
 	}
 	static void FSetStructPropertyByMap(void* StructAddr, UStruct* StructProperty, const void* MapAddr, const FMapProperty* MapProperty);
 
+	/**
+	 * @brief 蓝图泛型节点，只写入结构体中路径指向的一个属性
+	 * @param StructReference 
+	 * @param PropertyPath 
+	 * @param Value 
+	 * @param bSuccess 
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category = "ReflectionTool|PropertyPath", meta = (CustomStructureParam = "StructReference"))
+	static void SetStructPropertyByPath(const int32& StructReference, const FString& PropertyPath, const FString& Value, bool& bSuccess);
+	DECLARE_FUNCTION(execSetStructPropertyByPath)
+	{
+		// ----------------------------- Begin Get Property ----------------------------
+		// 获取 Struct 数据
+		Stack.MostRecentProperty = nullptr;
+		Stack.MostRecentPropertyAddress = nullptr;
+		Stack.Step(Stack.Object, NULL);
+		FStructProperty* StructProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
+		void* StructAddr = Stack.MostRecentPropertyAddress;
+
+		if (!StructProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+		P_GET_PROPERTY_REF(FStrProperty, PropertyPath);
+		P_GET_PROPERTY_REF(FStrProperty, Value);
+		P_GET_UBOOL_REF(bSuccess);
+		P_FINISH;
+		// ----------------------------- End Get Property -----------------------------
+
+		// 调用函数
+		P_NATIVE_BEGIN;
+		bSuccess = SetByPath(StructProperty->Struct, StructAddr, PropertyPath, Value);
+		P_NATIVE_END;
+	}
+
+	/**
+	 * @brief 蓝图泛型节点，读取结构体中路径指向的一个属性（字符串形式，枚举为名称）
+	 * @param StructReference 
+	 * @param PropertyPath 
+	 * @param Value 
+	 * @param bSuccess 
+	 */
+	UFUNCTION(BlueprintPure, CustomThunk, Category = "ReflectionTool|PropertyPath", meta = (CustomStructureParam = "StructReference"))
+	static void GetStructPropertyByPath(const int32& StructReference, const FString& PropertyPath, FString& Value, bool& bSuccess);
+	DECLARE_FUNCTION(execGetStructPropertyByPath)
+	{
+		// ----------------------------- Begin Get Property ----------------------------
+		// 获取 Struct 数据
+		Stack.MostRecentProperty = nullptr;
+		Stack.MostRecentPropertyAddress = nullptr;
+		Stack.Step(Stack.Object, NULL);
+		FStructProperty* StructProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
+		void* StructAddr = Stack.MostRecentPropertyAddress;
+
+		if (!StructProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+		P_GET_PROPERTY_REF(FStrProperty, PropertyPath);
+		P_GET_PROPERTY_REF(FStrProperty, Value);
+		P_GET_UBOOL_REF(bSuccess);
+		P_FINISH;
+		// ----------------------------- End Get Property -----------------------------
+
+		// 调用函数
+		P_NATIVE_BEGIN;
+		bSuccess = GetByPath(StructProperty->Struct, StructAddr, PropertyPath, Value);
+		P_NATIVE_END;
+	}
+
+	/**
+	 * @brief 蓝图泛型节点，按条件过滤结构体数组，返回满足条件的下标
+	 * @param TargetArray 结构体数组
+	 * @param Expression 例如 "Count > 5 && Type == Weapon"
+	 * @param OutIndices 
+	 * @return 条件无效时返回 false
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category = "ReflectionTool|Query", meta = (ArrayParm = "TargetArray"))
+	static bool FilterStructArray(const TArray<int32>& TargetArray, const FString& Expression, TArray<int32>& OutIndices);
+	DECLARE_FUNCTION(execFilterStructArray)
+	{
+		// ----------------------------- Begin Get Property ----------------------------
+		// 获取数组数据
+		Stack.MostRecentProperty = nullptr;
+		Stack.MostRecentPropertyAddress = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+		FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+		void* ArrayAddr = Stack.MostRecentPropertyAddress;
+
+		if (!ArrayProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+		P_GET_PROPERTY_REF(FStrProperty, Expression);
+		P_GET_TARRAY_REF(int32, OutIndices);
+		P_FINISH;
+		// ----------------------------- End Get Property -----------------------------
+
+		// 调用函数
+		P_NATIVE_BEGIN;
+		const FStructProperty* InnerProperty = CastField<FStructProperty>(ArrayProperty->Inner);
+		FScriptArrayHelper ArrayHelper(ArrayProperty, ArrayAddr);
+		*(bool*)RESULT_PARAM = InnerProperty && QueryStructArray(InnerProperty->Struct,
+			ArrayHelper.Num() > 0 ? ArrayHelper.GetRawPtr(0) : nullptr, ArrayHelper.Num(), Expression, OutIndices);
+		P_NATIVE_END;
+	}
+
+	/**
+	 * @brief 蓝图泛型节点，按条件过滤结构体数组，并读取满足条件元素上 ProjectionPath 指向的值
+	 * @param TargetArray 结构体数组
+	 * @param Expression 例如 "Count > 5 && Type == Weapon"
+	 * @param ProjectionPath 例如 "Stats.Damage"
+	 * @param OutValues 字符串形式，枚举为名称
+	 * @return 条件或路径无效时返回 false
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category = "ReflectionTool|Query", meta = (ArrayParm = "TargetArray"))
+	static bool SelectStructArray(const TArray<int32>& TargetArray, const FString& Expression, const FString& ProjectionPath,
+		TArray<FString>& OutValues);
+	DECLARE_FUNCTION(execSelectStructArray)
+	{
+		// ----------------------------- Begin Get Property ----------------------------
+		// 获取数组数据
+		Stack.MostRecentProperty = nullptr;
+		Stack.MostRecentPropertyAddress = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+		FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+		void* ArrayAddr = Stack.MostRecentPropertyAddress;
+
+		if (!ArrayProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+		P_GET_PROPERTY_REF(FStrProperty, Expression);
+		P_GET_PROPERTY_REF(FStrProperty, ProjectionPath);
+		P_GET_TARRAY_REF(FString, OutValues);
+		P_FINISH;
+		// ----------------------------- End Get Property -----------------------------
+
+		// 调用函数
+		P_NATIVE_BEGIN;
+		const FStructProperty* InnerProperty = CastField<FStructProperty>(ArrayProperty->Inner);
+		FScriptArrayHelper ArrayHelper(ArrayProperty, ArrayAddr);
+		*(bool*)RESULT_PARAM = InnerProperty && SelectFromStructArray(InnerProperty->Struct,
+			ArrayHelper.Num() > 0 ? ArrayHelper.GetRawPtr(0) : nullptr, ArrayHelper.Num(), Expression, ProjectionPath, OutValues);
+		P_NATIVE_END;
+	}
+
+	/**
+	 * @brief 蓝图泛型节点，把结构体数组每个元素上路径指向的数值（含枚举底层值）提取为一列
+	 * @param TargetArray 结构体数组
+	 * @param PropertyPath 例如 "Stats.Health"
+	 * @param OutValues 与 TargetArray 等长
+	 * @return 路径无效或类型不兼容时返回 false
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category = "ReflectionTool|Columns", meta = (ArrayParm = "TargetArray"))
+	static bool ExtractStructArrayNumbers(const TArray<int32>& TargetArray, const FString& PropertyPath, TArray<double>& OutValues);
+	DECLARE_FUNCTION(execExtractStructArrayNumbers)
+	{
+		// ----------------------------- Begin Get Property ----------------------------
+		// 获取数组数据
+		Stack.MostRecentProperty = nullptr;
+		Stack.MostRecentPropertyAddress = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+		FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+		void* ArrayAddr = Stack.MostRecentPropertyAddress;
+
+		if (!ArrayProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+		P_GET_PROPERTY_REF(FStrProperty, PropertyPath);
+		P_GET_TARRAY_REF(double, OutValues);
+		P_FINISH;
+		// ----------------------------- End Get Property -----------------------------
+
+		// 调用函数
+		P_NATIVE_BEGIN;
+		const FStructProperty* InnerProperty = CastField<FStructProperty>(ArrayProperty->Inner);
+		FScriptArrayHelper ArrayHelper(ArrayProperty, ArrayAddr);
+		*(bool*)RESULT_PARAM = InnerProperty && FReflectionStructColumns::Extract(InnerProperty->Struct,
+			ArrayHelper.Num() > 0 ? ArrayHelper.GetRawPtr(0) : nullptr, ArrayHelper.Num(), PropertyPath, OutValues);
+		P_NATIVE_END;
+	}
+
+	/**
+	 * @brief 蓝图泛型节点，把一列数值写回结构体数组每个元素上路径指向的属性，整数属性四舍五入
+	 * @param TargetArray 结构体数组
+	 * @param PropertyPath 例如 "Stats.Health"
+	 * @param Values 长度必须与 TargetArray 相同
+	 * @return 路径无效、类型不兼容或长度不一致时返回 false
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category = "ReflectionTool|Columns", meta = (ArrayParm = "TargetArray"))
+	static bool ScatterStructArrayNumbers(UPARAM(ref) TArray<int32>& TargetArray, const FString& PropertyPath, const TArray<double>& Values);
+	DECLARE_FUNCTION(execScatterStructArrayNumbers)
+	{
+		// ----------------------------- Begin Get Property ----------------------------
+		// 获取数组数据
+		Stack.MostRecentProperty = nullptr;
+		Stack.MostRecentPropertyAddress = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+		FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+		void* ArrayAddr = Stack.MostRecentPropertyAddress;
+
+		if (!ArrayProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+		P_GET_PROPERTY_REF(FStrProperty, PropertyPath);
+		P_GET_TARRAY_REF(double, Values);
+		P_FINISH;
+		// ----------------------------- End Get Property -----------------------------
+
+		// 调用函数
+		P_NATIVE_BEGIN;
+		const FStructProperty* InnerProperty = CastField<FStructProperty>(ArrayProperty->Inner);
+		FScriptArrayHelper ArrayHelper(ArrayProperty, ArrayAddr);
+		*(bool*)RESULT_PARAM = InnerProperty && FReflectionStructColumns::Scatter<double>(InnerProperty->Struct,
+			ArrayHelper.Num() > 0 ? ArrayHelper.GetRawPtr(0) : nullptr, ArrayHelper.Num(), PropertyPath, Values);
+		P_NATIVE_END;
+	}
+
+	/**
+	 * @brief 蓝图泛型节点，把结构体数组每个元素上路径指向的值提取为字符串列（枚举为名称）
+	 * @param TargetArray 结构体数组
+	 * @param PropertyPath 例如 "Stats.Health"
+	 * @param OutValues 与 TargetArray 等长
+	 * @return 路径无效或类型不兼容时返回 false
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category = "ReflectionTool|Columns", meta = (ArrayParm = "TargetArray"))
+	static bool ExtractStructArrayStrings(const TArray<int32>& TargetArray, const FString& PropertyPath, TArray<FString>& OutValues);
+	DECLARE_FUNCTION(execExtractStructArrayStrings)
+	{
+		// ----------------------------- Begin Get Property ----------------------------
+		// 获取数组数据
+		Stack.MostRecentProperty = nullptr;
+		Stack.MostRecentPropertyAddress = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+		FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+		void* ArrayAddr = Stack.MostRecentPropertyAddress;
+
+		if (!ArrayProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+		P_GET_PROPERTY_REF(FStrProperty, PropertyPath);
+		P_GET_TARRAY_REF(FString, OutValues);
+		P_FINISH;
+		// ----------------------------- End Get Property -----------------------------
+
+		// 调用函数
+		P_NATIVE_BEGIN;
+		const FStructProperty* InnerProperty = CastField<FStructProperty>(ArrayProperty->Inner);
+		FScriptArrayHelper ArrayHelper(ArrayProperty, ArrayAddr);
+		*(bool*)RESULT_PARAM = InnerProperty && FReflectionStructColumns::Extract(InnerProperty->Struct,
+			ArrayHelper.Num() > 0 ? ArrayHelper.GetRawPtr(0) : nullptr, ArrayHelper.Num(), PropertyPath, OutValues);
+		P_NATIVE_END;
+	}
+
+	/**
+	 * @brief 蓝图泛型节点，把一列字符串写回结构体数组每个元素上路径指向的属性（枚举按名称）
+	 * @param TargetArray 结构体数组
+	 * @param PropertyPath 例如 "Stats.Health"
+	 * @param Values 长度必须与 TargetArray 相同
+	 * @return 路径无效、类型不兼容或长度不一致时返回 false
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category = "ReflectionTool|Columns", meta = (ArrayParm = "TargetArray"))
+	static bool ScatterStructArrayStrings(UPARAM(ref) TArray<int32>& TargetArray, const FString& PropertyPath, const TArray<FString>& Values);
+	DECLARE_FUNCTION(execScatterStructArrayStrings)
+	{
+		// ----------------------------- Begin Get Property ----------------------------
+		// 获取数组数据
+		Stack.MostRecentProperty = nullptr;
+		Stack.MostRecentPropertyAddress = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+		FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+		void* ArrayAddr = Stack.MostRecentPropertyAddress;
+
+		if (!ArrayProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+		P_GET_PROPERTY_REF(FStrProperty, PropertyPath);
+		P_GET_TARRAY_REF(FString, Values);
+		P_FINISH;
+		// ----------------------------- End Get Property -----------------------------
+
+		// 调用函数
+		P_NATIVE_BEGIN;
+		const FStructProperty* InnerProperty = CastField<FStructProperty>(ArrayProperty->Inner);
+		FScriptArrayHelper ArrayHelper(ArrayProperty, ArrayAddr);
+		*(bool*)RESULT_PARAM = InnerProperty && FReflectionStructColumns::Scatter<FString>(InnerProperty->Struct,
+			ArrayHelper.Num() > 0 ? ArrayHelper.GetRawPtr(0) : nullptr, ArrayHelper.Num(), PropertyPath, Values);
+		P_NATIVE_END;
+	}
+
+	/**
+	 * @brief 蓝图泛型节点，获取结构体内容的哈希，可作为缓存 Key 或判断内容是否变化
+	 * @param StructReference 
+	 * @param Hash 
+	 */
+	UFUNCTION(BlueprintPure, CustomThunk, Category = "ReflectionTool", meta = (CustomStructureParam = "StructReference"))
+	static void GetStructHash(const int32& StructReference, int64& Hash);
+	DECLARE_FUNCTION(execGetStructHash)
+	{
+		// ----------------------------- Begin Get Property ----------------------------
+		// 获取 Struct 数据
+		Stack.MostRecentProperty = nullptr;
+		Stack.MostRecentPropertyAddress = nullptr;
+		Stack.Step(Stack.Object, NULL);
+		FStructProperty* StructProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
+		void* StructAddr = Stack.MostRecentPropertyAddress;
+
+		if (!StructProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+		P_GET_PROPERTY_REF(FInt64Property, Hash);
+		P_FINISH;
+		// ----------------------------- End Get Property -----------------------------
+
+		// 调用函数
+		P_NATIVE_BEGIN;
+		Hash = static_cast<int64>(HashStruct(StructProperty->Struct, StructAddr));
+		P_NATIVE_END;
+	}
+
+	/**
+	 * @brief 蓝图泛型节点，把源结构体中的同名字段拷贝到目标结构体（类型可以不同）
+	 * @param SourceStruct 
+	 * @param TargetStruct 
+	 * @param bSuccess 
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category = "ReflectionTool", meta = (CustomStructureParam = "SourceStruct,TargetStruct"))
+	static void CopyStructFieldsByName(const int32& SourceStruct, UPARAM(ref) int32& TargetStruct, bool& bSuccess);
+	DECLARE_FUNCTION(execCopyStructFieldsByName)
+	{
+		// ----------------------------- Begin Get Property ----------------------------
+		// 获取源 Struct 数据
+		Stack.MostRecentProperty = nullptr;
+		Stack.MostRecentPropertyAddress = nullptr;
+		Stack.Step(Stack.Object, NULL);
+		FStructProperty* SourceProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
+		void* SourceAddr = Stack.MostRecentPropertyAddress;
+
+		// 获取目标 Struct 数据
+		Stack.MostRecentProperty = nullptr;
+		Stack.MostRecentPropertyAddress = nullptr;
+		Stack.Step(Stack.Object, NULL);
+		FStructProperty* TargetProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
+		void* TargetAddr = Stack.MostRecentPropertyAddress;
+
+		if (!SourceProperty || !TargetProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+		P_GET_UBOOL_REF(bSuccess);
+		P_FINISH;
+		// ----------------------------- End Get Property -----------------------------
+
+		// 调用函数
+		P_NATIVE_BEGIN;
+		bSuccess = CopyStructByName(SourceProperty->Struct, SourceAddr, TargetProperty->Struct, TargetAddr);
+		P_NATIVE_END;
+	}
+
+	/**
+	 * @brief 蓝图泛型节点，流式解析 JSON 直接写入结构体，不构建 JsonObject 与 PPS
+	 * @param StructReference
+	 * @param Json
+	 * @param bSuccess
+	 */
+	UFUNCTION(BlueprintCallable, CustomThunk, Category = "ReflectionTool", meta = (CustomStructureParam = "StructReference"))
+	static void SetStructByJson(const int32& StructReference, const FString& Json, bool& bSuccess);
+	DECLARE_FUNCTION(execSetStructByJson)
+	{
+		// ----------------------------- Begin Get Property ----------------------------
+		// 获取 Struct 数据
+		Stack.MostRecentProperty = nullptr;
+		Stack.MostRecentPropertyAddress = nullptr;
+		Stack.Step(Stack.Object, NULL);
+		FStructProperty* StructProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
+		void* StructAddr = Stack.MostRecentPropertyAddress;
+
+		if (!StructProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+		P_GET_PROPERTY_REF(FStrProperty, Json);
+		P_GET_UBOOL_REF(bSuccess);
+		P_FINISH;
+		// ----------------------------- End Get Property -----------------------------
+
+		// 调用函数
+		P_NATIVE_BEGIN;
+		bSuccess = FSetStructByJson(StructAddr, StructProperty->Struct, Json);
+		P_NATIVE_END;
+	}
+	static bool FSetStructByJson(void* StructAddr, const UStruct* StructProperty, const FString& Json);
+
 	/**
 	 * @brief 设置 PPS 的子节点
 	 * @param PPS 
@@ -431,14 +1267,22 @@ template <typename InStructType>
 void UReflectionToolLib::UStructToPropertyStruct(const InStructType& InStruct,
 	FPropertyParserStruct& OutPropertyParserStruct)
 {
-	GetStructProperty(InStructType::StaticStruct(), &InStruct, OutPropertyParserStruct);
+	FReflectionToolGeneratedConverters::FConverter Converter;
+	if (FReflectionToolGeneratedConverters::Find(InStructType::StaticStruct(), Converter) && Converter.ToPropertyStruct)
+	{
+		Converter.ToPropertyStruct(&InStruct, OutPropertyParserStruct);
+	}
+	else
+	{
+		GetStructProperty(InStructType::StaticStruct(), &InStruct, OutPropertyParserStruct);
+	}
 }
 
 template <typename InStructType>
 void UReflectionToolLib::UStructToMap(const InStructType& InStruct, TMap<FString, FString>& ResultMap)
 {
 	FPropertyParserStruct OutPropertyParserStruct;
-	GetStructProperty(InStructType::StaticStruct(), &InStruct, OutPropertyParserStruct);
+	UStructToPropertyStruct(InStruct, OutPropertyParserStruct);
 	GetKeyValueFromPPS(OutPropertyParserStruct, ResultMap);
 }
 
@@ -543,8 +1387,32 @@ bool UReflectionToolLib::InvokeFunctionByName(UObject* TargetObject, const FName
 	return InvokeFunction<TReturns...>(nullptr, TargetObject, Func, OutParams, Forward<TArgs>(Args)...);
 }
 
+template <typename ValueType>
+bool UReflectionToolLib::SetByPath(const UStruct* Struct, void* Container, const FString& PropertyPath,
+	const ValueType& Value)
+{
+	const TSharedPtr<const FReflectionPropertyPath> Path = FReflectionPropertyPath::Compile(Struct, PropertyPath);
+	return Path.IsValid() && Path->SetValue(Container, Value);
+}
+
+template <typename ValueType>
+bool UReflectionToolLib::GetByPath(const UStruct* Struct, const void* Container, const FString& PropertyPath,
+	ValueType& OutValue)
+{
+	const TSharedPtr<const FReflectionPropertyPath> Path = FReflectionPropertyPath::Compile(Struct, PropertyPath);
+	return Path.IsValid() && Path->GetValue(Container, OutValue);
+}
+
 template <typename InStructType>
 void UReflectionToolLib::SetStructByMap(InStructType& InStruct, const TMap<FString, FString>& InMap)
 {
-	SetStructValueByMap(InStructType::StaticStruct(), &InStruct, InMap);
+	FReflectionToolGeneratedConverters::FConverter Converter;
+	if (FReflectionToolGeneratedConverters::Find(InStructType::StaticStruct(), Converter) && Converter.SetFromMap)
+	{
+		Converter.SetFromMap(&InStruct, InMap);
+	}
+	else
+	{
+		SetStructValueByMap(InStructType::StaticStruct(), &InStruct, InMap);
+	}
 }
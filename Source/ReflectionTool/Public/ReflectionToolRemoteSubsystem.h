@@ -0,0 +1,110 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ReflectionToolRemoteSubsystem.generated.h"
+
+class FSocket;
+class FJsonObject;
+class FJsonValue;
+
+// 远程检查服务可读写任意属性、调用蓝图可调用的函数，Shipping 中不编译
+#define REFLECTIONTOOL_REMOTE (!UE_BUILD_SHIPPING)
+
+/**
+ * 本机回环地址上的远程检查服务，供外部工具读写属性、调用函数、拉取监听变化
+ * 协议为按行分隔的 JSON：每行一个批次 {"id":1,"requests":[...]}，回复一行 {"id":1,"results":[...]}，结果与请求一一对应
+ * 请求：
+ *   {"op":"get","object":"...","path":"Stats"}                         读取路径指向的值（JSON），path 为空时读取整个对象
+ *   {"op":"set","object":"...","path":"Stats.Health","value":"100"}    按字符串写入
+ *   {"op":"children","object":"...","path":"Items","offset":0,"count":100}  分页读取容器元素 / 结构体成员
+ *   {"op":"invoke","object":"...","function":"Foo","params":{"A":"1"}} 调用 BlueprintCallable / Exec 函数，outputs 中为输出参数与返回值（ReturnValue）
+ *   {"op":"watch","object":"...","path":"..."} / {"op":"unwatch","handle":0} / {"op":"poll"}  监听与拉取变化（同一监听只保留最新值）
+ * object 为对象完整路径，或当前 World 中 Actor 的名称
+ * 所有请求在 Tick 中处理，每帧处理时间受 ReflectionTool.Remote.BudgetMs 限制，按单个请求检查，未处理完的批次留到下一帧继续
+ * Shipping 中不创建此子系统，StartServer 总是返回 false
+ */
+UCLASS()
+class REFLECTIONTOOL_API UReflectionToolRemoteSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickableWhenPaused() const override { return true; }
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	/**
+	 * @brief 在 127.0.0.1:Port 上开始监听
+	 * @return 端口被占用等原因失败时返回 false
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ReflectionTool|Remote")
+	bool StartServer(int32 Port);
+
+	UFUNCTION(BlueprintCallable, Category = "ReflectionTool|Remote")
+	void StopServer();
+
+	UFUNCTION(BlueprintPure, Category = "ReflectionTool|Remote")
+	bool IsServerRunning() const { return ListenSocket != nullptr; }
+
+	UFUNCTION(BlueprintPure, Category = "ReflectionTool|Remote")
+	int32 GetNumClients() const { return Clients.Num(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// 已解析、未处理完的批次
+	struct FActiveBatch
+	{
+		TSharedPtr<FJsonValue> Id;
+		TArray<TSharedPtr<FJsonValue>> Requests;
+		TArray<TSharedPtr<FJsonValue>> Results;
+	};
+
+	struct FClient
+	{
+		FSocket* Socket = nullptr;
+		// 未组成完整行的数据
+		TArray<uint8> RecvBuffer;
+		// 已收到、未处理的批次
+		TArray<FString> PendingBatches;
+		// 正在处理的批次，超出预算时下一帧从 Results.Num() 继续
+		TOptional<FActiveBatch> ActiveBatch;
+		// 未发送完的回复
+		TArray<uint8> SendBuffer;
+		// 本连接注册的监听
+		TSet<int32> WatchHandles;
+		// 监听句柄 -> 上次 poll 之后的最新值
+		TMap<int32, TSharedPtr<FJsonValue>> PendingDeltas;
+		bool bClosed = false;
+	};
+
+	void AcceptClients();
+	void ReceiveFromClient(FClient& Client);
+	void FlushClient(FClient& Client);
+	void CloseClient(FClient& Client);
+
+	// 解析一行批次为 Client.ActiveBatch，无效时直接回复错误
+	void BeginBatch(FClient& Client, const FString& Line);
+	// 处理 ActiveBatch 中的请求，bProcessedAny 为 true 时超过 Deadline 即停止；处理完时回复写入 Client.SendBuffer
+	void ContinueBatch(FClient& Client, double Deadline, bool& bProcessedAny);
+	void SendResponse(FClient& Client, const TSharedRef<FJsonObject>& Response);
+	TSharedRef<FJsonObject> ProcessRequest(FClient& Client, const FJsonObject& Request);
+
+	UObject* ResolveObject(const FString& Name) const;
+	void OnWatchChanged(int32 WatchHandle, UObject* Object, const FProperty* LeafProperty, const void* NewValueAddr);
+
+	// 非阻塞的监听 Socket，Tick 中接受新连接
+	FSocket* ListenSocket = nullptr;
+	TArray<TUniquePtr<FClient>> Clients;
+	// 监听句柄 -> 所属连接
+	TMap<int32, FClient*> WatchOwners;
+	FDelegateHandle WatchChangedHandle;
+	// 轮流从不同连接开始处理，避免一个连接占满预算
+	int32 NextClientIndex = 0;
+};
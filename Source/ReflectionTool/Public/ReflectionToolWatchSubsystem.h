@@ -0,0 +1,116 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ReflectionToolWatchSubsystem.generated.h"
+
+struct FReflectionPropertyPath;
+class FReflectionStructLayout;
+
+DECLARE_DYNAMIC_DELEGATE_FourParams(FOnPropertyWatchChangedDynamic, int32, WatchHandle, UObject*, Object,
+	const FString&, PropertyPath, const FString&, NewValue);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FOnPropertyWatchChangedMulticast, int32, WatchHandle, UObject*, Object,
+	const FString&, PropertyPath, const FString&, NewValue);
+// C++ 侧回调，直接拿到叶子属性与新值地址，不做字符串转换
+DECLARE_MULTICAST_DELEGATE_FourParams(FOnPropertyWatchChangedNative, int32 /*WatchHandle*/, UObject* /*Object*/,
+	const FProperty* /*LeafProperty*/, const void* /*NewValueAddr*/);
+
+/**
+ * 属性监听子系统：注册 (对象, 属性路径) 后每帧批量检查，值变化时广播事件
+ * 代替每帧 GetPropertyParserStruct + 字符串比较的轮询方式
+ */
+UCLASS()
+class REFLECTIONTOOL_API UReflectionToolWatchSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * @brief 监听对象上的一个属性
+	 * @param Object 目标对象
+	 * @param PropertyPath 属性路径，例如 "Stats.Health"、"Items[2].Count"
+	 * @param OnChanged 单独的变化回调（可不绑定，统一走 OnPropertyWatchChanged）
+	 * @return 监听句柄，失败返回 INDEX_NONE
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ReflectionTool|Watch")
+	int32 AddPropertyWatch(UObject* Object, const FString& PropertyPath, FOnPropertyWatchChangedDynamic OnChanged);
+
+	// C++ 版本，不需要动态委托
+	int32 AddPropertyWatch(UObject* Object, const FString& PropertyPath);
+
+	UFUNCTION(BlueprintCallable, Category = "ReflectionTool|Watch")
+	bool RemovePropertyWatch(int32 WatchHandle);
+
+	// 移除某个对象上的所有监听
+	UFUNCTION(BlueprintCallable, Category = "ReflectionTool|Watch")
+	void RemoveAllWatchesForObject(UObject* Object);
+
+	UFUNCTION(BlueprintCallable, Category = "ReflectionTool|Watch")
+	void ClearPropertyWatches();
+
+	UFUNCTION(BlueprintPure, Category = "ReflectionTool|Watch")
+	int32 GetNumPropertyWatches() const { return Watches.Num(); }
+
+	// 任意监听发生变化时广播
+	UPROPERTY(BlueprintAssignable, Category = "ReflectionTool|Watch")
+	FOnPropertyWatchChangedMulticast OnPropertyWatchChanged;
+
+	FOnPropertyWatchChangedNative OnPropertyWatchChangedNative;
+
+private:
+	// 上一次检查时的值，POD 直接拷贝字节，结构体按布局拷贝 / 比较，其余类型保存一份拷贝用 Identical 比较
+	// float 与 FName 即使是 POD 也按值比较，与 FProperty::Identical 一致
+	struct FValueSnapshot
+	{
+		FValueSnapshot(const FProperty* InProperty, int32 InArrayDim);
+		~FValueSnapshot();
+
+		bool Matches(const void* Addr) const;
+		void Store(const void* Addr);
+
+		const FProperty* Property;
+		int32 ArrayDim;
+		int32 Size;
+		bool bPlainOldData;
+		// 可以整段按字节比较（不含 float / FName）
+		bool bBytewiseIdentical;
+		// 结构体叶子的布局
+		TSharedPtr<const FReflectionStructLayout> Layout;
+		uint8* Data;
+	};
+
+	struct FPropertyWatch
+	{
+		int32 Handle = INDEX_NONE;
+		TWeakObjectPtr<UObject> Object;
+		// 反射数据变化后用于重新编译
+		FString PathString;
+		TSharedPtr<const FReflectionPropertyPath> Path;
+		TUniquePtr<FValueSnapshot> Snapshot;
+		// 上一帧路径是否能解析（数组越界时为 false）
+		bool bResolved = false;
+		FOnPropertyWatchChangedDynamic OnChanged;
+	};
+
+	int32 AddWatchInternal(UObject* Object, const FString& PropertyPath, const FOnPropertyWatchChangedDynamic& OnChanged);
+	void BroadcastChange(const FPropertyWatch& Watch, const void* NewValueAddr);
+	// 快照按旧的 FProperty 分配，需在属性销毁前释放
+	void HandleReflectionDataChanging();
+	// 重新编译路径并记录当前值，不触发事件；无法编译的监听被移除
+	void HandleReflectionDataChanged();
+
+	TArray<FPropertyWatch> Watches;
+	// 本帧发生变化的监听下标，复用避免每帧分配
+	TArray<int32> ChangedScratch;
+	int32 NextHandle = 0;
+	// 正在广播时移除监听只做标记
+	bool bBroadcasting = false;
+	FDelegateHandle ReflectionDataChangingHandle;
+	FDelegateHandle ReflectionDataChangedHandle;
+};
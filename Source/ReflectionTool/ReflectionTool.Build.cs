@@ -42,10 +42,19 @@ public class ReflectionTool : ModuleRules
 				"JsonUtilities",
 				"Serialization",
 				"PakFile",
+				"Projects",
+				"Sockets",
+				"Networking",
 				"UMG"
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
+
+		// 用户结构体重新编译的通知（FStructureEditorUtils）
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.Add("UnrealEd");
+		}
 		
 		
 		DynamicallyLoadedModuleNames.AddRange(
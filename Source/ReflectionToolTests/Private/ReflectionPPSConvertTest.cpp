@@ -0,0 +1,120 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#include "ReflectionToolLib.h"
+#include "ReflectionStructSnapshot.h"
+#include "ReflectionToolTestTypes.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ReflectionPPSConvertTest
+{
+	// 原生转换写入的驻留形式与字符串一致
+	bool AreNameIdsConsistent(const FPropertyParserStruct& PPS)
+	{
+		if ((!PPS.NameId.IsNone() && PPS.NameId.ToString() != PPS.Name)
+			|| (!PPS.TypeNameId.IsNone() && PPS.TypeNameId.ToString() != PPS.TypeName))
+			return false;
+		for (const FPropertyParserStruct& Child : PPS.Children)
+		{
+			if (!AreNameIdsConsistent(Child))
+				return false;
+		}
+		return true;
+	}
+
+	// 去掉驻留形式，模拟蓝图中构造的 PPS
+	void ClearNameIds(FPropertyParserStruct& PPS)
+	{
+		PPS.NameId = NAME_None;
+		PPS.TypeNameId = NAME_None;
+		for (FPropertyParserStruct& Child : PPS.Children)
+		{
+			ClearNameIds(Child);
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FReflectionPPSConvertRoundTripTest, "ReflectionTool.PPSConvert.RoundTrip",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FReflectionPPSConvertRoundTripTest::RunTest(const FString& Parameters)
+{
+	const FRTTestRecord Source = ReflectionToolTests::MakeRecord(6);
+	FPropertyParserStruct PPS;
+	UReflectionToolLib::UStructToPropertyStruct(Source, PPS);
+	TestTrue(TEXT("Name ids match strings"), ReflectionPPSConvertTest::AreNameIdsConsistent(PPS));
+	if (TestTrue(TEXT("Has children"), PPS.Children.Num() > 0))
+	{
+		TestEqual(TEXT("First child name id"), PPS.Children[0].NameId, FName(TEXT("Health")));
+	}
+
+	// 原生生成的 PPS 按驻留名称应用
+	FRTTestRecord Parsed;
+	UReflectionToolLib::ParsePPSToStruct(PPS, Parsed);
+	TestTrue(TEXT("Native PPS round trip"), ReflectionToolTests::AreEqual(Source, Parsed));
+
+	// 只有字符串的 PPS（蓝图中构造）回退到字符串
+	FPropertyParserStruct StringOnly = PPS;
+	ReflectionPPSConvertTest::ClearNameIds(StringOnly);
+	FRTTestRecord ParsedFromStrings;
+	UReflectionToolLib::ParsePPSToStruct(StringOnly, ParsedFromStrings);
+	TestTrue(TEXT("String-only PPS round trip"), ReflectionToolTests::AreEqual(Source, ParsedFromStrings));
+
+	// Map 平铺与应用
+	TMap<FString, FString> Map;
+	UReflectionToolLib::UStructToMap(Source, Map);
+	TestEqual(TEXT("Map has Health"), Map.FindRef(TEXT("Health")), FString::FromInt(Source.Health));
+	FRTTestRecord FromMap;
+	UReflectionToolLib::SetStructByMap(FromMap, Map);
+	TestEqual(TEXT("Map applies Health"), FromMap.Health, Source.Health);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FReflectionPPSConvertChunkedCaptureTest, "ReflectionTool.PPSConvert.ChunkedCapture",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FReflectionPPSConvertChunkedCaptureTest::RunTest(const FString& Parameters)
+{
+	FRTTestRecord Record = ReflectionToolTests::MakeRecord(3);
+	for (int32 i = 0; i < 10; ++i)
+	{
+		Record.Scores.Add(i * 7);
+		Record.Flags.Add(FString::Printf(TEXT("Extra_%d"), i));
+		Record.Attributes.Add(FString::Printf(TEXT("Stat_%d"), i), i);
+	}
+	// 制造稀疏下标，分段按稀疏下标推进
+	Record.Flags.Remove(TEXT("Extra_4"));
+	Record.Attributes.Remove(TEXT("Stat_2"));
+
+	// 每段一个元素逐段拷贝容器，其余属性整体拷贝，结果与整体拷贝相同
+	const UStruct* Struct = FRTTestRecord::StaticStruct();
+	TSharedRef<FReflectionStructSnapshot> Snapshot = FReflectionStructSnapshot::CreateEmpty(Struct);
+	for (TFieldIterator<FProperty> It(Struct); It; ++It)
+	{
+		int32 NumSteps = 0;
+		for (int32 Index = 0; Index != INDEX_NONE; ++NumSteps)
+		{
+			Index = Snapshot->CaptureContainerElements(*It, &Record, Index, 1);
+		}
+		if (It->IsA<FArrayProperty>() || It->IsA<FSetProperty>() || It->IsA<FMapProperty>())
+		{
+			TestTrue(FString::Printf(TEXT("%s captured in chunks"), *It->GetName()), NumSteps > 1);
+		}
+	}
+	TestTrue(TEXT("Chunked capture matches the source"),
+		ReflectionToolTests::AreEqual(Record, *static_cast<const FRTTestRecord*>(Snapshot->GetData())));
+
+	// 重新从 0 开始时清空之前拷贝的元素
+	Record.Scores.SetNum(2);
+	Record.Flags.Reset();
+	FProperty* ScoresProperty = Struct->FindPropertyByName(GET_MEMBER_NAME_CHECKED(FRTTestRecord, Scores));
+	FProperty* FlagsProperty = Struct->FindPropertyByName(GET_MEMBER_NAME_CHECKED(FRTTestRecord, Flags));
+	TestEqual(TEXT("Shrunk array in one chunk"), Snapshot->CaptureContainerElements(ScoresProperty, &Record, 0, 16), int32(INDEX_NONE));
+	TestEqual(TEXT("Emptied set in one chunk"), Snapshot->CaptureContainerElements(FlagsProperty, &Record, 0, 16), int32(INDEX_NONE));
+	TestTrue(TEXT("Recapture matches the source"),
+		ReflectionToolTests::AreEqual(Record, *static_cast<const FRTTestRecord*>(Snapshot->GetData())));
+	return true;
+}
+
+#endif
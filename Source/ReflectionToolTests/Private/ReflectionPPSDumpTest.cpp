@@ -0,0 +1,120 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#include "ReflectionPPSDump.h"
+#include "ReflectionToolLib.h"
+#include "ReflectionToolTestTypes.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ReflectionPPSDumpTest
+{
+	int32 CountNodes(const FPropertyParserStruct& PPS)
+	{
+		int32 Count = 1;
+		for (const FPropertyParserStruct& Child : PPS.Children)
+		{
+			Count += CountNodes(Child);
+		}
+		return Count;
+	}
+
+	bool AreEqual(const FPropertyParserStruct& A, const FPropertyParserStruct& B)
+	{
+		if (A.Name != B.Name || A.TypeName != B.TypeName || A.Value != B.Value || A.Children.Num() != B.Children.Num())
+			return false;
+		for (int32 i = 0; i < A.Children.Num(); ++i)
+		{
+			if (!AreEqual(A.Children[i], B.Children[i]))
+				return false;
+		}
+		return true;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FReflectionPPSDumpRoundTripTest, "ReflectionTool.PPSDump.RoundTrip",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FReflectionPPSDumpRoundTripTest::RunTest(const FString& Parameters)
+{
+	const FRTTestRecord Source = ReflectionToolTests::MakeRecord(4);
+	FPropertyParserStruct PPS;
+	UReflectionToolLib::UStructToPropertyStruct(Source, PPS);
+
+	const FString Filename = FPaths::AutomationTransientDir() / TEXT("ReflectionToolPPSDumpTest.rtpd");
+	if (!TestTrue(TEXT("Dump written"), FReflectionPPSDump::Write(PPS, Filename)))
+		return false;
+
+	{
+		TSharedPtr<FReflectionPPSDump> Dump = FReflectionPPSDump::Open(Filename);
+		if (TestTrue(TEXT("Dump opened"), Dump.IsValid()))
+		{
+			TestEqual(TEXT("Node count"), Dump->GetNumNodes(), ReflectionPPSDumpTest::CountNodes(PPS));
+			TestEqual(TEXT("Root children"), Dump->GetNumChildren(0), PPS.Children.Num());
+			if (PPS.Children.Num() > 0)
+			{
+				const int32 FirstChild = Dump->GetFirstChild(0);
+				TestEqual(TEXT("First child name"), Dump->GetName(FirstChild), PPS.Children[0].Name);
+				TestEqual(TEXT("First child type"), Dump->GetTypeName(FirstChild), PPS.Children[0].TypeName);
+				TestEqual(TEXT("First child value"), Dump->GetValue(FirstChild), PPS.Children[0].Value);
+			}
+			TestEqual(TEXT("Invalid index"), Dump->GetName(Dump->GetNumNodes()), FString());
+
+			// 还原出的 PPS 与原树相同，再应用回结构体得到原始数据
+			FPropertyParserStruct Restored;
+			Dump->ToPPS(0, Restored);
+			TestTrue(TEXT("PPS round trip"), ReflectionPPSDumpTest::AreEqual(PPS, Restored));
+			FRTTestRecord Parsed;
+			UReflectionToolLib::ParsePPSToStruct(Restored, Parsed);
+			TestTrue(TEXT("Struct round trip"), ReflectionToolTests::AreEqual(Source, Parsed));
+		}
+	}
+
+	// 流式写入：子树逐个追加，结果与整棵树相同
+	const FString StreamFilename = FPaths::AutomationTransientDir() / TEXT("ReflectionToolPPSDumpTest_Stream.rtpd");
+	FPropertyParserStruct StreamRoot;
+	StreamRoot.Name = TEXT("Root");
+	StreamRoot.TypeName = TEXT("World");
+	StreamRoot.bHaveChild = true;
+	{
+		FReflectionPPSDumpWriter StreamWriter(StreamFilename, StreamRoot.Name, StreamRoot.TypeName);
+		TestTrue(TEXT("Stream writer valid"), StreamWriter.IsValid());
+		for (int32 Seed = 0; Seed < 3; ++Seed)
+		{
+			FPropertyParserStruct& Child = StreamRoot.Children.AddDefaulted_GetRef();
+			UReflectionToolLib::UStructToPropertyStruct(ReflectionToolTests::MakeRecord(Seed), Child);
+			Child.Name = FString::Printf(TEXT("Record_%d"), Seed);
+			StreamWriter.Add(Child);
+		}
+		TestTrue(TEXT("Stream dump written"), StreamWriter.Close());
+	}
+	{
+		TSharedPtr<FReflectionPPSDump> Dump = FReflectionPPSDump::Open(StreamFilename);
+		if (TestTrue(TEXT("Stream dump opened"), Dump.IsValid()))
+		{
+			TestEqual(TEXT("Stream node count"), Dump->GetNumNodes(), ReflectionPPSDumpTest::CountNodes(StreamRoot));
+			TestEqual(TEXT("Stream root children"), Dump->GetNumChildren(0), StreamRoot.Children.Num());
+			TestEqual(TEXT("Stream child depth"), Dump->GetDepth(Dump->GetFirstChild(0)), 0);
+			FPropertyParserStruct Restored;
+			Dump->ToPPS(0, Restored);
+			TestTrue(TEXT("Stream PPS round trip"), ReflectionPPSDumpTest::AreEqual(StreamRoot, Restored));
+		}
+	}
+	TestFalse(TEXT("Stream temporary files removed"), IFileManager::Get().FileExists(*(StreamFilename + TEXT(".nodes.tmp"))));
+	IFileManager::Get().Delete(*StreamFilename);
+
+	// 损坏的文件打开失败
+	TArray<uint8> Garbage = { 1, 2, 3, 4, 5, 6, 7, 8 };
+	const FString GarbageFilename = FPaths::AutomationTransientDir() / TEXT("ReflectionToolPPSDumpTest_Garbage.rtpd");
+	FFileHelper::SaveArrayToFile(Garbage, *GarbageFilename);
+	TestFalse(TEXT("Garbage rejected"), FReflectionPPSDump::Open(GarbageFilename).IsValid());
+
+	IFileManager::Get().Delete(*Filename);
+	IFileManager::Get().Delete(*GarbageFilename);
+	return true;
+}
+
+#endif
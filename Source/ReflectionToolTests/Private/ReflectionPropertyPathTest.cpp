@@ -0,0 +1,108 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#include "ReflectionPropertyPath.h"
+#include "ReflectionToolTestTypes.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FReflectionPropertyPathRoundTripTest, "ReflectionTool.PropertyPath.RoundTrip",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FReflectionPropertyPathRoundTripTest::RunTest(const FString& Parameters)
+{
+	const UStruct* Struct = FRTTestRecord::StaticStruct();
+	FRTTestRecord Record = ReflectionToolTests::MakeRecord(1);
+
+	// 字符串写入后按字符串读回
+	const TArray<TPair<FString, FString>> Cases = {
+		{ TEXT("Health"), TEXT("42") },
+		{ TEXT("bAlive"), TEXT("true") },
+		{ TEXT("Color"), TEXT("Blue") },
+		{ TEXT("Tag"), TEXT("NewTag") },
+		{ TEXT("Title"), TEXT("New Title") },
+		{ TEXT("Slots[2]"), TEXT("7") },
+		{ TEXT("Inner.Label"), TEXT("Renamed") },
+		{ TEXT("Items[1].Id"), TEXT("1234") },
+		{ TEXT("Scores[0]"), TEXT("-5") },
+		{ TEXT("Attributes[Speed]"), TEXT("88") },
+		{ TEXT("Named[\"Boss\"].Id"), TEXT("9") },
+	};
+	for (const TPair<FString, FString>& Case : Cases)
+	{
+		TSharedPtr<const FReflectionPropertyPath> Path = FReflectionPropertyPath::Compile(Struct, Case.Key);
+		if (!TestTrue(FString::Printf(TEXT("Compile %s"), *Case.Key), Path.IsValid()))
+			continue;
+		TestTrue(FString::Printf(TEXT("Set %s"), *Case.Key), Path->SetValueFromString(&Record, Case.Value));
+		FString Value;
+		TestTrue(FString::Printf(TEXT("Get %s"), *Case.Key), Path->GetValueAsString(&Record, Value));
+		TestEqual(FString::Printf(TEXT("Round trip %s"), *Case.Key), Value, Case.Value);
+	}
+
+	// 写入的是结构体中的实际字段
+	TestEqual(TEXT("Health written"), Record.Health, 42);
+	TestEqual(TEXT("Color written"), Record.Color, ERTTestColor::Blue);
+	TestEqual(TEXT("Slots[2] written"), Record.Slots[2], 7);
+	TestEqual(TEXT("Items[1].Id written"), Record.Items[1].Id, 1234);
+	TestEqual(TEXT("Attributes[Speed] written"), Record.Attributes.FindRef(TEXT("Speed")), 88);
+	TestEqual(TEXT("Named[Boss].Id written"), Record.Named.FindChecked(TEXT("Boss")).Id, 9);
+
+	// 按类型读写，数值跨类型转换
+	TSharedPtr<const FReflectionPropertyPath> SpeedPath = FReflectionPropertyPath::Compile(Struct, TEXT("Speed"));
+	if (TestTrue(TEXT("Compile Speed"), SpeedPath.IsValid()))
+	{
+		TestTrue(TEXT("SetValue<double>"), SpeedPath->SetValue(&Record, 3.25));
+		float Speed = 0.f;
+		TestTrue(TEXT("GetValue<float>"), SpeedPath->GetValue(&Record, Speed));
+		TestEqual(TEXT("Speed round trip"), Speed, 3.25f);
+	}
+	TSharedPtr<const FReflectionPropertyPath> InnerPath = FReflectionPropertyPath::Compile(Struct, TEXT("Items[2]"));
+	if (TestTrue(TEXT("Compile Items[2]"), InnerPath.IsValid()))
+	{
+		FRTTestInner Inner;
+		Inner.Id = 77;
+		Inner.Label = TEXT("Struct");
+		TestTrue(TEXT("SetValue<FRTTestInner>"), InnerPath->SetValue(&Record, Inner));
+		FRTTestInner ReadBack;
+		TestTrue(TEXT("GetValue<FRTTestInner>"), InnerPath->GetValue(&Record, ReadBack));
+		TestTrue(TEXT("Struct round trip"), ReflectionToolTests::AreEqual(Inner, ReadBack));
+	}
+
+	// 无效路径与越界
+	TestFalse(TEXT("Unknown member"), FReflectionPropertyPath::Compile(Struct, TEXT("Missing")).IsValid());
+	TestFalse(TEXT("Malformed index"), FReflectionPropertyPath::Compile(Struct, TEXT("Items[")).IsValid());
+	TSharedPtr<const FReflectionPropertyPath> OutOfRange = FReflectionPropertyPath::Compile(Struct, TEXT("Items[10].Id"));
+	if (TestTrue(TEXT("Compile Items[10].Id"), OutOfRange.IsValid()))
+	{
+		TestNull(TEXT("Out of range resolves to null"), OutOfRange->Resolve(&Record));
+		TestFalse(TEXT("Out of range write fails"), OutOfRange->SetValueFromString(&Record, TEXT("1")));
+	}
+	TSharedPtr<const FReflectionPropertyPath> ColorPath = FReflectionPropertyPath::Compile(Struct, TEXT("Color"));
+	if (ColorPath.IsValid())
+	{
+		TestFalse(TEXT("Unknown enum name fails"), ColorPath->SetValueFromString(&Record, TEXT("Purple")));
+		TestEqual(TEXT("Unknown enum name keeps value"), Record.Color, ERTTestColor::Blue);
+	}
+
+	// 无法解析的字符串返回 false
+	TSharedPtr<const FReflectionPropertyPath> HealthPath = FReflectionPropertyPath::Compile(Struct, TEXT("Health"));
+	if (HealthPath.IsValid())
+	{
+		TestFalse(TEXT("Non-numeric integer fails"), HealthPath->SetValueFromString(&Record, TEXT("abc")));
+		TestEqual(TEXT("Non-numeric integer keeps value"), Record.Health, 42);
+	}
+	if (SpeedPath.IsValid())
+	{
+		TestFalse(TEXT("Non-numeric float fails"), SpeedPath->SetValueFromString(&Record, TEXT("fast")));
+	}
+	TSharedPtr<const FReflectionPropertyPath> InnerStructPath = FReflectionPropertyPath::Compile(Struct, TEXT("Inner"));
+	if (TestTrue(TEXT("Compile Inner"), InnerStructPath.IsValid()))
+	{
+		TestTrue(TEXT("Struct import text"), InnerStructPath->SetValueFromString(&Record, TEXT("(Id=5,Label=\"Imported\",Weight=1.0)")));
+		TestEqual(TEXT("Struct import writes Id"), Record.Inner.Id, 5);
+		TestFalse(TEXT("Malformed struct text fails"), InnerStructPath->SetValueFromString(&Record, TEXT("garbage")));
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,56 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#include "ReflectionSnapshotStore.h"
+#include "ReflectionToolTestTypes.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FReflectionSnapshotStoreRoundTripTest, "ReflectionTool.SnapshotStore.RoundTrip",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FReflectionSnapshotStoreRoundTripTest::RunTest(const FString& Parameters)
+{
+	for (const FName CompressionFormat : { FName(NAME_None), FName(NAME_Zlib) })
+	{
+		FReflectionSnapshotStore Store(FRTTestRecord::StaticStruct(), 4, CompressionFormat);
+
+		// 每帧只改少量字段，差量帧应比关键帧小
+		TArray<FRTTestRecord> Frames;
+		FRTTestRecord Frame = ReflectionToolTests::MakeRecord(0);
+		for (int32 i = 0; i < 10; ++i)
+		{
+			Frame.Health += 1;
+			Frame.Items[i % Frame.Items.Num()].Weight += 1.f;
+			if (i % 3 == 0)
+			{
+				Frame.Flags.Add(FString::Printf(TEXT("Frame_%d"), i));
+			}
+			Frames.Add(Frame);
+			TestEqual(TEXT("Add returns index"), Store.Add(Frame), i);
+		}
+		TestEqual(TEXT("Num"), Store.Num(), Frames.Num());
+		TestTrue(TEXT("First frame is keyframe"), Store.IsKeyframe(0));
+		TestTrue(TEXT("Interval keyframe"), Store.IsKeyframe(4));
+		TestFalse(TEXT("Delta frame"), Store.IsKeyframe(5));
+		TestTrue(TEXT("Stored size"), Store.GetStoredSize() > 0 && Store.GetRawSize() > 0);
+
+		// 顺序、倒序、跳跃读取都还原出原始数据
+		TArray<int32> Order = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 9, 3, 7, 0, 5 };
+		for (const int32 Index : Order)
+		{
+			FRTTestRecord Restored;
+			TestTrue(FString::Printf(TEXT("Get %d (%s)"), Index, *CompressionFormat.ToString()), Store.Get(Index, Restored));
+			TestTrue(FString::Printf(TEXT("Frame %d (%s)"), Index, *CompressionFormat.ToString()),
+				ReflectionToolTests::AreEqual(Frames[Index], Restored));
+		}
+
+		FRTTestRecord Invalid;
+		TestFalse(TEXT("Invalid index"), Store.Get(Frames.Num(), Invalid));
+		Store.Reset();
+		TestEqual(TEXT("Reset"), Store.Num(), 0);
+	}
+	return true;
+}
+
+#endif
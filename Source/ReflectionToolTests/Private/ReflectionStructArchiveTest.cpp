@@ -0,0 +1,93 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#include "ReflectionStructArchive.h"
+#include "ReflectionToolTestTypes.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/ArchiveProxy.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ReflectionStructArchiveTest
+{
+	// 模拟压缩流等不知道总长度的 Archive
+	class FUnsizedReader : public FArchiveProxy
+	{
+	public:
+		using FArchiveProxy::FArchiveProxy;
+		virtual int64 TotalSize() override { return -1; }
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FReflectionStructArchiveRoundTripTest, "ReflectionTool.StructArchive.RoundTrip",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FReflectionStructArchiveRoundTripTest::RunTest(const FString& Parameters)
+{
+	TArray<FRTTestRecord> Records;
+	for (int32 i = 0; i < 5; ++i)
+	{
+		Records.Add(ReflectionToolTests::MakeRecord(i));
+	}
+	TArray<uint8> Bytes;
+	FReflectionStructArchive::SaveArray(Records, Bytes);
+	TestTrue(TEXT("Archive written"), Bytes.Num() > 0);
+
+	// 同一版本原样读回
+	TArray<FRTTestRecord> Loaded;
+	TestTrue(TEXT("Load same version"), FReflectionStructArchive::LoadArray(Bytes, Loaded));
+	if (TestEqual(TEXT("Record count"), Loaded.Num(), Records.Num()))
+	{
+		for (int32 i = 0; i < Records.Num(); ++i)
+		{
+			TestTrue(FString::Printf(TEXT("Record %d"), i), ReflectionToolTests::AreEqual(Records[i], Loaded[i]));
+		}
+	}
+
+	// 按新版本读取：数值加宽、枚举按名称，删除的字段跳过，新增的字段保持默认值
+	TArray<FRTTestRecordV2> Upgraded;
+	TestTrue(TEXT("Load new version"), FReflectionStructArchive::LoadArray(Bytes, Upgraded));
+	if (TestEqual(TEXT("Upgraded record count"), Upgraded.Num(), Records.Num()))
+	{
+		for (int32 i = 0; i < Records.Num(); ++i)
+		{
+			const FRTTestRecord& Record = Records[i];
+			const FRTTestRecordV2& Record2 = Upgraded[i];
+			TestEqual(TEXT("Health"), Record2.Health, static_cast<int64>(Record.Health));
+			TestEqual(TEXT("Speed"), Record2.Speed, static_cast<double>(Record.Speed));
+			TestEqual(TEXT("Color"), StaticEnum<ERTTestColorV2>()->GetNameStringByValue(static_cast<int64>(Record2.Color)),
+				StaticEnum<ERTTestColor>()->GetNameStringByValue(static_cast<int64>(Record.Color)));
+			TestEqual(TEXT("Slots"), Record2.Slots[1], Record.Slots[1]);
+			TestTrue(TEXT("Inner"), ReflectionToolTests::AreEqual(Record2.Inner, Record.Inner));
+			TestEqual(TEXT("Items"), Record2.Items.Num(), Record.Items.Num());
+			TestTrue(TEXT("Attributes"), Record2.Attributes.OrderIndependentCompareEqual(Record.Attributes));
+			TestEqual(TEXT("Level keeps default"), Record2.Level, 99);
+		}
+	}
+
+	// 不知道总长度的流：容器随读取增长，逐条读回
+	{
+		FMemoryReader MemoryReader(Bytes);
+		ReflectionStructArchiveTest::FUnsizedReader Reader(MemoryReader);
+		FReflectionStructArchiveReader ArchiveReader(Reader, FRTTestRecord::StaticStruct());
+		if (TestTrue(TEXT("Unsized reader valid"), ArchiveReader.IsValid()))
+		{
+			for (int32 i = 0; i < Records.Num(); ++i)
+			{
+				FRTTestRecord Record;
+				TestTrue(FString::Printf(TEXT("Unsized read %d"), i), ArchiveReader.Read(&Record));
+				TestTrue(FString::Printf(TEXT("Unsized record %d"), i), ReflectionToolTests::AreEqual(Records[i], Record));
+			}
+		}
+	}
+
+	// 截断的数据返回 false，不崩溃
+	for (const int32 Size : { 0, 4, Bytes.Num() / 2, Bytes.Num() - 1 })
+	{
+		TArray<uint8> Truncated(Bytes.GetData(), Size);
+		TArray<FRTTestRecord> Partial;
+		TestFalse(FString::Printf(TEXT("Truncated to %d bytes"), Size), FReflectionStructArchive::LoadArray(Truncated, Partial));
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,68 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#include "ReflectionStructLayout.h"
+#include "ReflectionToolTestTypes.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FReflectionStructLayoutRoundTripTest, "ReflectionTool.StructLayout.RoundTrip",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FReflectionStructLayoutRoundTripTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<const FReflectionStructLayout> Layout = FReflectionStructLayout::Get(FRTTestRecord::StaticStruct());
+	if (!TestTrue(TEXT("Layout built"), Layout.IsValid()))
+		return false;
+	TestTrue(TEXT("Layout is cached"), Layout == FReflectionStructLayout::Get(FRTTestRecord::StaticStruct()));
+
+	// 拷贝后内容相同、哈希相同
+	const FRTTestRecord Source = ReflectionToolTests::MakeRecord(3);
+	FRTTestRecord Copy = ReflectionToolTests::MakeRecord(8);
+	Layout->Copy(&Copy, &Source);
+	TestTrue(TEXT("Copy equals source"), ReflectionToolTests::AreEqual(Source, Copy));
+	TestTrue(TEXT("Identical after copy"), Layout->Identical(&Source, &Copy));
+	TestEqual(TEXT("Hash after copy"), Layout->Hash(&Source), Layout->Hash(&Copy));
+
+	// 任一层级的修改都能检测到
+	Copy.Named.FindChecked(TEXT("Boss")).Label = TEXT("Changed");
+	TestFalse(TEXT("Nested map change detected"), Layout->Identical(&Source, &Copy));
+	TestNotEqual(TEXT("Nested map change hashed"), Layout->Hash(&Source), Layout->Hash(&Copy));
+	Layout->Copy(&Copy, &Source);
+	Copy.Slots[1] += 1;
+	TestFalse(TEXT("Static array change detected"), Layout->Identical(&Source, &Copy));
+
+	// -0 与 0 相同
+	FRTTestRecord PositiveZero = Source;
+	FRTTestRecord NegativeZero = Source;
+	PositiveZero.Speed = 0.f;
+	NegativeZero.Speed = -0.f;
+	TestTrue(TEXT("-0 identical to 0"), Layout->Identical(&PositiveZero, &NegativeZero));
+	TestEqual(TEXT("-0 hashes as 0"), Layout->Hash(&PositiveZero), Layout->Hash(&NegativeZero));
+
+	// FName 不区分大小写
+	FRTTestRecord LowerName = Source;
+	LowerName.Tag = FName(*Source.Tag.ToString().ToLower());
+	TestTrue(TEXT("FName case ignored"), Layout->Identical(&Source, &LowerName));
+	TestEqual(TEXT("FName case ignored in hash"), Layout->Hash(&Source), Layout->Hash(&LowerName));
+
+	// Set / Map 的哈希与插入顺序无关
+	FRTTestRecord Reordered = Source;
+	Reordered.Flags.Reset();
+	Reordered.Attributes.Reset();
+	TArray<FString> Flags = Source.Flags.Array();
+	for (int32 i = Flags.Num() - 1; i >= 0; --i)
+	{
+		Reordered.Flags.Add(Flags[i]);
+	}
+	TArray<TPair<FString, int32>> Attributes = Source.Attributes.Array();
+	for (int32 i = Attributes.Num() - 1; i >= 0; --i)
+	{
+		Reordered.Attributes.Add(Attributes[i].Key, Attributes[i].Value);
+	}
+	TestEqual(TEXT("Hash ignores container order"), Layout->Hash(&Source), Layout->Hash(&Reordered));
+	TestNotEqual(TEXT("Seed changes hash"), Layout->Hash(&Source, 1), Layout->Hash(&Source, 2));
+	return true;
+}
+
+#endif
@@ -0,0 +1,59 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#include "ReflectionStructMapping.h"
+#include "ReflectionToolTestTypes.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FReflectionStructMappingRoundTripTest, "ReflectionTool.StructMapping.RoundTrip",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FReflectionStructMappingRoundTripTest::RunTest(const FString& Parameters)
+{
+	// 同类型映射等同于拷贝
+	TSharedPtr<const FReflectionStructMapping> SameMapping = FReflectionStructMapping::Get(FRTTestRecord::StaticStruct(), FRTTestRecord::StaticStruct());
+	if (!TestTrue(TEXT("Same type mapping built"), SameMapping.IsValid()))
+		return false;
+	const FRTTestRecord Source = ReflectionToolTests::MakeRecord(2);
+	FRTTestRecord SameCopy;
+	SameMapping->Copy(&Source, &SameCopy);
+	TestTrue(TEXT("Same type copy"), ReflectionToolTests::AreEqual(Source, SameCopy));
+
+	// V1 -> V2：数值加宽、枚举按名称、FName 与 FString 互转、静态数组取较短长度，新增字段保持默认值
+	TSharedPtr<const FReflectionStructMapping> Upgrade = FReflectionStructMapping::Get(FRTTestRecord::StaticStruct(), FRTTestRecordV2::StaticStruct());
+	TSharedPtr<const FReflectionStructMapping> Downgrade = FReflectionStructMapping::Get(FRTTestRecordV2::StaticStruct(), FRTTestRecord::StaticStruct());
+	if (!TestTrue(TEXT("Cross version mappings built"), Upgrade.IsValid() && Downgrade.IsValid()))
+		return false;
+	TestEqual(TEXT("Mapped field count"), Upgrade->GetNumMappedFields(), 9);
+
+	FRTTestRecordV2 Upgraded;
+	Upgrade->Copy(&Source, &Upgraded);
+	TestEqual(TEXT("Health widened"), Upgraded.Health, static_cast<int64>(Source.Health));
+	TestEqual(TEXT("Speed widened"), Upgraded.Speed, static_cast<double>(Source.Speed));
+	// MakeRecord(2) 的 Color 为 Blue，两个枚举中 Blue 的数值不同
+	TestEqual(TEXT("Enum by name"), Upgraded.Color, ERTTestColorV2::Blue);
+	TestEqual(TEXT("Name to string"), Upgraded.Tag, Source.Tag.ToString());
+	TestEqual(TEXT("String to name"), Upgraded.Title, FName(*Source.Title));
+	TestEqual(TEXT("Static array prefix"), Upgraded.Slots[1], Source.Slots[1]);
+	TestTrue(TEXT("Nested struct"), ReflectionToolTests::AreEqual(Upgraded.Inner, Source.Inner));
+	TestEqual(TEXT("Struct array"), Upgraded.Items.Num(), Source.Items.Num());
+	TestTrue(TEXT("Map"), Upgraded.Attributes.OrderIndependentCompareEqual(Source.Attributes));
+	TestEqual(TEXT("New field keeps default"), Upgraded.Level, 99);
+
+	// V2 -> V1：映射到的字段与原值相同，V2 中没有的字段保持 Dst 的原值
+	FRTTestRecord RoundTrip = Source;
+	RoundTrip.Health = 0;
+	RoundTrip.Speed = 0.f;
+	RoundTrip.Color = ERTTestColor::Red;
+	RoundTrip.Tag = NAME_None;
+	RoundTrip.Title.Reset();
+	RoundTrip.Items.Reset();
+	RoundTrip.Attributes.Reset();
+	RoundTrip.Slots[0] = RoundTrip.Slots[1] = 0;
+	Downgrade->Copy(&Upgraded, &RoundTrip);
+	TestTrue(TEXT("Round trip through V2"), ReflectionToolTests::AreEqual(Source, RoundTrip));
+	return true;
+}
+
+#endif
@@ -0,0 +1,320 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#include "ReflectionToolBenchmarkTypes.h"
+#include "ReflectionToolLib.h"
+#include "Dom/JsonObject.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/DateTime.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "UObject/UObjectIterator.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * ReflectionTool 转换性能测试，可在命令行无界面运行：
+ * UnrealEditor-Cmd <Project> -ExecCmds="Automation RunTests ReflectionTool.Benchmark;Quit" -RTBenchIterations=200 -RTBenchFilter=WideFlat -RTBenchOutput=<Dir> -nullrhi -unattended
+ * 结果（每属性耗时、结果占用、进程物理内存变化）写入 Output 目录下的 CSV 与 JSON，便于对比不同插件版本
+ */
+namespace ReflectionToolBenchmark
+{
+	// 一段代码前后进程物理内存的变化，不替换分配器，只反映分配器向系统申请的内存
+	struct FScopedMemoryDelta
+	{
+		FScopedMemoryDelta()
+			: Before(FPlatformMemory::GetStats())
+		{
+		}
+
+		int64 GetUsedPhysicalDelta() const
+		{
+			return static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical) - static_cast<int64>(Before.UsedPhysical);
+		}
+
+		const FPlatformMemoryStats Before;
+	};
+
+	struct FResult
+	{
+		FString Shape;
+		FString Operation;
+		int32 Iterations = 0;
+		int32 PropertyCount = 0;
+		double NsPerCall = 0.0;
+		double NsPerProperty = 0.0;
+		// 单次调用产生的 PPS 占用（GetPPSMemoryFootprint），不产生 PPS 的操作为 0
+		int64 ResultBytes = 0;
+		int64 UsedPhysicalDelta = 0;
+	};
+
+	int32 CountPPSNodes(const FPropertyParserStruct& PPS)
+	{
+		int32 Count = 1;
+		for (const FPropertyParserStruct& Child : PPS.Children)
+		{
+			Count += CountPPSNodes(Child);
+		}
+		return Count;
+	}
+
+	class FRunner
+	{
+	public:
+		FRunner(int32 InIterations, const FString& InFilter)
+			: Iterations(FMath::Max(1, InIterations))
+			, Filter(InFilter)
+		{
+		}
+
+		bool ShouldRun(const TCHAR* Shape) const
+		{
+			return Filter.IsEmpty() || FCString::Stristr(Shape, *Filter) != nullptr;
+		}
+
+		template<typename FuncType>
+		void Run(const TCHAR* Shape, const TCHAR* Operation, int32 PropertyCount, int64 ResultBytes, FuncType&& Body)
+		{
+			// 预热
+			for (int32 i = 0; i < FMath::Min(Iterations, 5); ++i)
+			{
+				Body();
+			}
+
+			const FScopedMemoryDelta MemoryDelta;
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			for (int32 i = 0; i < Iterations; ++i)
+			{
+				Body();
+			}
+			const double Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+
+			FResult& Result = Results.AddDefaulted_GetRef();
+			Result.Shape = Shape;
+			Result.Operation = Operation;
+			Result.Iterations = Iterations;
+			Result.PropertyCount = PropertyCount;
+			Result.NsPerCall = Seconds * 1e9 / Iterations;
+			Result.NsPerProperty = Result.NsPerCall / FMath::Max(1, PropertyCount);
+			Result.ResultBytes = ResultBytes;
+			Result.UsedPhysicalDelta = MemoryDelta.GetUsedPhysicalDelta();
+
+			UE_LOG(ReflectionTool, Display, TEXT("%-18s %-14s props=%-7d %12.1f ns/call %8.2f ns/prop result=%lld B physical delta=%lld B"),
+				Shape, Operation, PropertyCount, Result.NsPerCall, Result.NsPerProperty, Result.ResultBytes, Result.UsedPhysicalDelta);
+		}
+
+		// struct->PPS、PPS->struct、Map 平铺与应用
+		template<typename StructType>
+		void RunStructSuite(const TCHAR* Shape, const StructType& Source)
+		{
+			if (!ShouldRun(Shape))
+				return;
+
+			FPropertyParserStruct SourcePPS;
+			UReflectionToolLib::UStructToPropertyStruct(Source, SourcePPS);
+			const int32 PropertyCount = CountPPSNodes(SourcePPS) - 1;
+			const int64 PPSBytes = UReflectionToolLib::GetPPSMemoryFootprint(SourcePPS);
+
+			TMap<FString, FString> SourceMap;
+			UReflectionToolLib::UStructToMap(Source, SourceMap);
+
+			Run(Shape, TEXT("StructToPPS"), PropertyCount, PPSBytes, [&Source]()
+			{
+				FPropertyParserStruct PPS;
+				UReflectionToolLib::UStructToPropertyStruct(Source, PPS);
+			});
+			Run(Shape, TEXT("PPSToStruct"), PropertyCount, 0, [&SourcePPS]()
+			{
+				StructType Target;
+				UReflectionToolLib::ParsePPSToStruct(SourcePPS, Target);
+			});
+			Run(Shape, TEXT("StructToMap"), SourceMap.Num(), 0, [&Source]()
+			{
+				TMap<FString, FString> Map;
+				UReflectionToolLib::UStructToMap(Source, Map);
+			});
+			Run(Shape, TEXT("MapToStruct"), SourceMap.Num(), 0, [&SourceMap]()
+			{
+				StructType Target;
+				UReflectionToolLib::SetStructByMap(Target, SourceMap);
+			});
+		}
+
+		void RunInvokeSuite()
+		{
+			const TCHAR* Shape = TEXT("Invoke");
+			if (!ShouldRun(Shape))
+				return;
+
+			URTBenchInvokeTarget* Target = NewObject<URTBenchInvokeTarget>();
+			Target->AddToRoot();
+
+			const TMap<FString, FString> AddParams = { { TEXT("A"), TEXT("12") }, { TEXT("B"), TEXT("30") } };
+			Run(Shape, TEXT("Map_Add"), 2, 0, [Target, &AddParams]()
+			{
+				TMap<FString, FString> OutParams = { { TEXT("ReturnValue"), FString() } };
+				UReflectionToolLib::InvokeFunctionByName_Map(Target, TEXT("BenchAdd"), AddParams, OutParams);
+			});
+
+			const TMap<FString, FString> ConcatParams = { { TEXT("A"), TEXT("Reflection") }, { TEXT("B"), TEXT("Tool") } };
+			Run(Shape, TEXT("Map_Concat"), 2, 0, [Target, &ConcatParams]()
+			{
+				TMap<FString, FString> OutParams = { { TEXT("ReturnValue"), FString() } };
+				UReflectionToolLib::InvokeFunctionByName_Map(Target, TEXT("BenchConcat"), ConcatParams, OutParams);
+			});
+
+			const TArray<FString> SetParams = { TEXT("7"), TEXT("1.5"), TEXT("true") };
+			Run(Shape, TEXT("Array_Set"), 3, 0, [Target, &SetParams]()
+			{
+				UReflectionToolLib::InvokeFunctionByName_Array(Target, TEXT("BenchSetValues"), SetParams);
+			});
+
+			Target->RemoveFromRoot();
+		}
+
+		bool WriteResults(const FString& OutputDir) const
+		{
+			const FString Timestamp = FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S"));
+			FString PluginVersion = TEXT("Unknown");
+			if (TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("ReflectionTool")))
+			{
+				PluginVersion = Plugin->GetDescriptor().VersionName;
+			}
+
+			FString Csv = TEXT("PluginVersion,Shape,Operation,Iterations,PropertyCount,NsPerCall,NsPerProperty,ResultBytes,UsedPhysicalDelta\n");
+			TArray<TSharedPtr<FJsonValue>> JsonResults;
+			for (const FResult& Result : Results)
+			{
+				Csv += FString::Printf(TEXT("%s,%s,%s,%d,%d,%.1f,%.3f,%lld,%lld\n"), *PluginVersion, *Result.Shape,
+					*Result.Operation, Result.Iterations, Result.PropertyCount, Result.NsPerCall, Result.NsPerProperty,
+					Result.ResultBytes, Result.UsedPhysicalDelta);
+
+				TSharedRef<FJsonObject> JsonResult = MakeShared<FJsonObject>();
+				JsonResult->SetStringField(TEXT("Shape"), Result.Shape);
+				JsonResult->SetStringField(TEXT("Operation"), Result.Operation);
+				JsonResult->SetNumberField(TEXT("Iterations"), Result.Iterations);
+				JsonResult->SetNumberField(TEXT("PropertyCount"), Result.PropertyCount);
+				JsonResult->SetNumberField(TEXT("NsPerCall"), Result.NsPerCall);
+				JsonResult->SetNumberField(TEXT("NsPerProperty"), Result.NsPerProperty);
+				JsonResult->SetNumberField(TEXT("ResultBytes"), Result.ResultBytes);
+				JsonResult->SetNumberField(TEXT("UsedPhysicalDelta"), Result.UsedPhysicalDelta);
+				JsonResults.Add(MakeShared<FJsonValueObject>(JsonResult));
+			}
+
+			TSharedRef<FJsonObject> JsonRoot = MakeShared<FJsonObject>();
+			JsonRoot->SetStringField(TEXT("PluginVersion"), PluginVersion);
+			JsonRoot->SetStringField(TEXT("EngineVersion"), FEngineVersion::Current().ToString());
+			JsonRoot->SetStringField(TEXT("Timestamp"), Timestamp);
+			JsonRoot->SetNumberField(TEXT("ProcessPeakUsedPhysical"), FPlatformMemory::GetStats().PeakUsedPhysical);
+			JsonRoot->SetArrayField(TEXT("Results"), JsonResults);
+			FString Json;
+			FJsonSerializer::Serialize(JsonRoot, TJsonWriterFactory<>::Create(&Json));
+
+			const FString BaseName = OutputDir / FString::Printf(TEXT("ReflectionToolBenchmark-%s"), *Timestamp);
+			const bool bCsvSaved = FFileHelper::SaveStringToFile(Csv, *(BaseName + TEXT(".csv")));
+			const bool bJsonSaved = FFileHelper::SaveStringToFile(Json, *(BaseName + TEXT(".json")));
+			UE_LOG(ReflectionTool, Display, TEXT("Benchmark results written to %s.[csv|json]"), *BaseName);
+			return bCsvSaved && bJsonSaved;
+		}
+
+		int32 GetNumResults() const { return Results.Num(); }
+
+	private:
+		int32 Iterations;
+		FString Filter;
+		TArray<FResult> Results;
+	};
+
+	void FillLeaf(FRTBenchLeaf& Leaf, int32 Seed)
+	{
+		Leaf.Count = Seed;
+		Leaf.Weight = Seed * 0.5f;
+		Leaf.Label = FString::Printf(TEXT("Leaf_%d"), Seed);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FReflectionToolBenchmarkTest, "ReflectionTool.Benchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FReflectionToolBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace ReflectionToolBenchmark;
+
+	int32 Iterations = 200;
+	FParse::Value(FCommandLine::Get(), TEXT("RTBenchIterations="), Iterations);
+	FString Filter;
+	FParse::Value(FCommandLine::Get(), TEXT("RTBenchFilter="), Filter);
+	FString OutputDir = FPaths::ProjectSavedDir() / TEXT("Profiling") / TEXT("ReflectionTool");
+	FParse::Value(FCommandLine::Get(), TEXT("RTBenchOutput="), OutputDir);
+
+	FRunner Runner(Iterations, Filter);
+
+	{
+		FRTBenchWideFlat Source;
+		Source.Int0 = 1; Source.Float3 = 3.5f; Source.Double5 = 12.25; Source.bFlag7 = true;
+		Runner.RunStructSuite(TEXT("WideFlat"), Source);
+	}
+	{
+		FRTBenchDeepNested Source;
+		FillLeaf(Source.Leaf, 1);
+		FillLeaf(Source.Child.Leaf, 2);
+		FillLeaf(Source.Child.Child.Leaf, 3);
+		FillLeaf(Source.Child.Child.Child.Leaf, 4);
+		Runner.RunStructSuite(TEXT("DeepNested"), Source);
+	}
+	{
+		FRTBenchLargeArrays Source;
+		for (int32 i = 0; i < 4096; ++i)
+		{
+			Source.Ints.Add(i);
+			Source.Floats.Add(i * 0.25f);
+		}
+		for (int32 i = 0; i < 512; ++i)
+		{
+			FillLeaf(Source.Leaves.AddDefaulted_GetRef(), i);
+		}
+		Runner.RunStructSuite(TEXT("LargeArrays"), Source);
+	}
+	{
+		FRTBenchSetsAndMaps Source;
+		for (int32 i = 0; i < 1024; ++i)
+		{
+			Source.IntSet.Add(i);
+			Source.StringSet.Add(FString::Printf(TEXT("Item_%d"), i));
+			Source.StringToInt.Add(FString::Printf(TEXT("Key_%d"), i), i);
+			FillLeaf(Source.IntToLeaf.Add(i), i);
+		}
+		Runner.RunStructSuite(TEXT("SetsAndMaps"), Source);
+	}
+	{
+		FRTBenchEnumsAndStrings Source;
+		Source.Type = ERTBenchEnum::Weapon;
+		Source.Description = FString::ChrN(256, TEXT('x'));
+		Source.Tag = TEXT("Bench.Tag");
+		Source.DisplayName = FText::FromString(TEXT("Display Name"));
+		for (int32 i = 0; i < 256; ++i)
+		{
+			Source.Types.Add(static_cast<ERTBenchEnum>(i % 5));
+			Source.Lines.Add(FString::Printf(TEXT("Line number %d"), i));
+		}
+		Runner.RunStructSuite(TEXT("EnumsAndStrings"), Source);
+	}
+	{
+		FRTBenchObjectRefs Source;
+		Source.Single = UObject::StaticClass();
+		Source.Soft = UObject::StaticClass();
+		for (TObjectIterator<UClass> It; It && Source.Many.Num() < 512; ++It)
+		{
+			Source.Many.Add(*It);
+		}
+		Runner.RunStructSuite(TEXT("ObjectRefs"), Source);
+	}
+	Runner.RunInvokeSuite();
+
+	TestTrue(TEXT("At least one benchmark ran"), Runner.GetNumResults() > 0);
+	return TestTrue(TEXT("Benchmark results written"), Runner.WriteResults(OutputDir));
+}
+
+#endif
@@ -0,0 +1,352 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "ReflectionToolBenchmarkTypes.generated.h"
+
+/**
+ * ReflectionTool 性能测试用的合成结构体，覆盖宽平铺、深嵌套、大数组、TSet、TMap、枚举、字符串、对象引用，见 ReflectionToolBenchmarkTest.cpp
+ */
+
+UENUM()
+enum class ERTBenchEnum : uint8
+{
+	None,
+	Weapon,
+	Armor,
+	Consumable,
+	Quest,
+};
+
+// 宽平铺：48 个数值 / bool 成员
+USTRUCT()
+struct FRTBenchWideFlat
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Int0 = 0;
+
+	UPROPERTY()
+	float Float0 = 0;
+
+	UPROPERTY()
+	double Double0 = 0;
+
+	UPROPERTY()
+	int64 Int640 = 0;
+
+	UPROPERTY()
+	uint8 Byte0 = 0;
+
+	UPROPERTY()
+	bool bFlag0 = false;
+
+	UPROPERTY()
+	int32 Int1 = 0;
+
+	UPROPERTY()
+	float Float1 = 0;
+
+	UPROPERTY()
+	double Double1 = 0;
+
+	UPROPERTY()
+	int64 Int641 = 0;
+
+	UPROPERTY()
+	uint8 Byte1 = 0;
+
+	UPROPERTY()
+	bool bFlag1 = false;
+
+	UPROPERTY()
+	int32 Int2 = 0;
+
+	UPROPERTY()
+	float Float2 = 0;
+
+	UPROPERTY()
+	double Double2 = 0;
+
+	UPROPERTY()
+	int64 Int642 = 0;
+
+	UPROPERTY()
+	uint8 Byte2 = 0;
+
+	UPROPERTY()
+	bool bFlag2 = false;
+
+	UPROPERTY()
+	int32 Int3 = 0;
+
+	UPROPERTY()
+	float Float3 = 0;
+
+	UPROPERTY()
+	double Double3 = 0;
+
+	UPROPERTY()
+	int64 Int643 = 0;
+
+	UPROPERTY()
+	uint8 Byte3 = 0;
+
+	UPROPERTY()
+	bool bFlag3 = false;
+
+	UPROPERTY()
+	int32 Int4 = 0;
+
+	UPROPERTY()
+	float Float4 = 0;
+
+	UPROPERTY()
+	double Double4 = 0;
+
+	UPROPERTY()
+	int64 Int644 = 0;
+
+	UPROPERTY()
+	uint8 Byte4 = 0;
+
+	UPROPERTY()
+	bool bFlag4 = false;
+
+	UPROPERTY()
+	int32 Int5 = 0;
+
+	UPROPERTY()
+	float Float5 = 0;
+
+	UPROPERTY()
+	double Double5 = 0;
+
+	UPROPERTY()
+	int64 Int645 = 0;
+
+	UPROPERTY()
+	uint8 Byte5 = 0;
+
+	UPROPERTY()
+	bool bFlag5 = false;
+
+	UPROPERTY()
+	int32 Int6 = 0;
+
+	UPROPERTY()
+	float Float6 = 0;
+
+	UPROPERTY()
+	double Double6 = 0;
+
+	UPROPERTY()
+	int64 Int646 = 0;
+
+	UPROPERTY()
+	uint8 Byte6 = 0;
+
+	UPROPERTY()
+	bool bFlag6 = false;
+
+	UPROPERTY()
+	int32 Int7 = 0;
+
+	UPROPERTY()
+	float Float7 = 0;
+
+	UPROPERTY()
+	double Double7 = 0;
+
+	UPROPERTY()
+	int64 Int647 = 0;
+
+	UPROPERTY()
+	uint8 Byte7 = 0;
+
+	UPROPERTY()
+	bool bFlag7 = false;
+};
+
+// 嵌套叶子
+USTRUCT()
+struct FRTBenchLeaf
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Count = 0;
+
+	UPROPERTY()
+	float Weight = 0.f;
+
+	UPROPERTY()
+	FString Label;
+};
+
+USTRUCT()
+struct FRTBenchNested4
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FRTBenchLeaf Leaf;
+
+	UPROPERTY()
+	int32 Depth = 4;
+};
+
+USTRUCT()
+struct FRTBenchNested3
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FRTBenchNested4 Child;
+
+	UPROPERTY()
+	FRTBenchLeaf Leaf;
+
+	UPROPERTY()
+	int32 Depth = 3;
+};
+
+USTRUCT()
+struct FRTBenchNested2
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FRTBenchNested3 Child;
+
+	UPROPERTY()
+	FRTBenchLeaf Leaf;
+
+	UPROPERTY()
+	int32 Depth = 2;
+};
+
+// 深嵌套：5 层结构体
+USTRUCT()
+struct FRTBenchDeepNested
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FRTBenchNested2 Child;
+
+	UPROPERTY()
+	FRTBenchLeaf Leaf;
+
+	UPROPERTY()
+	int32 Depth = 1;
+};
+
+// 大数组
+USTRUCT()
+struct FRTBenchLargeArrays
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<int32> Ints;
+
+	UPROPERTY()
+	TArray<float> Floats;
+
+	UPROPERTY()
+	TArray<FRTBenchLeaf> Leaves;
+};
+
+// TSet / TMap
+USTRUCT()
+struct FRTBenchSetsAndMaps
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TSet<int32> IntSet;
+
+	UPROPERTY()
+	TSet<FString> StringSet;
+
+	UPROPERTY()
+	TMap<FString, int32> StringToInt;
+
+	UPROPERTY()
+	TMap<int32, FRTBenchLeaf> IntToLeaf;
+};
+
+// 枚举与字符串
+USTRUCT()
+struct FRTBenchEnumsAndStrings
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	ERTBenchEnum Type = ERTBenchEnum::None;
+
+	UPROPERTY()
+	TArray<ERTBenchEnum> Types;
+
+	UPROPERTY()
+	FString Description;
+
+	UPROPERTY()
+	FName Tag;
+
+	UPROPERTY()
+	FText DisplayName;
+
+	UPROPERTY()
+	TArray<FString> Lines;
+};
+
+// 对象引用
+USTRUCT()
+struct FRTBenchObjectRefs
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<UObject> Single = nullptr;
+
+	UPROPERTY()
+	TArray<TObjectPtr<UObject>> Many;
+
+	UPROPERTY()
+	TSoftObjectPtr<UObject> Soft;
+};
+
+// InvokeFunctionByName_* 的调用目标
+UCLASS()
+class URTBenchInvokeTarget : public UObject
+{
+	GENERATED_BODY()
+public:
+	UFUNCTION()
+	int32 BenchAdd(int32 A, int32 B) { return A + B; }
+
+	UFUNCTION()
+	FString BenchConcat(const FString& A, const FString& B) { return A + B; }
+
+	UFUNCTION()
+	void BenchSetValues(int32 InCount, float InScale, bool bInEnabled)
+	{
+		Count = InCount;
+		Scale = InScale;
+		bEnabled = bInEnabled;
+	}
+
+	UPROPERTY()
+	int32 Count = 0;
+
+	UPROPERTY()
+	float Scale = 0.f;
+
+	UPROPERTY()
+	bool bEnabled = false;
+};
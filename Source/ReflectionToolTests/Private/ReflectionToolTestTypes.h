@@ -0,0 +1,167 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReflectionToolTestTypes.generated.h"
+
+/**
+ * 自动化测试用的结构体：FRTTestRecord 覆盖数值、枚举、字符串、静态数组、嵌套结构体与各类容器，
+ * FRTTestRecordV2 模拟字段改名 / 改类型 / 删除 / 新增后的版本，用于映射与存档的跨版本测试
+ */
+UENUM()
+enum class ERTTestColor : uint8
+{
+	Red,
+	Green,
+	Blue,
+};
+
+// 与 ERTTestColor 同名但数值不同，按名称转换
+UENUM()
+enum class ERTTestColorV2 : uint8
+{
+	Blue,
+	Red,
+	Green,
+	Yellow,
+};
+
+USTRUCT()
+struct FRTTestInner
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Id = 0;
+
+	UPROPERTY()
+	FString Label;
+
+	UPROPERTY()
+	float Weight = 0.f;
+};
+
+USTRUCT()
+struct FRTTestRecord
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Health = 0;
+
+	UPROPERTY()
+	float Speed = 0.f;
+
+	UPROPERTY()
+	bool bAlive = false;
+
+	UPROPERTY()
+	ERTTestColor Color = ERTTestColor::Red;
+
+	UPROPERTY()
+	FName Tag;
+
+	UPROPERTY()
+	FString Title;
+
+	UPROPERTY()
+	int32 Slots[3] = { 0, 0, 0 };
+
+	UPROPERTY()
+	FRTTestInner Inner;
+
+	UPROPERTY()
+	TArray<FRTTestInner> Items;
+
+	UPROPERTY()
+	TArray<int32> Scores;
+
+	UPROPERTY()
+	TSet<FString> Flags;
+
+	UPROPERTY()
+	TMap<FString, int32> Attributes;
+
+	UPROPERTY()
+	TMap<FName, FRTTestInner> Named;
+};
+
+// FRTTestRecord 的新版本：Health / Speed 改为更宽的类型，Tag / Title 互换 FName 与 FString，Slots 变短，删除 bAlive / Scores / Flags / Named，新增 Level
+USTRUCT()
+struct FRTTestRecordV2
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int64 Health = 0;
+
+	UPROPERTY()
+	double Speed = 0.0;
+
+	UPROPERTY()
+	ERTTestColorV2 Color = ERTTestColorV2::Yellow;
+
+	UPROPERTY()
+	FString Tag;
+
+	UPROPERTY()
+	FName Title;
+
+	UPROPERTY()
+	int32 Slots[2] = { 0, 0 };
+
+	UPROPERTY()
+	FRTTestInner Inner;
+
+	UPROPERTY()
+	TArray<FRTTestInner> Items;
+
+	UPROPERTY()
+	TMap<FString, int32> Attributes;
+
+	UPROPERTY()
+	int32 Level = 99;
+};
+
+namespace ReflectionToolTests
+{
+	// 每个字段都不是默认值的样本，Seed 不同则内容不同
+	inline FRTTestRecord MakeRecord(int32 Seed)
+	{
+		FRTTestRecord Record;
+		Record.Health = 100 + Seed;
+		Record.Speed = 1.5f * (Seed + 1);
+		Record.bAlive = Seed % 2 == 0;
+		Record.Color = static_cast<ERTTestColor>(Seed % 3);
+		Record.Tag = FName(*FString::Printf(TEXT("Tag_%d"), Seed));
+		Record.Title = FString::Printf(TEXT("Title %d"), Seed);
+		Record.Slots[0] = Seed;
+		Record.Slots[1] = Seed * 2;
+		Record.Slots[2] = Seed * 3;
+		Record.Inner.Id = Seed;
+		Record.Inner.Label = TEXT("Inner");
+		Record.Inner.Weight = 0.25f * Seed;
+		for (int32 i = 0; i < 3; ++i)
+		{
+			FRTTestInner& Item = Record.Items.AddDefaulted_GetRef();
+			Item.Id = Seed * 10 + i;
+			Item.Label = FString::Printf(TEXT("Item_%d"), i);
+			Item.Weight = i * 0.5f;
+			Record.Scores.Add(Seed + i);
+		}
+		Record.Flags.Add(TEXT("Alpha"));
+		Record.Flags.Add(FString::Printf(TEXT("Flag_%d"), Seed));
+		Record.Attributes.Add(TEXT("Speed"), Seed);
+		Record.Attributes.Add(TEXT("Armor"), Seed + 5);
+		Record.Named.Add(TEXT("Boss"), Record.Inner);
+		return Record;
+	}
+
+	// 与被测代码无关的比较方式，按 UScriptStruct 默认规则逐属性比较
+	template<typename StructType>
+	bool AreEqual(const StructType& A, const StructType& B)
+	{
+		return StructType::StaticStruct()->CompareScriptStruct(&A, &B, PPF_None);
+	}
+}
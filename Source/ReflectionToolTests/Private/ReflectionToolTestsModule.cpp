@@ -0,0 +1,5 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, ReflectionToolTests)
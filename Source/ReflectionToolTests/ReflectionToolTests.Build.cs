@@ -0,0 +1,24 @@
+// Copyright 2024 QinXiao, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+// ReflectionTool 的自动化测试与性能测试，只在开发工具中编译，不随游戏发布
+public class ReflectionToolTests : ModuleRules
+{
+	public ReflectionToolTests(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"Json",
+				"Projects",
+				"ReflectionTool"
+			}
+			);
+	}
+}